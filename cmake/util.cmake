@@ -365,6 +365,85 @@ function(clion)
     endif ()
 endfunction()
 
+function(spirv_embed)
+    set(options)
+    set(oneValueKeywords
+        "OUTPUT_FILE"
+        "NAMESPACE"
+        "REGISTRY_NAME"
+    )
+    set(multiValueKeywords
+        "INPUT_FILES"
+    )
+
+    foreach(v IN LISTS "options" "oneValueKeywords" "multiValueKeywords")
+        unset("_${v}")
+    endforeach()
+
+    cmake_parse_arguments("" "${options}" "${oneValueKeywords}" "${multiValueKeywords}" "${ARGN}")
+
+    if(NOT "${_UNPARSED_ARGUMENTS}" STREQUAL "")
+        message(FATAL_ERROR "UNPARSED_ARGUMENTS: '${_UNPARSED_ARGUMENTS}'")
+    endif()
+
+    if("${_OUTPUT_FILE}" STREQUAL "")
+        message(FATAL_ERROR "empty OUTPUT_FILE: '${_OUTPUT_FILE}'")
+    endif()
+
+    if("${_NAMESPACE}" STREQUAL "")
+        message(FATAL_ERROR "empty NAMESPACE: '${_NAMESPACE}'")
+    endif()
+
+    if("${_REGISTRY_NAME}" STREQUAL "")
+        set(_REGISTRY_NAME "REGISTRY")
+    endif()
+
+    if("${_INPUT_FILES}" STREQUAL "")
+        message(FATAL_ERROR "empty INPUT_FILES: '${_INPUT_FILES}'")
+    endif()
+
+    set(arrays "")
+    set(entries "")
+
+    foreach(inputFile IN LISTS "_INPUT_FILES")
+        if(NOT EXISTS "${inputFile}")
+            message(FATAL_ERROR "not exists INPUT_FILE: '${inputFile}'")
+        endif()
+
+        cmake_path(GET "inputFile" STEM "name")
+        string(MAKE_C_IDENTIFIER "${name}" "identifier")
+
+        file(READ "${inputFile}" "hex" HEX)
+        string(LENGTH "${hex}" "hexLength")
+        math(EXPR "hexRemainder" "${hexLength} % 8")
+
+        if("${hexLength}" EQUAL "0" OR NOT "${hexRemainder}" EQUAL "0")
+            message(FATAL_ERROR "not word aligned INPUT_FILE: '${inputFile}'")
+        endif()
+
+        string(SUBSTRING "${hex}" "0" "8" "magic")
+        if(NOT "${magic}" STREQUAL "03022307")
+            message(FATAL_ERROR "not spir-v INPUT_FILE: '${inputFile}'")
+        endif()
+
+        # bytes are little endian words, 8 words per line
+        string(REGEX REPLACE "(..)(..)(..)(..)" "0x\\4\\3\\2\\1, " "words" "${hex}")
+        string(REPEAT "0x[0-9a-f]+, " "8" "linePattern")
+        string(REGEX REPLACE "(${linePattern})" "\\1\n        " "words" "${words}")
+        string(REPLACE ", \n" ",\n" "words" "${words}")
+        string(REGEX REPLACE "[ \n]+$" "" "words" "${words}")
+
+        string(APPEND arrays "    alignas(4) inline constexpr uint32_t ${identifier}[] = {\n        ${words}\n    };\n\n")
+        string(APPEND entries "        exqudens::vulkan::Spirv {\"${name}\", ${identifier}},\n")
+    endforeach()
+
+    set(content "#pragma once\n\n#include <cstdint>\n\n#include \"exqudens/vulkan/Spirv.hpp\"\n\nnamespace ${_NAMESPACE} {\n\n")
+    string(APPEND content "${arrays}")
+    string(APPEND content "    inline constexpr exqudens::vulkan::Spirv ${_REGISTRY_NAME}[] = {\n${entries}    };\n\n}\n")
+
+    file(WRITE "${_OUTPUT_FILE}" "${content}")
+endfunction()
+
 block()
     if(NOT "${CMAKE_SCRIPT_MODE_FILE}" STREQUAL "" AND "${CMAKE_SCRIPT_MODE_FILE}" STREQUAL "${CMAKE_CURRENT_LIST_FILE}")
         set(args)
@@ -8,18 +8,38 @@
 #include "exqudens/vulkan/Queue.hpp"
 #include "exqudens/vulkan/Swapchain.hpp"
 #include "exqudens/vulkan/ImageView.hpp"
+#include "exqudens/vulkan/Spirv.hpp"
 #include "exqudens/vulkan/ShaderModule.hpp"
+#include "exqudens/vulkan/ShaderObject.hpp"
 #include "exqudens/vulkan/RenderPass.hpp"
 #include "exqudens/vulkan/DescriptorSetLayout.hpp"
 #include "exqudens/vulkan/DescriptorPool.hpp"
 #include "exqudens/vulkan/DescriptorSets.hpp"
+#include "exqudens/vulkan/DescriptorAllocator.hpp"
+#include "exqudens/vulkan/DescriptorHeap.hpp"
+#include "exqudens/vulkan/DescriptorBuffer.hpp"
+#include "exqudens/vulkan/DescriptorUpdateTemplate.hpp"
+#include "exqudens/vulkan/DescriptorSetCache.hpp"
 #include "exqudens/vulkan/PipelineLayout.hpp"
 #include "exqudens/vulkan/PipelineCache.hpp"
 #include "exqudens/vulkan/Pipeline.hpp"
+#include "exqudens/vulkan/PipelineCompiler.hpp"
+#include "exqudens/vulkan/PipelineStateKey.hpp"
+#include "exqudens/vulkan/PipelineStateCache.hpp"
+#include "exqudens/vulkan/LayoutCache.hpp"
+#include "exqudens/vulkan/PipelineLibrary.hpp"
+#include "exqudens/vulkan/SpirvReflection.hpp"
+#include "exqudens/vulkan/PipelineRecorder.hpp"
+#include "exqudens/vulkan/ExtendedDynamicState.hpp"
 #include "exqudens/vulkan/Framebuffer.hpp"
 #include "exqudens/vulkan/Buffer.hpp"
+#include "exqudens/vulkan/Image.hpp"
 #include "exqudens/vulkan/DeviceMemory.hpp"
+#include "exqudens/vulkan/MemoryArena.hpp"
+#include "exqudens/vulkan/RingBuffer.hpp"
+#include "exqudens/vulkan/UploadManager.hpp"
 #include "exqudens/vulkan/CommandPool.hpp"
 #include "exqudens/vulkan/CommandBuffers.hpp"
 #include "exqudens/vulkan/Semaphore.hpp"
 #include "exqudens/vulkan/Fence.hpp"
+#include "exqudens/vulkan/DeferredRelease.hpp"
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <cstdint>
 #include <optional>
+#include <vector>
 
 #include <vulkan/vulkan_raii.hpp>
 
 #include "exqudens/vulkan/export.hpp"
+#include "exqudens/vulkan/Pipeline.hpp"
 
 namespace exqudens::vulkan {
 
@@ -17,6 +20,34 @@ namespace exqudens::vulkan {
 
         static Builder builder(CommandBuffers& object);
 
+        static uint32_t groupCountFrom(uint32_t count, uint32_t groupSize);
+
+        static void dispatch(
+            VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer,
+            const Pipeline& pipeline,
+            const std::vector<VULKAN_HPP_NAMESPACE::DescriptorSet>& descriptorSets,
+            const std::vector<uint32_t>& dynamicOffsets,
+            uint32_t groupCountX,
+            uint32_t groupCountY = 1,
+            uint32_t groupCountZ = 1
+        );
+
+        static void dispatchIndirect(
+            VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer,
+            const Pipeline& pipeline,
+            const std::vector<VULKAN_HPP_NAMESPACE::DescriptorSet>& descriptorSets,
+            const std::vector<uint32_t>& dynamicOffsets,
+            const VULKAN_HPP_NAMESPACE::Buffer& buffer,
+            const VULKAN_HPP_NAMESPACE::DeviceSize& offset = 0
+        );
+
+        static void bindCompute(
+            VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer,
+            const Pipeline& pipeline,
+            const std::vector<VULKAN_HPP_NAMESPACE::DescriptorSet>& descriptorSets,
+            const std::vector<uint32_t>& dynamicOffsets
+        );
+
         void clear();
 
         void clearAndRelease();
@@ -57,6 +88,78 @@ namespace exqudens::vulkan {
         return Builder(object);
     }
 
+    EXQUDENS_VULKAN_INLINE uint32_t CommandBuffers::groupCountFrom(uint32_t count, uint32_t groupSize) {
+        try {
+            if (groupSize == 0) {
+                throw std::runtime_error(CALL_INFO + ": 'groupSize' is zero");
+            }
+
+            return (count + groupSize - 1) / groupSize;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void CommandBuffers::dispatch(
+        VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer,
+        const Pipeline& pipeline,
+        const std::vector<VULKAN_HPP_NAMESPACE::DescriptorSet>& descriptorSets,
+        const std::vector<uint32_t>& dynamicOffsets,
+        uint32_t groupCountX,
+        uint32_t groupCountY,
+        uint32_t groupCountZ
+    ) {
+        try {
+            bindCompute(commandBuffer, pipeline, descriptorSets, dynamicOffsets);
+            commandBuffer.dispatch(groupCountX, groupCountY, groupCountZ);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void CommandBuffers::dispatchIndirect(
+        VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer,
+        const Pipeline& pipeline,
+        const std::vector<VULKAN_HPP_NAMESPACE::DescriptorSet>& descriptorSets,
+        const std::vector<uint32_t>& dynamicOffsets,
+        const VULKAN_HPP_NAMESPACE::Buffer& buffer,
+        const VULKAN_HPP_NAMESPACE::DeviceSize& offset
+    ) {
+        try {
+            bindCompute(commandBuffer, pipeline, descriptorSets, dynamicOffsets);
+            commandBuffer.dispatchIndirect(buffer, offset);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void CommandBuffers::bindCompute(
+        VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer,
+        const Pipeline& pipeline,
+        const std::vector<VULKAN_HPP_NAMESPACE::DescriptorSet>& descriptorSets,
+        const std::vector<uint32_t>& dynamicOffsets
+    ) {
+        try {
+            if (!pipeline.computeCreateInfo.has_value()) {
+                throw std::runtime_error(CALL_INFO + ": 'computeCreateInfo' is not initialized");
+            }
+
+            commandBuffer.bindPipeline(VULKAN_HPP_NAMESPACE::PipelineBindPoint::eCompute, *pipeline.target);
+
+            if (!descriptorSets.empty()) {
+                commandBuffer.bindDescriptorSets(
+                    VULKAN_HPP_NAMESPACE::PipelineBindPoint::eCompute,
+                    pipeline.computeCreateInfo.value().layout,
+                    0,
+                    descriptorSets,
+                    dynamicOffsets
+                );
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
     EXQUDENS_VULKAN_INLINE void CommandBuffers::clear() {
         try {
             allocateInfo.reset();
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "exqudens/vulkan/export.hpp"
+
+namespace exqudens::vulkan {
+
+    struct EXQUDENS_VULKAN_EXPORT DeferredRelease {
+
+        class Builder;
+
+        template<typename T, typename = void>
+        struct HasTarget: std::false_type {};
+
+        template<typename T>
+        struct HasTarget<T, std::void_t<decltype(std::declval<T&>().target)>>: std::true_type {};
+
+        template<typename T, typename = void>
+        struct HasTargets: std::false_type {};
+
+        template<typename T>
+        struct HasTargets<T, std::void_t<decltype(std::declval<T&>().targets)>>: std::true_type {};
+
+        struct Entry {
+            uint64_t frame = 0;
+            std::shared_ptr<void> object = nullptr;
+            // releases the held handles without destroying them
+            std::function<void()> release = {};
+        };
+
+        std::optional<uint32_t> frameCount = {};
+        uint64_t frame = 0;
+        std::deque<Entry> entries = {};
+
+        static Builder builder(DeferredRelease& object);
+
+        template<typename T>
+        void push(T& object) {
+            static_assert(HasTarget<T>::value || HasTargets<T>::value, "'object' has neither 'target' nor 'targets'");
+            if constexpr (HasTargets<T>::value) {
+                hold(std::move(object.targets));
+            } else {
+                hold(std::move(object.target));
+            }
+            object.clear();
+        }
+
+        template<typename T>
+        void hold(T&& target) {
+            std::shared_ptr<std::decay_t<T>> value = std::make_shared<std::decay_t<T>>(std::move(target));
+            Entry entry;
+            entry.frame = frame;
+            entry.release = [pointer = value.get()]() { releaseValue(*pointer); };
+            entry.object = std::move(value);
+            entries.emplace_back(std::move(entry));
+        }
+
+        void nextFrame();
+
+        void flush();
+
+        void clear();
+
+        void clearAndRelease();
+
+        // 'targets' vectors release every element
+        template<typename T>
+        static void releaseValue(std::vector<T>& values) {
+            for (T& value : values) {
+                releaseValue(value);
+            }
+        }
+
+        template<typename T>
+        static void releaseValue(T& value) {
+            value.release();
+        }
+
+    };
+
+    class EXQUDENS_VULKAN_EXPORT DeferredRelease::Builder {
+
+        private:
+
+            DeferredRelease& object;
+
+        public:
+
+            explicit Builder(DeferredRelease& object);
+
+            Builder& setFrameCount(uint32_t value);
+
+            DeferredRelease& build();
+
+    };
+
+}
+
+// implementation ---
+
+#include <string>
+#include <filesystem>
+#include <stdexcept>
+
+#define CALL_INFO std::string(__FUNCTION__) + " (" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::vulkan {
+
+    EXQUDENS_VULKAN_INLINE DeferredRelease::Builder DeferredRelease::builder(DeferredRelease& object) {
+        return Builder(object);
+    }
+
+    EXQUDENS_VULKAN_INLINE void DeferredRelease::nextFrame() {
+        try {
+            // called after waiting for the fence of the frame about to be recorded,
+            // a fence also covers every earlier submission to its queue,
+            // so anything pushed 'frameCount' frames ago is no longer referenced by the gpu
+            frame++;
+
+            while (!entries.empty() && entries.front().frame + frameCount.value() <= frame) {
+                entries.pop_front();
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DeferredRelease::flush() {
+        try {
+            // entries are destroyed in the order they were pushed, sets before their pool and so on
+            while (!entries.empty()) {
+                entries.pop_front();
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DeferredRelease::clear() {
+        try {
+            flush();
+            frameCount.reset();
+            frame = 0;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DeferredRelease::clearAndRelease() {
+        try {
+            for (Entry& entry : entries) {
+                entry.release();
+            }
+
+            clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE DeferredRelease::Builder::Builder(DeferredRelease& object): object(object) {
+    }
+
+    EXQUDENS_VULKAN_INLINE DeferredRelease::Builder& DeferredRelease::Builder::setFrameCount(uint32_t value) {
+        object.frameCount = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DeferredRelease& DeferredRelease::Builder::build() {
+        try {
+            if (!object.frameCount.has_value()) {
+                object.frameCount = 2;
+            }
+
+            if (object.frameCount.value() == 0) {
+                throw std::runtime_error(CALL_INFO + ": 'frameCount' is zero");
+            }
+
+            return object;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
@@ -0,0 +1,322 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <memory>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "exqudens/vulkan/export.hpp"
+#include "exqudens/vulkan/DescriptorPool.hpp"
+
+namespace exqudens::vulkan {
+
+    struct EXQUDENS_VULKAN_EXPORT DescriptorAllocator {
+
+        class Builder;
+
+        static constexpr uint32_t DEFAULT_MAX_SETS = 256;
+        static constexpr uint32_t DEFAULT_MAX_SETS_LIMIT = 4096;
+
+        // descriptor counts per set, scaled by 'maxSets' of each opened pool
+        std::vector<VULKAN_HPP_NAMESPACE::DescriptorPoolSize> sizes = {};
+        std::optional<uint32_t> maxSets = {};
+        std::optional<uint32_t> maxSetsLimit = {};
+        VULKAN_HPP_NAMESPACE::DescriptorPoolCreateFlags flags = {};
+        std::vector<std::unique_ptr<DescriptorPool>> usedPools = {};
+        std::vector<std::unique_ptr<DescriptorPool>> readyPools = {};
+        uint32_t nextMaxSets = 0;
+
+        static Builder builder(DescriptorAllocator& object);
+
+        // 'requested' shrunk until no descriptor count scaled by it overflows uint32
+        static uint32_t poolMaxSetsFrom(
+            const std::vector<VULKAN_HPP_NAMESPACE::DescriptorPoolSize>& sizes,
+            uint32_t requested
+        );
+
+        // twice 'poolMaxSets', capped by 'limit'
+        static uint32_t nextMaxSetsFrom(uint32_t poolMaxSets, uint32_t limit);
+
+        std::vector<VULKAN_HPP_NAMESPACE::DescriptorSet> allocate(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            const std::vector<VULKAN_HPP_NAMESPACE::DescriptorSetLayout>& layouts,
+            const void* next = nullptr
+        );
+
+        VULKAN_HPP_NAMESPACE::DescriptorSet allocate(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            const VULKAN_HPP_NAMESPACE::DescriptorSetLayout& layout,
+            const void* next = nullptr
+        );
+
+        void reset();
+
+        size_t size() const;
+
+        void clear();
+
+        void clearAndRelease();
+
+    };
+
+    class EXQUDENS_VULKAN_EXPORT DescriptorAllocator::Builder {
+
+        private:
+
+            DescriptorAllocator& object;
+
+        public:
+
+            explicit Builder(DescriptorAllocator& object);
+
+            Builder& setSizes(const std::vector<VULKAN_HPP_NAMESPACE::DescriptorPoolSize>& value);
+
+            Builder& addSize(const VULKAN_HPP_NAMESPACE::DescriptorPoolSize& value);
+
+            Builder& setMaxSets(uint32_t value);
+
+            Builder& setMaxSetsLimit(uint32_t value);
+
+            Builder& setFlags(const VULKAN_HPP_NAMESPACE::DescriptorPoolCreateFlags& value);
+
+            DescriptorAllocator& build();
+
+    };
+
+}
+
+// implementation ---
+
+#include <algorithm>
+#include <utility>
+#include <string>
+#include <filesystem>
+#include <stdexcept>
+
+#define CALL_INFO std::string(__FUNCTION__) + " (" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::vulkan {
+
+    EXQUDENS_VULKAN_INLINE DescriptorAllocator::Builder DescriptorAllocator::builder(DescriptorAllocator& object) {
+        return Builder(object);
+    }
+
+    EXQUDENS_VULKAN_INLINE uint32_t DescriptorAllocator::poolMaxSetsFrom(
+        const std::vector<VULKAN_HPP_NAMESPACE::DescriptorPoolSize>& sizes,
+        uint32_t requested
+    ) {
+        try {
+            uint32_t result = std::max<uint32_t>(requested, 1);
+
+            for (const VULKAN_HPP_NAMESPACE::DescriptorPoolSize& value : sizes) {
+                if (value.descriptorCount > 0) {
+                    result = std::min<uint32_t>(result, UINT32_MAX / value.descriptorCount);
+                }
+            }
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE uint32_t DescriptorAllocator::nextMaxSetsFrom(uint32_t poolMaxSets, uint32_t limit) {
+        try {
+            return static_cast<uint32_t>(std::min<uint64_t>(static_cast<uint64_t>(poolMaxSets) * 2, limit));
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE std::vector<VULKAN_HPP_NAMESPACE::DescriptorSet> DescriptorAllocator::allocate(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        const std::vector<VULKAN_HPP_NAMESPACE::DescriptorSetLayout>& layouts,
+        const void* next
+    ) {
+        try {
+            if (layouts.empty()) {
+                return {};
+            }
+
+            auto openPool = [this, &device]() {
+                std::unique_ptr<DescriptorPool> pool = nullptr;
+
+                if (!readyPools.empty()) {
+                    pool = std::move(readyPools.back());
+                    readyPools.pop_back();
+                } else {
+                    uint32_t poolMaxSets = poolMaxSetsFrom(sizes, nextMaxSets);
+                    pool = std::make_unique<DescriptorPool>();
+                    DescriptorPool::Builder poolBuilder = DescriptorPool::builder(*pool);
+
+                    for (const VULKAN_HPP_NAMESPACE::DescriptorPoolSize& value : sizes) {
+                        poolBuilder.addSize(VULKAN_HPP_NAMESPACE::DescriptorPoolSize(value.type, value.descriptorCount * poolMaxSets));
+                    }
+
+                    poolBuilder
+                    .setCreateInfo(VULKAN_HPP_NAMESPACE::DescriptorPoolCreateInfo().setFlags(flags).setMaxSets(poolMaxSets))
+                    .build(device);
+
+                    // every new pool is larger, so a steady workload settles on a few pools
+                    nextMaxSets = nextMaxSetsFrom(poolMaxSets, maxSetsLimit.value_or(DEFAULT_MAX_SETS_LIMIT));
+                }
+
+                usedPools.emplace_back(std::move(pool));
+            };
+
+            if (usedPools.empty()) {
+                openPool();
+            }
+
+            VULKAN_HPP_NAMESPACE::DescriptorSetAllocateInfo allocateInfo = VULKAN_HPP_NAMESPACE::DescriptorSetAllocateInfo()
+            .setPNext(next)
+            .setSetLayouts(layouts);
+
+            auto tryAllocate = [&device, &allocateInfo](DescriptorPool& pool, std::vector<VULKAN_HPP_NAMESPACE::DescriptorSet>& result) {
+                allocateInfo.descriptorPool = *pool.target;
+                try {
+                    VULKAN_HPP_NAMESPACE::raii::DescriptorSets sets(device, allocateInfo);
+                    // sets are reclaimed by resetting their pool, never freed one by one
+                    for (VULKAN_HPP_NAMESPACE::raii::DescriptorSet& set : sets) {
+                        result.emplace_back(set.release());
+                    }
+                    return true;
+                } catch (const VULKAN_HPP_NAMESPACE::OutOfPoolMemoryError&) {
+                    return false;
+                } catch (const VULKAN_HPP_NAMESPACE::FragmentedPoolError&) {
+                    return false;
+                }
+            };
+
+            std::vector<VULKAN_HPP_NAMESPACE::DescriptorSet> result = {};
+
+            if (tryAllocate(*usedPools.back(), result)) {
+                return result;
+            }
+
+            openPool();
+
+            if (!tryAllocate(*usedPools.back(), result)) {
+                throw std::runtime_error(CALL_INFO + ": allocation does not fit into an empty pool");
+            }
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE VULKAN_HPP_NAMESPACE::DescriptorSet DescriptorAllocator::allocate(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        const VULKAN_HPP_NAMESPACE::DescriptorSetLayout& layout,
+        const void* next
+    ) {
+        try {
+            return allocate(device, std::vector<VULKAN_HPP_NAMESPACE::DescriptorSetLayout> {layout}, next).front();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorAllocator::reset() {
+        try {
+            // whole-pool reset, the caller guarantees the gpu no longer reads any set from it
+            for (std::unique_ptr<DescriptorPool>& pool : usedPools) {
+                // a pool whose handle was handed off has nothing to reset
+                if (*pool->target) {
+                    pool->target.reset();
+                }
+                readyPools.emplace_back(std::move(pool));
+            }
+            usedPools.clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE size_t DescriptorAllocator::size() const {
+        return usedPools.size() + readyPools.size();
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorAllocator::clear() {
+        try {
+            sizes.clear();
+            maxSets.reset();
+            maxSetsLimit.reset();
+            flags = {};
+            usedPools.clear();
+            readyPools.clear();
+            nextMaxSets = 0;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorAllocator::clearAndRelease() {
+        try {
+            for (std::unique_ptr<DescriptorPool>& pool : usedPools) {
+                pool->clearAndRelease();
+            }
+            for (std::unique_ptr<DescriptorPool>& pool : readyPools) {
+                pool->clearAndRelease();
+            }
+            clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorAllocator::Builder::Builder(DescriptorAllocator& object): object(object) {
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorAllocator::Builder& DescriptorAllocator::Builder::setSizes(const std::vector<VULKAN_HPP_NAMESPACE::DescriptorPoolSize>& value) {
+        object.sizes = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorAllocator::Builder& DescriptorAllocator::Builder::addSize(const VULKAN_HPP_NAMESPACE::DescriptorPoolSize& value) {
+        object.sizes.emplace_back(value);
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorAllocator::Builder& DescriptorAllocator::Builder::setMaxSets(uint32_t value) {
+        object.maxSets = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorAllocator::Builder& DescriptorAllocator::Builder::setMaxSetsLimit(uint32_t value) {
+        object.maxSetsLimit = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorAllocator::Builder& DescriptorAllocator::Builder::setFlags(const VULKAN_HPP_NAMESPACE::DescriptorPoolCreateFlags& value) {
+        object.flags = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorAllocator& DescriptorAllocator::Builder::build() {
+        try {
+            if (object.sizes.empty()) {
+                throw std::runtime_error(CALL_INFO + ": 'sizes' is empty");
+            }
+
+            if (!object.maxSets.has_value()) {
+                object.maxSets = DEFAULT_MAX_SETS;
+            }
+
+            // pools are opened lazily on the first allocation
+            object.usedPools.clear();
+            object.readyPools.clear();
+            object.nextMaxSets = object.maxSets.value();
+
+            return object;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
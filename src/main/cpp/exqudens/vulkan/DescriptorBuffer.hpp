@@ -0,0 +1,506 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <unordered_map>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "exqudens/vulkan/export.hpp"
+#include "exqudens/vulkan/Buffer.hpp"
+#include "exqudens/vulkan/DeviceMemory.hpp"
+#include "exqudens/vulkan/DescriptorSetLayout.hpp"
+
+namespace exqudens::vulkan {
+
+    // layouts need 'eDescriptorBufferEXT' and pipelines 'eDescriptorBufferEXT' create flags to be used with it
+    struct EXQUDENS_VULKAN_EXPORT DescriptorBuffer {
+
+        class Builder;
+
+        std::vector<VULKAN_HPP_NAMESPACE::DescriptorSetLayout> layouts = {};
+        // per layout, queried from the built layout when it is added
+        std::vector<VULKAN_HPP_NAMESPACE::DeviceSize> layoutSizes = {};
+        std::vector<std::unordered_map<uint32_t, VULKAN_HPP_NAMESPACE::DeviceSize>> bindingOffsets = {};
+        std::optional<VULKAN_HPP_NAMESPACE::BufferUsageFlags> usage = {};
+        // must match the device feature, robust buffer descriptors are larger
+        bool robustBufferAccess = false;
+        std::optional<uint32_t> frameCount = {};
+        uint64_t frame = 0;
+        std::optional<VULKAN_HPP_NAMESPACE::PhysicalDeviceDescriptorBufferPropertiesEXT> properties = {};
+        // 'frameCount' rings of one region per layout, frame major
+        std::vector<VULKAN_HPP_NAMESPACE::DeviceSize> offsets = {};
+        VULKAN_HPP_NAMESPACE::DeviceAddress address = 0;
+        Buffer buffer = {};
+        DeviceMemory memory = {};
+
+        static std::vector<VULKAN_HPP_NAMESPACE::DeviceSize> offsetsFrom(
+            const std::vector<VULKAN_HPP_NAMESPACE::DeviceSize>& layoutSizes,
+            VULKAN_HPP_NAMESPACE::DeviceSize alignment,
+            uint32_t frameCount,
+            VULKAN_HPP_NAMESPACE::DeviceSize* size = nullptr
+        );
+
+        static Builder builder(DescriptorBuffer& object);
+
+        size_t descriptorSizeFrom(const VULKAN_HPP_NAMESPACE::DescriptorType& type) const;
+
+        // inside the region of the current frame
+        VULKAN_HPP_NAMESPACE::DeviceSize offsetFrom(
+            uint32_t set,
+            uint32_t binding,
+            uint32_t arrayElement,
+            const VULKAN_HPP_NAMESPACE::DescriptorType& type
+        ) const;
+
+        void write(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            uint32_t set,
+            uint32_t binding,
+            uint32_t arrayElement,
+            const VULKAN_HPP_NAMESPACE::DescriptorType& type,
+            const VULKAN_HPP_NAMESPACE::DescriptorImageInfo& value
+        );
+
+        void write(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            uint32_t set,
+            uint32_t binding,
+            uint32_t arrayElement,
+            const VULKAN_HPP_NAMESPACE::DescriptorType& type,
+            const VULKAN_HPP_NAMESPACE::DescriptorAddressInfoEXT& value
+        );
+
+        // same writes a caller gives 'updateDescriptorSets' for 'DescriptorSets', 'dstSet' is ignored and 'set' indexes 'layouts',
+        // buffers need 'eShaderDeviceAddress' usage and an explicit range
+        void update(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            uint32_t set,
+            const std::vector<VULKAN_HPP_NAMESPACE::WriteDescriptorSet>& writes
+        );
+
+        void bind(
+            VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer,
+            const VULKAN_HPP_NAMESPACE::PipelineBindPoint& bindPoint,
+            const VULKAN_HPP_NAMESPACE::PipelineLayout& pipelineLayout,
+            uint32_t firstSet = 0
+        ) const;
+
+        // the next frame writes and binds its own regions, so frames still in flight keep reading theirs
+        void nextFrame();
+
+        void clear();
+
+        void clearAndRelease();
+
+    };
+
+    class EXQUDENS_VULKAN_EXPORT DescriptorBuffer::Builder {
+
+        private:
+
+            DescriptorBuffer& object;
+
+        public:
+
+            explicit Builder(DescriptorBuffer& object);
+
+            // 'value' must be built, its size and binding offsets are read from it
+            Builder& addLayout(const DescriptorSetLayout& value);
+
+            Builder& setUsage(const VULKAN_HPP_NAMESPACE::BufferUsageFlags& value);
+
+            Builder& setRobustBufferAccess(bool value);
+
+            Builder& setFrameCount(uint32_t value);
+
+            DescriptorBuffer& build(
+                VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice,
+                VULKAN_HPP_NAMESPACE::raii::Device& device
+            );
+
+    };
+
+}
+
+// implementation ---
+
+#include <cstddef>
+#include <algorithm>
+#include <string>
+#include <filesystem>
+#include <stdexcept>
+
+#define CALL_INFO std::string(__FUNCTION__) + " (" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::vulkan {
+
+    EXQUDENS_VULKAN_INLINE std::vector<VULKAN_HPP_NAMESPACE::DeviceSize> DescriptorBuffer::offsetsFrom(
+        const std::vector<VULKAN_HPP_NAMESPACE::DeviceSize>& layoutSizes,
+        VULKAN_HPP_NAMESPACE::DeviceSize alignment,
+        uint32_t frameCount,
+        VULKAN_HPP_NAMESPACE::DeviceSize* size
+    ) {
+        try {
+            // each region aligned for 'setDescriptorBufferOffsetsEXT'
+            alignment = std::max<VULKAN_HPP_NAMESPACE::DeviceSize>(alignment, 1);
+            VULKAN_HPP_NAMESPACE::DeviceSize end = 0;
+            std::vector<VULKAN_HPP_NAMESPACE::DeviceSize> result = {};
+
+            for (uint32_t i = 0; i < frameCount; i++) {
+                for (VULKAN_HPP_NAMESPACE::DeviceSize layoutSize : layoutSizes) {
+                    end = (end + alignment - 1) / alignment * alignment;
+                    result.emplace_back(end);
+                    end += layoutSize;
+                }
+            }
+
+            if (size != nullptr) {
+                *size = end;
+            }
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorBuffer::Builder DescriptorBuffer::builder(DescriptorBuffer& object) {
+        return Builder(object);
+    }
+
+    EXQUDENS_VULKAN_INLINE size_t DescriptorBuffer::descriptorSizeFrom(const VULKAN_HPP_NAMESPACE::DescriptorType& type) const {
+        try {
+            if (!properties.has_value()) {
+                throw std::runtime_error(CALL_INFO + ": 'properties' is not initialized");
+            }
+
+            const VULKAN_HPP_NAMESPACE::PhysicalDeviceDescriptorBufferPropertiesEXT& value = properties.value();
+
+            switch (type) {
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eSampler:
+                    return value.samplerDescriptorSize;
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eCombinedImageSampler:
+                    return value.combinedImageSamplerDescriptorSize;
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eSampledImage:
+                    return value.sampledImageDescriptorSize;
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eStorageImage:
+                    return value.storageImageDescriptorSize;
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eUniformTexelBuffer:
+                    return robustBufferAccess ? value.robustUniformTexelBufferDescriptorSize : value.uniformTexelBufferDescriptorSize;
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eStorageTexelBuffer:
+                    return robustBufferAccess ? value.robustStorageTexelBufferDescriptorSize : value.storageTexelBufferDescriptorSize;
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eUniformBuffer:
+                    return robustBufferAccess ? value.robustUniformBufferDescriptorSize : value.uniformBufferDescriptorSize;
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eStorageBuffer:
+                    return robustBufferAccess ? value.robustStorageBufferDescriptorSize : value.storageBufferDescriptorSize;
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eInputAttachment:
+                    return value.inputAttachmentDescriptorSize;
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eAccelerationStructureKHR:
+                    return value.accelerationStructureDescriptorSize;
+                default:
+                    throw std::runtime_error(CALL_INFO + ": unsupported descriptor type");
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE VULKAN_HPP_NAMESPACE::DeviceSize DescriptorBuffer::offsetFrom(
+        uint32_t set,
+        uint32_t binding,
+        uint32_t arrayElement,
+        const VULKAN_HPP_NAMESPACE::DescriptorType& type
+    ) const {
+        try {
+            if (!frameCount.has_value()) {
+                throw std::runtime_error(CALL_INFO + ": 'frameCount' is not initialized");
+            }
+
+            auto it = bindingOffsets.at(set).find(binding);
+
+            if (it == bindingOffsets.at(set).end()) {
+                throw std::runtime_error(CALL_INFO + ": set " + std::to_string(set) + " has no binding " + std::to_string(binding));
+            }
+
+            size_t region = static_cast<size_t>(frame % frameCount.value()) * layouts.size() + set;
+            return offsets.at(region) + it->second + arrayElement * descriptorSizeFrom(type);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorBuffer::write(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        uint32_t set,
+        uint32_t binding,
+        uint32_t arrayElement,
+        const VULKAN_HPP_NAMESPACE::DescriptorType& type,
+        const VULKAN_HPP_NAMESPACE::DescriptorImageInfo& value
+    ) {
+        try {
+            VULKAN_HPP_NAMESPACE::DescriptorDataEXT data = {};
+
+            switch (type) {
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eSampler:
+                    data.pSampler = &value.sampler;
+                    break;
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eCombinedImageSampler:
+                    data.pCombinedImageSampler = &value;
+                    break;
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eSampledImage:
+                    data.pSampledImage = &value;
+                    break;
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eStorageImage:
+                    data.pStorageImage = &value;
+                    break;
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eInputAttachment:
+                    data.pInputAttachmentImage = &value;
+                    break;
+                default:
+                    throw std::runtime_error(CALL_INFO + ": not an image descriptor type");
+            }
+
+            // descriptors land straight in the mapped buffer, no set or pool is involved
+            uint8_t* target = static_cast<uint8_t*>(memory.mappedData) + offsetFrom(set, binding, arrayElement, type);
+            device.getDescriptorEXT(VULKAN_HPP_NAMESPACE::DescriptorGetInfoEXT(type, data), descriptorSizeFrom(type), target);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorBuffer::write(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        uint32_t set,
+        uint32_t binding,
+        uint32_t arrayElement,
+        const VULKAN_HPP_NAMESPACE::DescriptorType& type,
+        const VULKAN_HPP_NAMESPACE::DescriptorAddressInfoEXT& value
+    ) {
+        try {
+            VULKAN_HPP_NAMESPACE::DescriptorDataEXT data = {};
+
+            switch (type) {
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eUniformBuffer:
+                    data.pUniformBuffer = &value;
+                    break;
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eStorageBuffer:
+                    data.pStorageBuffer = &value;
+                    break;
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eUniformTexelBuffer:
+                    data.pUniformTexelBuffer = &value;
+                    break;
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eStorageTexelBuffer:
+                    data.pStorageTexelBuffer = &value;
+                    break;
+                default:
+                    throw std::runtime_error(CALL_INFO + ": not a buffer descriptor type");
+            }
+
+            uint8_t* target = static_cast<uint8_t*>(memory.mappedData) + offsetFrom(set, binding, arrayElement, type);
+            device.getDescriptorEXT(VULKAN_HPP_NAMESPACE::DescriptorGetInfoEXT(type, data), descriptorSizeFrom(type), target);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorBuffer::update(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        uint32_t set,
+        const std::vector<VULKAN_HPP_NAMESPACE::WriteDescriptorSet>& writes
+    ) {
+        try {
+            for (const VULKAN_HPP_NAMESPACE::WriteDescriptorSet& value : writes) {
+                for (uint32_t i = 0; i < value.descriptorCount; i++) {
+                    // the info array is chosen by type, the other pointers may be stale
+                    switch (value.descriptorType) {
+                        case VULKAN_HPP_NAMESPACE::DescriptorType::eSampler:
+                        case VULKAN_HPP_NAMESPACE::DescriptorType::eCombinedImageSampler:
+                        case VULKAN_HPP_NAMESPACE::DescriptorType::eSampledImage:
+                        case VULKAN_HPP_NAMESPACE::DescriptorType::eStorageImage:
+                        case VULKAN_HPP_NAMESPACE::DescriptorType::eInputAttachment:
+                            write(device, set, value.dstBinding, value.dstArrayElement + i, value.descriptorType, value.pImageInfo[i]);
+                            break;
+                        case VULKAN_HPP_NAMESPACE::DescriptorType::eUniformBuffer:
+                        case VULKAN_HPP_NAMESPACE::DescriptorType::eStorageBuffer: {
+                            const VULKAN_HPP_NAMESPACE::DescriptorBufferInfo& info = value.pBufferInfo[i];
+                            if (info.range == VK_WHOLE_SIZE) {
+                                throw std::runtime_error(CALL_INFO + ": buffer descriptors need an explicit range");
+                            }
+                            VULKAN_HPP_NAMESPACE::DeviceAddress bufferAddress = device.getBufferAddress(VULKAN_HPP_NAMESPACE::BufferDeviceAddressInfo().setBuffer(info.buffer));
+                            write(device, set, value.dstBinding, value.dstArrayElement + i, value.descriptorType, VULKAN_HPP_NAMESPACE::DescriptorAddressInfoEXT(bufferAddress + info.offset, info.range));
+                            break;
+                        }
+                        default:
+                            // texel buffers need a format and an address instead of a view, dynamic buffers do not exist here
+                            throw std::runtime_error(CALL_INFO + ": descriptor type " + VULKAN_HPP_NAMESPACE::to_string(value.descriptorType) + " is not supported, use 'write()'");
+                    }
+                }
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorBuffer::bind(
+        VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer,
+        const VULKAN_HPP_NAMESPACE::PipelineBindPoint& bindPoint,
+        const VULKAN_HPP_NAMESPACE::PipelineLayout& pipelineLayout,
+        uint32_t firstSet
+    ) const {
+        try {
+            if (!frameCount.has_value()) {
+                throw std::runtime_error(CALL_INFO + ": 'frameCount' is not initialized");
+            }
+
+            commandBuffer.bindDescriptorBuffersEXT(VULKAN_HPP_NAMESPACE::DescriptorBufferBindingInfoEXT(address, usage.value()));
+
+            // every set reads from the single bound buffer, at its region of the current frame
+            std::vector<uint32_t> bufferIndices(layouts.size(), 0);
+            std::vector<VULKAN_HPP_NAMESPACE::DeviceSize> frameOffsets(
+                offsets.begin() + static_cast<std::ptrdiff_t>(frame % frameCount.value() * layouts.size()),
+                offsets.begin() + static_cast<std::ptrdiff_t>((frame % frameCount.value() + 1) * layouts.size())
+            );
+            commandBuffer.setDescriptorBufferOffsetsEXT(bindPoint, pipelineLayout, firstSet, bufferIndices, frameOffsets);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorBuffer::nextFrame() {
+        try {
+            frame++;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorBuffer::clear() {
+        try {
+            layouts.clear();
+            layoutSizes.clear();
+            bindingOffsets.clear();
+            usage.reset();
+            robustBufferAccess = false;
+            frameCount.reset();
+            frame = 0;
+            properties.reset();
+            offsets.clear();
+            address = 0;
+            memory.clear();
+            buffer.clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorBuffer::clearAndRelease() {
+        try {
+            buffer.clearAndRelease();
+            memory.clearAndRelease();
+            clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorBuffer::Builder::Builder(DescriptorBuffer& object): object(object) {
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorBuffer::Builder& DescriptorBuffer::Builder::addLayout(const DescriptorSetLayout& value) {
+        try {
+            std::unordered_map<uint32_t, VULKAN_HPP_NAMESPACE::DeviceSize> offsets = {};
+            for (const VULKAN_HPP_NAMESPACE::DescriptorSetLayoutBinding& binding : value.bindings) {
+                offsets[binding.binding] = value.target.getBindingOffsetEXT(binding.binding);
+            }
+
+            object.layouts.emplace_back(*value.target);
+            object.layoutSizes.emplace_back(value.target.getSizeEXT());
+            object.bindingOffsets.emplace_back(std::move(offsets));
+            return *this;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorBuffer::Builder& DescriptorBuffer::Builder::setUsage(const VULKAN_HPP_NAMESPACE::BufferUsageFlags& value) {
+        object.usage = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorBuffer::Builder& DescriptorBuffer::Builder::setRobustBufferAccess(bool value) {
+        object.robustBufferAccess = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorBuffer::Builder& DescriptorBuffer::Builder::setFrameCount(uint32_t value) {
+        object.frameCount = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorBuffer& DescriptorBuffer::Builder::build(
+        VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice,
+        VULKAN_HPP_NAMESPACE::raii::Device& device
+    ) {
+        try {
+            if (object.layouts.empty()) {
+                throw std::runtime_error(CALL_INFO + ": 'layouts' is empty");
+            }
+
+            if (!object.usage.has_value()) {
+                object.usage = VULKAN_HPP_NAMESPACE::BufferUsageFlagBits::eResourceDescriptorBufferEXT
+                    | VULKAN_HPP_NAMESPACE::BufferUsageFlagBits::eSamplerDescriptorBufferEXT
+                    | VULKAN_HPP_NAMESPACE::BufferUsageFlagBits::eShaderDeviceAddress;
+            }
+
+            // same default as 'DeferredRelease'
+            if (!object.frameCount.has_value()) {
+                object.frameCount = 2;
+            }
+
+            if (object.frameCount.value() == 0) {
+                throw std::runtime_error(CALL_INFO + ": 'frameCount' is zero");
+            }
+
+            auto chain = physicalDevice.getProperties2<
+                VULKAN_HPP_NAMESPACE::PhysicalDeviceProperties2,
+                VULKAN_HPP_NAMESPACE::PhysicalDeviceDescriptorBufferPropertiesEXT
+            >();
+            object.properties = chain.get<VULKAN_HPP_NAMESPACE::PhysicalDeviceDescriptorBufferPropertiesEXT>();
+
+            VULKAN_HPP_NAMESPACE::DeviceSize size = 0;
+            object.offsets = offsetsFrom(object.layoutSizes, object.properties.value().descriptorBufferOffsetAlignment, object.frameCount.value(), &size);
+            object.frame = 0;
+
+            Buffer::builder(object.buffer)
+            .setCreateInfo(
+                VULKAN_HPP_NAMESPACE::BufferCreateInfo()
+                .setSize(std::max<VULKAN_HPP_NAMESPACE::DeviceSize>(size, 1))
+                .setUsage(object.usage.value())
+                .setSharingMode(VULKAN_HPP_NAMESPACE::SharingMode::eExclusive)
+            )
+            .build(device);
+
+            DeviceMemory::builder(object.memory)
+            .setAllocateInfo(DeviceMemory::allocateInfoFrom(
+                physicalDevice,
+                object.buffer.target,
+                VULKAN_HPP_NAMESPACE::MemoryPropertyFlagBits::eHostVisible | VULKAN_HPP_NAMESPACE::MemoryPropertyFlagBits::eHostCoherent
+            ))
+            .setAllocateFlagsInfo(VULKAN_HPP_NAMESPACE::MemoryAllocateFlagsInfo().setFlags(VULKAN_HPP_NAMESPACE::MemoryAllocateFlagBits::eDeviceAddress))
+            .setPersistentMap(true)
+            .build(physicalDevice, device);
+
+            object.buffer.target.bindMemory(*object.memory.target, 0);
+            object.address = device.getBufferAddress(VULKAN_HPP_NAMESPACE::BufferDeviceAddressInfo().setBuffer(*object.buffer.target));
+
+            return object;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
@@ -0,0 +1,411 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <deque>
+#include <mutex>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "exqudens/vulkan/export.hpp"
+#include "exqudens/vulkan/DescriptorSetLayout.hpp"
+#include "exqudens/vulkan/DescriptorPool.hpp"
+#include "exqudens/vulkan/DescriptorSets.hpp"
+
+namespace exqudens::vulkan {
+
+    struct EXQUDENS_VULKAN_EXPORT DescriptorHeap {
+
+        class Builder;
+
+        // one bindless array per binding, indexed by the slot handed out by 'allocate()'
+        struct Array {
+            VULKAN_HPP_NAMESPACE::DescriptorType type = VULKAN_HPP_NAMESPACE::DescriptorType::eSampledImage;
+            uint32_t capacity = 0;
+            uint32_t next = 0;
+            std::vector<uint32_t> freeSlots = {};
+            // slots handed out and not yet freed, so a second 'free()' of the same slot is caught
+            std::vector<bool> live = {};
+        };
+
+        struct Pending {
+            uint64_t frame = 0;
+            uint32_t binding = 0;
+            uint32_t index = 0;
+        };
+
+        std::vector<Array> arrays = {};
+        VULKAN_HPP_NAMESPACE::ShaderStageFlags stageFlags = VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eAll;
+        std::optional<uint32_t> frameCount = {};
+        uint64_t frame = 0;
+        std::deque<Pending> pending = {};
+        DescriptorSetLayout layout = {};
+        DescriptorPool pool = {};
+        DescriptorSets sets = {};
+        std::mutex mutex = {};
+
+        static Builder builder(DescriptorHeap& object);
+
+        uint32_t allocate(uint32_t binding);
+
+        void free(uint32_t binding, uint32_t index);
+
+        void write(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            uint32_t binding,
+            uint32_t index,
+            const VULKAN_HPP_NAMESPACE::DescriptorImageInfo& value
+        );
+
+        void write(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            uint32_t binding,
+            uint32_t index,
+            const VULKAN_HPP_NAMESPACE::DescriptorBufferInfo& value
+        );
+
+        uint32_t add(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            uint32_t binding,
+            const VULKAN_HPP_NAMESPACE::DescriptorImageInfo& value
+        );
+
+        uint32_t add(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            uint32_t binding,
+            const VULKAN_HPP_NAMESPACE::DescriptorBufferInfo& value
+        );
+
+        VULKAN_HPP_NAMESPACE::DescriptorSet set() const;
+
+        void bind(
+            VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer,
+            const VULKAN_HPP_NAMESPACE::PipelineBindPoint& bindPoint,
+            const VULKAN_HPP_NAMESPACE::PipelineLayout& pipelineLayout,
+            uint32_t firstSet = 0
+        ) const;
+
+        void nextFrame();
+
+        void clear();
+
+        void clearAndRelease();
+
+    };
+
+    class EXQUDENS_VULKAN_EXPORT DescriptorHeap::Builder {
+
+        private:
+
+            DescriptorHeap& object;
+
+        public:
+
+            explicit Builder(DescriptorHeap& object);
+
+            Builder& addArray(const VULKAN_HPP_NAMESPACE::DescriptorType& type, uint32_t capacity);
+
+            Builder& setStageFlags(const VULKAN_HPP_NAMESPACE::ShaderStageFlags& value);
+
+            Builder& setFrameCount(uint32_t value);
+
+            DescriptorHeap& build(
+                VULKAN_HPP_NAMESPACE::raii::Device& device
+            );
+
+    };
+
+}
+
+// implementation ---
+
+#include <string>
+#include <filesystem>
+#include <stdexcept>
+
+#define CALL_INFO std::string(__FUNCTION__) + " (" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::vulkan {
+
+    EXQUDENS_VULKAN_INLINE DescriptorHeap::Builder DescriptorHeap::builder(DescriptorHeap& object) {
+        return Builder(object);
+    }
+
+    EXQUDENS_VULKAN_INLINE uint32_t DescriptorHeap::allocate(uint32_t binding) {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            Array& array = arrays.at(binding);
+
+            uint32_t result = 0;
+
+            if (!array.freeSlots.empty()) {
+                result = array.freeSlots.back();
+                array.freeSlots.pop_back();
+            } else if (array.next < array.capacity) {
+                result = array.next++;
+            } else {
+                throw std::runtime_error(CALL_INFO + ": binding " + std::to_string(binding) + " is full");
+            }
+
+            array.live.resize(array.capacity, false);
+            array.live.at(result) = true;
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorHeap::free(uint32_t binding, uint32_t index) {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            Array& array = arrays.at(binding);
+
+            if (index >= array.live.size() || !array.live.at(index)) {
+                throw std::runtime_error(CALL_INFO + ": index " + std::to_string(index) + " is not allocated or already freed");
+            }
+
+            array.live.at(index) = false;
+
+            // in-flight frames may still index the slot, so it is reused only after 'frameCount' frames
+            Pending value = {};
+            value.frame = frame;
+            value.binding = binding;
+            value.index = index;
+            pending.emplace_back(value);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorHeap::write(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        uint32_t binding,
+        uint32_t index,
+        const VULKAN_HPP_NAMESPACE::DescriptorImageInfo& value
+    ) {
+        try {
+            if (index >= arrays.at(binding).capacity) {
+                throw std::runtime_error(CALL_INFO + ": index " + std::to_string(index) + " is out of binding " + std::to_string(binding) + " capacity");
+            }
+
+            // update-after-bind, so writing while the set is bound by recorded commands is valid
+            device.updateDescriptorSets(
+                VULKAN_HPP_NAMESPACE::WriteDescriptorSet()
+                .setDstSet(set())
+                .setDstBinding(binding)
+                .setDstArrayElement(index)
+                .setDescriptorType(arrays.at(binding).type)
+                .setImageInfo(value),
+                nullptr
+            );
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorHeap::write(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        uint32_t binding,
+        uint32_t index,
+        const VULKAN_HPP_NAMESPACE::DescriptorBufferInfo& value
+    ) {
+        try {
+            if (index >= arrays.at(binding).capacity) {
+                throw std::runtime_error(CALL_INFO + ": index " + std::to_string(index) + " is out of binding " + std::to_string(binding) + " capacity");
+            }
+
+            device.updateDescriptorSets(
+                VULKAN_HPP_NAMESPACE::WriteDescriptorSet()
+                .setDstSet(set())
+                .setDstBinding(binding)
+                .setDstArrayElement(index)
+                .setDescriptorType(arrays.at(binding).type)
+                .setBufferInfo(value),
+                nullptr
+            );
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE uint32_t DescriptorHeap::add(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        uint32_t binding,
+        const VULKAN_HPP_NAMESPACE::DescriptorImageInfo& value
+    ) {
+        try {
+            uint32_t result = allocate(binding);
+            write(device, binding, result, value);
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE uint32_t DescriptorHeap::add(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        uint32_t binding,
+        const VULKAN_HPP_NAMESPACE::DescriptorBufferInfo& value
+    ) {
+        try {
+            uint32_t result = allocate(binding);
+            write(device, binding, result, value);
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE VULKAN_HPP_NAMESPACE::DescriptorSet DescriptorHeap::set() const {
+        try {
+            if (sets.targets.empty()) {
+                throw std::runtime_error(CALL_INFO + ": heap is not built");
+            }
+            return *sets.targets.front();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorHeap::bind(
+        VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer,
+        const VULKAN_HPP_NAMESPACE::PipelineBindPoint& bindPoint,
+        const VULKAN_HPP_NAMESPACE::PipelineLayout& pipelineLayout,
+        uint32_t firstSet
+    ) const {
+        try {
+            commandBuffer.bindDescriptorSets(bindPoint, pipelineLayout, firstSet, set(), nullptr);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorHeap::nextFrame() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            frame++;
+
+            while (!pending.empty() && pending.front().frame + frameCount.value() <= frame) {
+                arrays.at(pending.front().binding).freeSlots.emplace_back(pending.front().index);
+                pending.pop_front();
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorHeap::clear() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            arrays.clear();
+            stageFlags = VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eAll;
+            frameCount.reset();
+            frame = 0;
+            pending.clear();
+            sets.clear();
+            pool.clear();
+            layout.clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorHeap::clearAndRelease() {
+        try {
+            sets.clearAndRelease();
+            pool.clearAndRelease();
+            layout.clearAndRelease();
+            clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorHeap::Builder::Builder(DescriptorHeap& object): object(object) {
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorHeap::Builder& DescriptorHeap::Builder::addArray(const VULKAN_HPP_NAMESPACE::DescriptorType& type, uint32_t capacity) {
+        Array value = {};
+        value.type = type;
+        value.capacity = capacity;
+        object.arrays.emplace_back(value);
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorHeap::Builder& DescriptorHeap::Builder::setStageFlags(const VULKAN_HPP_NAMESPACE::ShaderStageFlags& value) {
+        object.stageFlags = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorHeap::Builder& DescriptorHeap::Builder::setFrameCount(uint32_t value) {
+        object.frameCount = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorHeap& DescriptorHeap::Builder::build(
+        VULKAN_HPP_NAMESPACE::raii::Device& device
+    ) {
+        try {
+            if (object.arrays.empty()) {
+                throw std::runtime_error(CALL_INFO + ": 'arrays' is empty");
+            }
+
+            // same default as 'DeferredRelease'
+            if (!object.frameCount.has_value()) {
+                object.frameCount = 2;
+            }
+
+            if (object.frameCount.value() == 0) {
+                throw std::runtime_error(CALL_INFO + ": 'frameCount' is zero");
+            }
+
+            VULKAN_HPP_NAMESPACE::DescriptorBindingFlags bindingFlags = VULKAN_HPP_NAMESPACE::DescriptorBindingFlagBits::ePartiallyBound
+                | VULKAN_HPP_NAMESPACE::DescriptorBindingFlagBits::eUpdateAfterBind
+                | VULKAN_HPP_NAMESPACE::DescriptorBindingFlagBits::eUpdateUnusedWhilePending;
+
+            object.sets.clear();
+            object.pool.clear();
+            object.layout.clear();
+
+            DescriptorSetLayout::Builder layoutBuilder = DescriptorSetLayout::builder(object.layout);
+            DescriptorPool::Builder poolBuilder = DescriptorPool::builder(object.pool);
+
+            for (uint32_t i = 0; i < object.arrays.size(); i++) {
+                DescriptorHeap::Array& array = object.arrays.at(i);
+                array.next = 0;
+                array.freeSlots.clear();
+                array.live.assign(array.capacity, false);
+
+                layoutBuilder
+                .addBinding(VULKAN_HPP_NAMESPACE::DescriptorSetLayoutBinding(i, array.type, array.capacity, object.stageFlags))
+                .addBindingFlags(bindingFlags);
+                poolBuilder.addSize(VULKAN_HPP_NAMESPACE::DescriptorPoolSize(array.type, array.capacity));
+            }
+
+            layoutBuilder
+            .setCreateInfo(VULKAN_HPP_NAMESPACE::DescriptorSetLayoutCreateInfo().setFlags(VULKAN_HPP_NAMESPACE::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool))
+            .build(device);
+
+            poolBuilder
+            .setCreateInfo(VULKAN_HPP_NAMESPACE::DescriptorPoolCreateInfo().setFlags(VULKAN_HPP_NAMESPACE::DescriptorPoolCreateFlagBits::eUpdateAfterBind | VULKAN_HPP_NAMESPACE::DescriptorPoolCreateFlagBits::eFreeDescriptorSet).setMaxSets(1))
+            .build(device);
+
+            DescriptorSets::builder(object.sets)
+            .addLayout(*object.layout.target)
+            .setAllocateInfo(VULKAN_HPP_NAMESPACE::DescriptorSetAllocateInfo().setDescriptorPool(*object.pool.target))
+            .build(device);
+
+            object.frame = 0;
+            object.pending.clear();
+
+            return object;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
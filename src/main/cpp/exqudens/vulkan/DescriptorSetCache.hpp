@@ -0,0 +1,410 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "exqudens/vulkan/export.hpp"
+#include "exqudens/vulkan/DescriptorPool.hpp"
+
+namespace exqudens::vulkan {
+
+    struct EXQUDENS_VULKAN_EXPORT DescriptorSetCache {
+
+        class Builder;
+
+        static constexpr uint32_t DEFAULT_CAPACITY = 1024;
+
+        // layout handle followed by every bound resource, compared in full
+        using Key = std::vector<uint64_t>;
+
+        struct EXQUDENS_VULKAN_EXPORT KeyHash {
+            size_t operator()(const Key& value) const;
+        };
+
+        struct Entry {
+            Key key = {};
+            VULKAN_HPP_NAMESPACE::DescriptorSetLayout layout = {};
+            VULKAN_HPP_NAMESPACE::DescriptorSet set = {};
+            uint64_t frame = 0;
+        };
+
+        // descriptor counts per set, scaled by 'capacity'
+        std::vector<VULKAN_HPP_NAMESPACE::DescriptorPoolSize> sizes = {};
+        std::optional<uint32_t> capacity = {};
+        std::optional<uint32_t> frameCount = {};
+        uint64_t frame = 0;
+        DescriptorPool pool = {};
+        // most recently used first
+        std::list<Entry> entries = {};
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index = {};
+        std::mutex mutex = {};
+
+        static Key keyFrom(
+            const VULKAN_HPP_NAMESPACE::DescriptorSetLayout& layout,
+            const std::vector<VULKAN_HPP_NAMESPACE::WriteDescriptorSet>& writes
+        );
+
+        static Builder builder(DescriptorSetCache& object);
+
+        // 'writes' leave 'dstSet' empty, it is filled in on a miss
+        VULKAN_HPP_NAMESPACE::DescriptorSet obtain(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            const VULKAN_HPP_NAMESPACE::DescriptorSetLayout& layout,
+            const std::vector<VULKAN_HPP_NAMESPACE::WriteDescriptorSet>& writes
+        );
+
+        // handle values are reused once an object is destroyed, so every entry naming it must go before that
+        template<typename T>
+        void erase(const T& handle) {
+            erase(reinterpret_cast<uint64_t>(static_cast<typename T::CType>(handle)));
+        }
+
+        void erase(uint64_t handle);
+
+        void nextFrame();
+
+        size_t size();
+
+        void clear();
+
+        void clearAndRelease();
+
+    };
+
+    class EXQUDENS_VULKAN_EXPORT DescriptorSetCache::Builder {
+
+        private:
+
+            DescriptorSetCache& object;
+
+        public:
+
+            explicit Builder(DescriptorSetCache& object);
+
+            Builder& setSizes(const std::vector<VULKAN_HPP_NAMESPACE::DescriptorPoolSize>& value);
+
+            Builder& addSize(const VULKAN_HPP_NAMESPACE::DescriptorPoolSize& value);
+
+            Builder& setCapacity(uint32_t value);
+
+            Builder& setFrameCount(uint32_t value);
+
+            DescriptorSetCache& build(
+                VULKAN_HPP_NAMESPACE::raii::Device& device
+            );
+
+    };
+
+}
+
+// implementation ---
+
+#include <utility>
+#include <algorithm>
+#include <string>
+#include <filesystem>
+#include <stdexcept>
+
+#include "exqudens/vulkan/PipelineStateKey.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + " (" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::vulkan {
+
+    EXQUDENS_VULKAN_INLINE size_t DescriptorSetCache::KeyHash::operator()(const Key& value) const {
+        return static_cast<size_t>(PipelineStateKey::hashBytes(value.data(), sizeof(uint64_t) * value.size()));
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorSetCache::Key DescriptorSetCache::keyFrom(
+        const VULKAN_HPP_NAMESPACE::DescriptorSetLayout& layout,
+        const std::vector<VULKAN_HPP_NAMESPACE::WriteDescriptorSet>& writes
+    ) {
+        try {
+            Key result = {};
+            result.emplace_back(reinterpret_cast<uint64_t>(static_cast<VkDescriptorSetLayout>(layout)));
+
+            for (const VULKAN_HPP_NAMESPACE::WriteDescriptorSet& write : writes) {
+                result.emplace_back(write.dstBinding);
+                result.emplace_back(write.dstArrayElement);
+                result.emplace_back(write.descriptorCount);
+                result.emplace_back(static_cast<uint64_t>(write.descriptorType));
+
+                // the descriptor type decides which array is read, the others may hold stale pointers
+                auto check = [&write](const void* value, const std::string& name) {
+                    if (value == nullptr && write.descriptorCount > 0) {
+                        throw std::runtime_error(CALL_INFO + ": '" + name + "' is null for type '" + VULKAN_HPP_NAMESPACE::to_string(write.descriptorType) + "'");
+                    }
+                };
+
+                switch (write.descriptorType) {
+                    case VULKAN_HPP_NAMESPACE::DescriptorType::eSampler:
+                    case VULKAN_HPP_NAMESPACE::DescriptorType::eCombinedImageSampler:
+                    case VULKAN_HPP_NAMESPACE::DescriptorType::eSampledImage:
+                    case VULKAN_HPP_NAMESPACE::DescriptorType::eStorageImage:
+                    case VULKAN_HPP_NAMESPACE::DescriptorType::eInputAttachment:
+                        check(write.pImageInfo, "pImageInfo");
+                        for (uint32_t i = 0; i < write.descriptorCount; i++) {
+                            result.emplace_back(reinterpret_cast<uint64_t>(static_cast<VkSampler>(write.pImageInfo[i].sampler)));
+                            result.emplace_back(reinterpret_cast<uint64_t>(static_cast<VkImageView>(write.pImageInfo[i].imageView)));
+                            result.emplace_back(static_cast<uint64_t>(write.pImageInfo[i].imageLayout));
+                        }
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DescriptorType::eUniformBuffer:
+                    case VULKAN_HPP_NAMESPACE::DescriptorType::eStorageBuffer:
+                    case VULKAN_HPP_NAMESPACE::DescriptorType::eUniformBufferDynamic:
+                    case VULKAN_HPP_NAMESPACE::DescriptorType::eStorageBufferDynamic:
+                        check(write.pBufferInfo, "pBufferInfo");
+                        for (uint32_t i = 0; i < write.descriptorCount; i++) {
+                            result.emplace_back(reinterpret_cast<uint64_t>(static_cast<VkBuffer>(write.pBufferInfo[i].buffer)));
+                            result.emplace_back(write.pBufferInfo[i].offset);
+                            result.emplace_back(write.pBufferInfo[i].range);
+                        }
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DescriptorType::eUniformTexelBuffer:
+                    case VULKAN_HPP_NAMESPACE::DescriptorType::eStorageTexelBuffer:
+                        check(write.pTexelBufferView, "pTexelBufferView");
+                        for (uint32_t i = 0; i < write.descriptorCount; i++) {
+                            result.emplace_back(reinterpret_cast<uint64_t>(static_cast<VkBufferView>(write.pTexelBufferView[i])));
+                        }
+                        break;
+                    default:
+                        throw std::runtime_error(CALL_INFO + ": unsupported type '" + VULKAN_HPP_NAMESPACE::to_string(write.descriptorType) + "'");
+                }
+            }
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorSetCache::Builder DescriptorSetCache::builder(DescriptorSetCache& object) {
+        return Builder(object);
+    }
+
+    EXQUDENS_VULKAN_INLINE VULKAN_HPP_NAMESPACE::DescriptorSet DescriptorSetCache::obtain(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        const VULKAN_HPP_NAMESPACE::DescriptorSetLayout& layout,
+        const std::vector<VULKAN_HPP_NAMESPACE::WriteDescriptorSet>& writes
+    ) {
+        try {
+            Key key = keyFrom(layout, writes);
+
+            std::lock_guard<std::mutex> lock(mutex);
+
+            auto it = index.find(key);
+
+            if (it != index.end()) {
+                entries.splice(entries.begin(), entries, it->second);
+                entries.front().frame = frame;
+                return entries.front().set;
+            }
+
+            // entries read by frames still in flight are never evicted
+            auto evictable = [this]() {
+                return !entries.empty() && entries.back().frame + frameCount.value() <= frame;
+            };
+
+            auto evict = [this, &device]() {
+                Entry& entry = entries.back();
+                (*device).freeDescriptorSets(*pool.target, entry.set, *device.getDispatcher());
+                index.erase(entry.key);
+                entries.pop_back();
+            };
+
+            Entry entry = {};
+            entry.key = std::move(key);
+            entry.layout = layout;
+            entry.frame = frame;
+
+            if (evictable() && entries.back().layout == layout && entries.size() >= capacity.value_or(DEFAULT_CAPACITY)) {
+                // a full cache recycles the oldest set of the same layout, it only needs a rewrite
+                entry.set = entries.back().set;
+                index.erase(entries.back().key);
+                entries.pop_back();
+            } else {
+                if (entries.size() >= capacity.value_or(DEFAULT_CAPACITY)) {
+                    if (!evictable()) {
+                        throw std::runtime_error(CALL_INFO + ": every cached set is still in flight, 'capacity' is too small");
+                    }
+                    evict();
+                }
+
+                VULKAN_HPP_NAMESPACE::DescriptorSetAllocateInfo allocateInfo = VULKAN_HPP_NAMESPACE::DescriptorSetAllocateInfo()
+                .setDescriptorPool(*pool.target)
+                .setSetLayouts(layout);
+
+                while (!entry.set) {
+                    try {
+                        VULKAN_HPP_NAMESPACE::raii::DescriptorSets sets(device, allocateInfo);
+                        // the cache owns the set, it is freed on eviction or with the pool
+                        entry.set = sets.front().release();
+                    } catch (const VULKAN_HPP_NAMESPACE::OutOfPoolMemoryError&) {
+                        if (!evictable()) {
+                            throw;
+                        }
+                        evict();
+                    } catch (const VULKAN_HPP_NAMESPACE::FragmentedPoolError&) {
+                        if (!evictable()) {
+                            throw;
+                        }
+                        evict();
+                    }
+                }
+            }
+
+            std::vector<VULKAN_HPP_NAMESPACE::WriteDescriptorSet> values = writes;
+            for (VULKAN_HPP_NAMESPACE::WriteDescriptorSet& value : values) {
+                value.dstSet = entry.set;
+            }
+            device.updateDescriptorSets(values, nullptr);
+
+            entries.emplace_front(std::move(entry));
+            index.emplace(entries.front().key, entries.begin());
+
+            return entries.front().set;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorSetCache::erase(uint64_t handle) {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            // the sets may still be in flight, so they only leave the index and the eviction path frees them
+            for (Entry& entry : entries) {
+                if (entry.key.empty() || std::find(entry.key.begin(), entry.key.end(), handle) == entry.key.end()) {
+                    continue;
+                }
+                index.erase(entry.key);
+                entry.key.clear();
+                entry.layout = nullptr;
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorSetCache::nextFrame() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            frame++;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE size_t DescriptorSetCache::size() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            return entries.size();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorSetCache::clear() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            sizes.clear();
+            capacity.reset();
+            frameCount.reset();
+            frame = 0;
+            index.clear();
+            entries.clear();
+            pool.clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorSetCache::clearAndRelease() {
+        try {
+            pool.clearAndRelease();
+            clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorSetCache::Builder::Builder(DescriptorSetCache& object): object(object) {
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorSetCache::Builder& DescriptorSetCache::Builder::setSizes(const std::vector<VULKAN_HPP_NAMESPACE::DescriptorPoolSize>& value) {
+        object.sizes = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorSetCache::Builder& DescriptorSetCache::Builder::addSize(const VULKAN_HPP_NAMESPACE::DescriptorPoolSize& value) {
+        object.sizes.emplace_back(value);
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorSetCache::Builder& DescriptorSetCache::Builder::setCapacity(uint32_t value) {
+        object.capacity = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorSetCache::Builder& DescriptorSetCache::Builder::setFrameCount(uint32_t value) {
+        object.frameCount = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorSetCache& DescriptorSetCache::Builder::build(
+        VULKAN_HPP_NAMESPACE::raii::Device& device
+    ) {
+        try {
+            if (object.sizes.empty()) {
+                throw std::runtime_error(CALL_INFO + ": 'sizes' is empty");
+            }
+
+            if (!object.capacity.has_value()) {
+                object.capacity = DEFAULT_CAPACITY;
+            }
+
+            // same default as 'DeferredRelease'
+            if (!object.frameCount.has_value()) {
+                object.frameCount = 2;
+            }
+
+            if (object.frameCount.value() == 0) {
+                throw std::runtime_error(CALL_INFO + ": 'frameCount' is zero");
+            }
+
+            // cached sets die with the old pool
+            object.index.clear();
+            object.entries.clear();
+            object.frame = 0;
+            object.pool.clear();
+
+            DescriptorPool::Builder poolBuilder = DescriptorPool::builder(object.pool);
+
+            for (const VULKAN_HPP_NAMESPACE::DescriptorPoolSize& value : object.sizes) {
+                poolBuilder.addSize(VULKAN_HPP_NAMESPACE::DescriptorPoolSize(value.type, value.descriptorCount * object.capacity.value()));
+            }
+
+            poolBuilder
+            .setCreateInfo(
+                VULKAN_HPP_NAMESPACE::DescriptorPoolCreateInfo()
+                .setFlags(VULKAN_HPP_NAMESPACE::DescriptorPoolCreateFlagBits::eFreeDescriptorSet)
+                .setMaxSets(object.capacity.value())
+            )
+            .build(device);
+
+            return object;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
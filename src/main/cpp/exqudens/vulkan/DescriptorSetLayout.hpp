@@ -14,6 +14,8 @@ namespace exqudens::vulkan {
         class Builder;
 
         std::vector<VULKAN_HPP_NAMESPACE::DescriptorSetLayoutBinding> bindings = {};
+        std::vector<VULKAN_HPP_NAMESPACE::DescriptorBindingFlags> bindingFlags = {};
+        std::optional<VULKAN_HPP_NAMESPACE::DescriptorSetLayoutBindingFlagsCreateInfo> bindingFlagsCreateInfo = {};
         std::optional<VULKAN_HPP_NAMESPACE::DescriptorSetLayoutCreateInfo> createInfo = {};
         VULKAN_HPP_NAMESPACE::raii::DescriptorSetLayout target = nullptr;
 
@@ -39,6 +41,10 @@ namespace exqudens::vulkan {
 
             Builder& addBinding(const VULKAN_HPP_NAMESPACE::DescriptorSetLayoutBinding& value);
 
+            Builder& setBindingFlags(const std::vector<VULKAN_HPP_NAMESPACE::DescriptorBindingFlags>& value);
+
+            Builder& addBindingFlags(const VULKAN_HPP_NAMESPACE::DescriptorBindingFlags& value);
+
             Builder& setCreateInfo(const VULKAN_HPP_NAMESPACE::DescriptorSetLayoutCreateInfo& value);
 
             DescriptorSetLayout& build(
@@ -66,6 +72,8 @@ namespace exqudens::vulkan {
     EXQUDENS_VULKAN_INLINE void DescriptorSetLayout::clear() {
         try {
             bindings.clear();
+            bindingFlags.clear();
+            bindingFlagsCreateInfo.reset();
             createInfo.reset();
             target.clear();
         } catch (...) {
@@ -95,6 +103,16 @@ namespace exqudens::vulkan {
         return *this;
     }
 
+    EXQUDENS_VULKAN_INLINE DescriptorSetLayout::Builder& DescriptorSetLayout::Builder::setBindingFlags(const std::vector<VULKAN_HPP_NAMESPACE::DescriptorBindingFlags>& value) {
+        object.bindingFlags = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorSetLayout::Builder& DescriptorSetLayout::Builder::addBindingFlags(const VULKAN_HPP_NAMESPACE::DescriptorBindingFlags& value) {
+        object.bindingFlags.emplace_back(value);
+        return *this;
+    }
+
     EXQUDENS_VULKAN_INLINE DescriptorSetLayout::Builder& DescriptorSetLayout::Builder::setCreateInfo(const VULKAN_HPP_NAMESPACE::DescriptorSetLayoutCreateInfo& value) {
         object.createInfo = value;
         return *this;
@@ -111,6 +129,15 @@ namespace exqudens::vulkan {
             object.createInfo.value().bindingCount = static_cast<uint32_t>(object.bindings.size());
             object.createInfo.value().pBindings = object.bindings.empty() ? nullptr : object.bindings.data();
 
+            // flags are per binding, in the same order as 'bindings'
+            if (!object.bindingFlags.empty()) {
+                if (object.bindingFlags.size() != object.bindings.size()) {
+                    throw std::runtime_error(CALL_INFO + ": 'bindingFlags' size does not match 'bindings' size");
+                }
+                object.bindingFlagsCreateInfo = VULKAN_HPP_NAMESPACE::DescriptorSetLayoutBindingFlagsCreateInfo().setBindingFlags(object.bindingFlags);
+                object.createInfo.value().pNext = &object.bindingFlagsCreateInfo.value();
+            }
+
             object.target = device.createDescriptorSetLayout(object.createInfo.value());
 
             return object;
@@ -0,0 +1,379 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <type_traits>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "exqudens/vulkan/export.hpp"
+#include "exqudens/vulkan/DescriptorSetLayout.hpp"
+
+namespace exqudens::vulkan {
+
+    struct EXQUDENS_VULKAN_EXPORT DescriptorUpdateTemplate {
+
+        class Builder;
+
+        std::vector<VULKAN_HPP_NAMESPACE::DescriptorSetLayoutBinding> bindings = {};
+        std::vector<VULKAN_HPP_NAMESPACE::DescriptorUpdateTemplateEntry> entries = {};
+        size_t dataSize = 0;
+        VULKAN_HPP_NAMESPACE::DescriptorSetLayout descriptorSetLayout = {};
+        std::optional<VULKAN_HPP_NAMESPACE::PipelineBindPoint> pipelineBindPoint = {};
+        VULKAN_HPP_NAMESPACE::PipelineLayout pipelineLayout = {};
+        uint32_t set = 0;
+        std::optional<VULKAN_HPP_NAMESPACE::DescriptorUpdateTemplateCreateInfo> createInfo = {};
+        VULKAN_HPP_NAMESPACE::raii::DescriptorUpdateTemplate target = nullptr;
+
+        static bool isPushDescriptorSupported(VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice);
+
+        static size_t infoSizeFrom(const VULKAN_HPP_NAMESPACE::DescriptorType& type);
+
+        static std::vector<VULKAN_HPP_NAMESPACE::DescriptorUpdateTemplateEntry> entriesFrom(
+            const std::vector<VULKAN_HPP_NAMESPACE::DescriptorSetLayoutBinding>& bindings,
+            size_t* dataSize = nullptr
+        );
+
+        static void push(
+            VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer,
+            const VULKAN_HPP_NAMESPACE::PipelineBindPoint& bindPoint,
+            const VULKAN_HPP_NAMESPACE::PipelineLayout& layout,
+            uint32_t set,
+            const std::vector<VULKAN_HPP_NAMESPACE::WriteDescriptorSet>& writes
+        );
+
+        static Builder builder(DescriptorUpdateTemplate& object);
+
+        // 'T' is a packed struct of descriptor infos laid out as 'entries'
+        template<typename T>
+        void update(VULKAN_HPP_NAMESPACE::raii::Device& device, const VULKAN_HPP_NAMESPACE::DescriptorSet& descriptorSet, const T& data) const {
+            static_assert(std::is_trivially_copyable_v<T>);
+            update(device, descriptorSet, static_cast<const void*>(&data), sizeof(T));
+        }
+
+        template<typename T>
+        void push(VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer, const T& data) const {
+            static_assert(std::is_trivially_copyable_v<T>);
+            push(commandBuffer, static_cast<const void*>(&data), sizeof(T));
+        }
+
+        void update(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            const VULKAN_HPP_NAMESPACE::DescriptorSet& descriptorSet,
+            const void* data,
+            size_t size
+        ) const;
+
+        void push(
+            VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer,
+            const void* data,
+            size_t size
+        ) const;
+
+        void clear();
+
+        void clearAndRelease();
+
+    };
+
+    class EXQUDENS_VULKAN_EXPORT DescriptorUpdateTemplate::Builder {
+
+        private:
+
+            DescriptorUpdateTemplate& object;
+
+        public:
+
+            explicit Builder(DescriptorUpdateTemplate& object);
+
+            Builder& setBindings(const std::vector<VULKAN_HPP_NAMESPACE::DescriptorSetLayoutBinding>& value);
+
+            Builder& addBinding(const VULKAN_HPP_NAMESPACE::DescriptorSetLayoutBinding& value);
+
+            Builder& setLayout(const DescriptorSetLayout& value);
+
+            Builder& setEntries(const std::vector<VULKAN_HPP_NAMESPACE::DescriptorUpdateTemplateEntry>& value, size_t dataSize);
+
+            Builder& setPushDescriptor(
+                const VULKAN_HPP_NAMESPACE::PipelineBindPoint& bindPoint,
+                const VULKAN_HPP_NAMESPACE::PipelineLayout& layout,
+                uint32_t set
+            );
+
+            Builder& setCreateInfo(const VULKAN_HPP_NAMESPACE::DescriptorUpdateTemplateCreateInfo& value);
+
+            DescriptorUpdateTemplate& build(
+                VULKAN_HPP_NAMESPACE::raii::Device& device
+            );
+
+    };
+
+}
+
+// implementation ---
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <filesystem>
+#include <stdexcept>
+
+#define CALL_INFO std::string(__FUNCTION__) + " (" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::vulkan {
+
+    EXQUDENS_VULKAN_INLINE bool DescriptorUpdateTemplate::isPushDescriptorSupported(VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice) {
+        try {
+            std::vector<VULKAN_HPP_NAMESPACE::ExtensionProperties> properties = physicalDevice.enumerateDeviceExtensionProperties();
+            return std::any_of(properties.begin(), properties.end(), [](const VULKAN_HPP_NAMESPACE::ExtensionProperties& value) {
+                return std::strcmp(value.extensionName, VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME) == 0;
+            });
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE size_t DescriptorUpdateTemplate::infoSizeFrom(const VULKAN_HPP_NAMESPACE::DescriptorType& type) {
+        try {
+            switch (type) {
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eSampler:
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eCombinedImageSampler:
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eSampledImage:
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eStorageImage:
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eInputAttachment:
+                    return sizeof(VULKAN_HPP_NAMESPACE::DescriptorImageInfo);
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eUniformBuffer:
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eStorageBuffer:
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eUniformBufferDynamic:
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eStorageBufferDynamic:
+                    return sizeof(VULKAN_HPP_NAMESPACE::DescriptorBufferInfo);
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eUniformTexelBuffer:
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eStorageTexelBuffer:
+                    return sizeof(VULKAN_HPP_NAMESPACE::BufferView);
+                case VULKAN_HPP_NAMESPACE::DescriptorType::eAccelerationStructureKHR:
+                    return sizeof(VULKAN_HPP_NAMESPACE::AccelerationStructureKHR);
+                default:
+                    throw std::runtime_error(CALL_INFO + ": unsupported descriptor type");
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE std::vector<VULKAN_HPP_NAMESPACE::DescriptorUpdateTemplateEntry> DescriptorUpdateTemplate::entriesFrom(
+        const std::vector<VULKAN_HPP_NAMESPACE::DescriptorSetLayoutBinding>& bindings,
+        size_t* dataSize
+    ) {
+        try {
+            std::vector<VULKAN_HPP_NAMESPACE::DescriptorUpdateTemplateEntry> result = {};
+            size_t offset = 0;
+
+            // infos are packed back to back in binding order, every info is 8-byte aligned so it matches a plain struct
+            for (const VULKAN_HPP_NAMESPACE::DescriptorSetLayoutBinding& binding : bindings) {
+                if (binding.descriptorCount == 0) {
+                    continue;
+                }
+
+                size_t stride = infoSizeFrom(binding.descriptorType);
+
+                result.emplace_back(
+                    VULKAN_HPP_NAMESPACE::DescriptorUpdateTemplateEntry()
+                    .setDstBinding(binding.binding)
+                    .setDstArrayElement(0)
+                    .setDescriptorCount(binding.descriptorCount)
+                    .setDescriptorType(binding.descriptorType)
+                    .setOffset(offset)
+                    .setStride(stride)
+                );
+
+                offset += stride * binding.descriptorCount;
+            }
+
+            if (dataSize != nullptr) {
+                *dataSize = offset;
+            }
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorUpdateTemplate::push(
+        VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer,
+        const VULKAN_HPP_NAMESPACE::PipelineBindPoint& bindPoint,
+        const VULKAN_HPP_NAMESPACE::PipelineLayout& layout,
+        uint32_t set,
+        const std::vector<VULKAN_HPP_NAMESPACE::WriteDescriptorSet>& writes
+    ) {
+        try {
+            commandBuffer.pushDescriptorSetKHR(bindPoint, layout, set, writes);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorUpdateTemplate::Builder DescriptorUpdateTemplate::builder(DescriptorUpdateTemplate& object) {
+        return Builder(object);
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorUpdateTemplate::update(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        const VULKAN_HPP_NAMESPACE::DescriptorSet& descriptorSet,
+        const void* data,
+        size_t size
+    ) const {
+        try {
+            if (data == nullptr) {
+                throw std::runtime_error(CALL_INFO + ": 'data' is null");
+            }
+
+            if (size < dataSize) {
+                throw std::runtime_error(CALL_INFO + ": 'size' is less than 'dataSize'");
+            }
+
+            // the wrapper takes the data by reference and forwards its address
+            device.updateDescriptorSetWithTemplate(descriptorSet, *target, *static_cast<const uint8_t*>(data));
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorUpdateTemplate::push(
+        VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer,
+        const void* data,
+        size_t size
+    ) const {
+        try {
+            if (!pipelineBindPoint.has_value()) {
+                throw std::runtime_error(CALL_INFO + ": template is not built for push descriptors");
+            }
+
+            if (data == nullptr) {
+                throw std::runtime_error(CALL_INFO + ": 'data' is null");
+            }
+
+            if (size < dataSize) {
+                throw std::runtime_error(CALL_INFO + ": 'size' is less than 'dataSize'");
+            }
+
+            commandBuffer.pushDescriptorSetWithTemplateKHR(*target, pipelineLayout, set, *static_cast<const uint8_t*>(data));
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorUpdateTemplate::clear() {
+        try {
+            bindings.clear();
+            entries.clear();
+            dataSize = 0;
+            descriptorSetLayout = VULKAN_HPP_NAMESPACE::DescriptorSetLayout();
+            pipelineBindPoint.reset();
+            pipelineLayout = VULKAN_HPP_NAMESPACE::PipelineLayout();
+            set = 0;
+            createInfo.reset();
+            target.clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DescriptorUpdateTemplate::clearAndRelease() {
+        try {
+            target.release();
+            clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorUpdateTemplate::Builder::Builder(DescriptorUpdateTemplate& object): object(object) {
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorUpdateTemplate::Builder& DescriptorUpdateTemplate::Builder::setBindings(const std::vector<VULKAN_HPP_NAMESPACE::DescriptorSetLayoutBinding>& value) {
+        object.bindings = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorUpdateTemplate::Builder& DescriptorUpdateTemplate::Builder::addBinding(const VULKAN_HPP_NAMESPACE::DescriptorSetLayoutBinding& value) {
+        object.bindings.emplace_back(value);
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorUpdateTemplate::Builder& DescriptorUpdateTemplate::Builder::setLayout(const DescriptorSetLayout& value) {
+        object.bindings = value.bindings;
+        object.descriptorSetLayout = *value.target;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorUpdateTemplate::Builder& DescriptorUpdateTemplate::Builder::setEntries(const std::vector<VULKAN_HPP_NAMESPACE::DescriptorUpdateTemplateEntry>& value, size_t dataSize) {
+        object.entries = value;
+        object.dataSize = dataSize;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorUpdateTemplate::Builder& DescriptorUpdateTemplate::Builder::setPushDescriptor(
+        const VULKAN_HPP_NAMESPACE::PipelineBindPoint& bindPoint,
+        const VULKAN_HPP_NAMESPACE::PipelineLayout& layout,
+        uint32_t set
+    ) {
+        object.pipelineBindPoint = bindPoint;
+        object.pipelineLayout = layout;
+        object.set = set;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorUpdateTemplate::Builder& DescriptorUpdateTemplate::Builder::setCreateInfo(const VULKAN_HPP_NAMESPACE::DescriptorUpdateTemplateCreateInfo& value) {
+        object.createInfo = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorUpdateTemplate& DescriptorUpdateTemplate::Builder::build(
+        VULKAN_HPP_NAMESPACE::raii::Device& device
+    ) {
+        try {
+            // entries set explicitly win over the ones generated from the bindings
+            if (object.entries.empty()) {
+                object.entries = DescriptorUpdateTemplate::entriesFrom(object.bindings, &object.dataSize);
+            }
+
+            if (object.entries.empty()) {
+                throw std::runtime_error(CALL_INFO + ": 'entries' is empty");
+            }
+
+            if (!object.createInfo.has_value()) {
+                object.createInfo = VULKAN_HPP_NAMESPACE::DescriptorUpdateTemplateCreateInfo();
+            }
+
+            object.createInfo.value().setDescriptorUpdateEntries(object.entries);
+
+            if (object.pipelineBindPoint.has_value()) {
+                // the layout must be created with 'ePushDescriptorKHR'
+                object.createInfo.value()
+                .setTemplateType(VULKAN_HPP_NAMESPACE::DescriptorUpdateTemplateType::ePushDescriptorsKHR)
+                .setPipelineBindPoint(object.pipelineBindPoint.value())
+                .setPipelineLayout(object.pipelineLayout)
+                .setSet(object.set);
+            } else {
+                if (!object.descriptorSetLayout) {
+                    throw std::runtime_error(CALL_INFO + ": 'descriptorSetLayout' is not initialized");
+                }
+
+                object.createInfo.value()
+                .setTemplateType(VULKAN_HPP_NAMESPACE::DescriptorUpdateTemplateType::eDescriptorSet)
+                .setDescriptorSetLayout(object.descriptorSetLayout);
+            }
+
+            object.target = device.createDescriptorUpdateTemplate(object.createInfo.value());
+
+            return object;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <optional>
 
 #include <vulkan/vulkan_raii.hpp>
@@ -13,12 +14,47 @@ namespace exqudens::vulkan {
         class Builder;
 
         std::optional<VULKAN_HPP_NAMESPACE::MemoryAllocateInfo> allocateInfo = {};
+        std::optional<VULKAN_HPP_NAMESPACE::MemoryAllocateFlagsInfo> allocateFlagsInfo = {};
+        std::optional<VULKAN_HPP_NAMESPACE::MemoryPropertyFlags> propertyFlags = {};
+        std::optional<VULKAN_HPP_NAMESPACE::DeviceSize> nonCoherentAtomSize = {};
+        bool persistentMap = false;
+        void* mappedData = nullptr;
         VULKAN_HPP_NAMESPACE::raii::DeviceMemory target = nullptr;
 
+        static VULKAN_HPP_NAMESPACE::PhysicalDeviceMemoryProperties memoryPropertiesFrom(
+            VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice
+        );
+
+        static std::optional<uint32_t> memoryTypeIndexFrom(
+            const VULKAN_HPP_NAMESPACE::PhysicalDeviceMemoryProperties& memoryProperties,
+            uint32_t memoryTypeBits,
+            const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& flags,
+            const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& preferredFlags = {},
+            const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& avoidedFlags = {}
+        );
+
+        static VULKAN_HPP_NAMESPACE::MemoryAllocateInfo allocateInfoFrom(
+            VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice,
+            const VULKAN_HPP_NAMESPACE::MemoryRequirements& memoryRequirements,
+            const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& flags,
+            const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& preferredFlags = {},
+            const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& avoidedFlags = {}
+        );
+
         static VULKAN_HPP_NAMESPACE::MemoryAllocateInfo allocateInfoFrom(
             VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice,
             VULKAN_HPP_NAMESPACE::raii::Buffer& buffer,
-            const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& flags
+            const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& flags,
+            const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& preferredFlags = {},
+            const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& avoidedFlags = {}
+        );
+
+        static VULKAN_HPP_NAMESPACE::MemoryAllocateInfo allocateInfoFrom(
+            VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice,
+            VULKAN_HPP_NAMESPACE::raii::Image& image,
+            const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& flags,
+            const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& preferredFlags = {},
+            const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& avoidedFlags = {}
         );
 
         static Builder builder(DeviceMemory& object);
@@ -30,6 +66,21 @@ namespace exqudens::vulkan {
             std::optional<VULKAN_HPP_NAMESPACE::MemoryMapFlags> flags = {}
         );
 
+        VULKAN_HPP_NAMESPACE::MappedMemoryRange mappedMemoryRangeFrom(
+            std::optional<VULKAN_HPP_NAMESPACE::DeviceSize> offset = {},
+            std::optional<VULKAN_HPP_NAMESPACE::DeviceSize> size = {}
+        );
+
+        void flush(
+            std::optional<VULKAN_HPP_NAMESPACE::DeviceSize> offset = {},
+            std::optional<VULKAN_HPP_NAMESPACE::DeviceSize> size = {}
+        );
+
+        void invalidate(
+            std::optional<VULKAN_HPP_NAMESPACE::DeviceSize> offset = {},
+            std::optional<VULKAN_HPP_NAMESPACE::DeviceSize> size = {}
+        );
+
         void clear();
 
         void clearAndRelease();
@@ -48,6 +99,19 @@ namespace exqudens::vulkan {
 
             Builder& setAllocateInfo(const VULKAN_HPP_NAMESPACE::MemoryAllocateInfo& value);
 
+            Builder& setAllocateFlagsInfo(const VULKAN_HPP_NAMESPACE::MemoryAllocateFlagsInfo& value);
+
+            Builder& setPropertyFlags(const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& value);
+
+            Builder& setNonCoherentAtomSize(const VULKAN_HPP_NAMESPACE::DeviceSize& value);
+
+            Builder& setPersistentMap(bool value);
+
+            DeviceMemory& build(
+                VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice,
+                VULKAN_HPP_NAMESPACE::raii::Device& device
+            );
+
             DeviceMemory& build(
                 VULKAN_HPP_NAMESPACE::raii::Device& device
             );
@@ -59,6 +123,7 @@ namespace exqudens::vulkan {
 // implementation ---
 
 #include <cstring>
+#include <bit>
 #include <string>
 #include <filesystem>
 #include <stdexcept>
@@ -67,28 +132,113 @@ namespace exqudens::vulkan {
 
 namespace exqudens::vulkan {
 
-    EXQUDENS_VULKAN_INLINE VULKAN_HPP_NAMESPACE::MemoryAllocateInfo DeviceMemory::allocateInfoFrom(
-        VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice,
-        VULKAN_HPP_NAMESPACE::raii::Buffer& buffer,
-        const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& flags
+    EXQUDENS_VULKAN_INLINE VULKAN_HPP_NAMESPACE::PhysicalDeviceMemoryProperties DeviceMemory::memoryPropertiesFrom(
+        VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice
+    ) {
+        try {
+            // callers that allocate often keep the result, e.g. 'MemoryArena::memoryProperties'
+            return physicalDevice.getMemoryProperties();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE std::optional<uint32_t> DeviceMemory::memoryTypeIndexFrom(
+        const VULKAN_HPP_NAMESPACE::PhysicalDeviceMemoryProperties& memoryProperties,
+        uint32_t memoryTypeBits,
+        const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& flags,
+        const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& preferredFlags,
+        const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& avoidedFlags
     ) {
         try {
-            VULKAN_HPP_NAMESPACE::PhysicalDeviceMemoryProperties physicalDeviceMemoryProperties = physicalDevice.getMemoryProperties();
-            VULKAN_HPP_NAMESPACE::MemoryRequirements memoryRequirements = buffer.getMemoryRequirements();
+            std::optional<uint32_t> result = {};
+            int bestAvoided = 0;
+            int bestPreferred = 0;
+            int bestExtra = 0;
+
+            // fewest avoided flags wins, then most preferred flags, then fewest flags nobody asked for
+            for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+                VULKAN_HPP_NAMESPACE::MemoryPropertyFlags propertyFlags = memoryProperties.memoryTypes.at(i).propertyFlags;
+
+                if (!(memoryTypeBits & (1u << i)) || (propertyFlags & flags) != flags) {
+                    continue;
+                }
+
+                int avoided = std::popcount(static_cast<uint32_t>(propertyFlags & avoidedFlags));
+                int preferred = std::popcount(static_cast<uint32_t>(propertyFlags & preferredFlags));
+                int extra = std::popcount(static_cast<uint32_t>(propertyFlags & ~(flags | preferredFlags)));
 
-            for (uint32_t i = 0; i < physicalDeviceMemoryProperties.memoryTypeCount; i++) {
                 if (
-                    (memoryRequirements.memoryTypeBits & (1 << i))
-                    && (physicalDeviceMemoryProperties.memoryTypes.at(i).propertyFlags & flags) == flags
+                    !result.has_value()
+                    || avoided < bestAvoided
+                    || (avoided == bestAvoided && preferred > bestPreferred)
+                    || (avoided == bestAvoided && preferred == bestPreferred && extra < bestExtra)
                 ) {
-                    VULKAN_HPP_NAMESPACE::MemoryAllocateInfo result;
-                    result.allocationSize = memoryRequirements.size;
-                    result.memoryTypeIndex = i;
-                    return result;
+                    result = i;
+                    bestAvoided = avoided;
+                    bestPreferred = preferred;
+                    bestExtra = extra;
                 }
             }
 
-            throw std::runtime_error(CALL_INFO + ": failed to find suitable memory type!");
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE VULKAN_HPP_NAMESPACE::MemoryAllocateInfo DeviceMemory::allocateInfoFrom(
+        VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice,
+        const VULKAN_HPP_NAMESPACE::MemoryRequirements& memoryRequirements,
+        const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& flags,
+        const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& preferredFlags,
+        const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& avoidedFlags
+    ) {
+        try {
+            std::optional<uint32_t> memoryTypeIndex = memoryTypeIndexFrom(
+                memoryPropertiesFrom(physicalDevice),
+                memoryRequirements.memoryTypeBits,
+                flags,
+                preferredFlags,
+                avoidedFlags
+            );
+
+            if (!memoryTypeIndex.has_value()) {
+                throw std::runtime_error(CALL_INFO + ": failed to find suitable memory type!");
+            }
+
+            VULKAN_HPP_NAMESPACE::MemoryAllocateInfo result;
+            result.allocationSize = memoryRequirements.size;
+            result.memoryTypeIndex = memoryTypeIndex.value();
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE VULKAN_HPP_NAMESPACE::MemoryAllocateInfo DeviceMemory::allocateInfoFrom(
+        VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice,
+        VULKAN_HPP_NAMESPACE::raii::Buffer& buffer,
+        const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& flags,
+        const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& preferredFlags,
+        const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& avoidedFlags
+    ) {
+        try {
+            return allocateInfoFrom(physicalDevice, buffer.getMemoryRequirements(), flags, preferredFlags, avoidedFlags);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE VULKAN_HPP_NAMESPACE::MemoryAllocateInfo DeviceMemory::allocateInfoFrom(
+        VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice,
+        VULKAN_HPP_NAMESPACE::raii::Image& image,
+        const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& flags,
+        const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& preferredFlags,
+        const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& avoidedFlags
+    ) {
+        try {
+            return allocateInfoFrom(physicalDevice, image.getMemoryRequirements(), flags, preferredFlags, avoidedFlags);
         } catch (...) {
             std::throw_with_nested(std::runtime_error(CALL_INFO));
         }
@@ -117,17 +267,107 @@ namespace exqudens::vulkan {
                 flags = VULKAN_HPP_NAMESPACE::MemoryMapFlags();
             }
 
-            void* tmpData = target.mapMemory(offset.value(), size.value(), flags.value());
-            std::memcpy(tmpData, data, size.value());
+            if (mappedData != nullptr) {
+                std::memcpy(static_cast<char*>(mappedData) + offset.value(), data, size.value());
+                flush(offset, size);
+                return;
+            }
+
+            if (propertyFlags.has_value() && (propertyFlags.value() & VULKAN_HPP_NAMESPACE::MemoryPropertyFlagBits::eHostCoherent)) {
+                void* tmpData = target.mapMemory(offset.value(), size.value(), flags.value());
+                std::memcpy(tmpData, data, size.value());
+                target.unmapMemory();
+                return;
+            }
+
+            // the flushed range is widened to whole atoms, so the mapping has to cover it too
+            VULKAN_HPP_NAMESPACE::MappedMemoryRange range = mappedMemoryRangeFrom(offset, size);
+            void* tmpData = target.mapMemory(range.offset, range.size, flags.value());
+            std::memcpy(static_cast<char*>(tmpData) + (offset.value() - range.offset), data, size.value());
+            flush(offset, size);
             target.unmapMemory();
         } catch (...) {
             std::throw_with_nested(std::runtime_error(CALL_INFO));
         }
     }
 
+    EXQUDENS_VULKAN_INLINE VULKAN_HPP_NAMESPACE::MappedMemoryRange DeviceMemory::mappedMemoryRangeFrom(
+        std::optional<VULKAN_HPP_NAMESPACE::DeviceSize> offset,
+        std::optional<VULKAN_HPP_NAMESPACE::DeviceSize> size
+    ) {
+        try {
+            VULKAN_HPP_NAMESPACE::MappedMemoryRange result;
+            result.memory = *target;
+            result.offset = 0;
+            result.size = VK_WHOLE_SIZE;
+
+            if (!nonCoherentAtomSize.has_value() || nonCoherentAtomSize.value() == 0) {
+                return result;
+            }
+
+            if (!offset.has_value()) {
+                offset = 0;
+            }
+
+            if (!size.has_value() || size.value() == VK_WHOLE_SIZE) {
+                size = allocateInfo.value().allocationSize - offset.value();
+            }
+
+            VULKAN_HPP_NAMESPACE::DeviceSize atomSize = nonCoherentAtomSize.value();
+            VULKAN_HPP_NAMESPACE::DeviceSize begin = (offset.value() / atomSize) * atomSize;
+            VULKAN_HPP_NAMESPACE::DeviceSize end = ((offset.value() + size.value() + atomSize - 1) / atomSize) * atomSize;
+
+            result.offset = begin;
+            result.size = end >= allocateInfo.value().allocationSize ? VK_WHOLE_SIZE : end - begin;
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DeviceMemory::flush(
+        std::optional<VULKAN_HPP_NAMESPACE::DeviceSize> offset,
+        std::optional<VULKAN_HPP_NAMESPACE::DeviceSize> size
+    ) {
+        try {
+            if (propertyFlags.has_value() && (propertyFlags.value() & VULKAN_HPP_NAMESPACE::MemoryPropertyFlagBits::eHostCoherent)) {
+                return;
+            }
+
+            VULKAN_HPP_NAMESPACE::Device(target.getDevice()).flushMappedMemoryRanges(mappedMemoryRangeFrom(offset, size), *target.getDispatcher());
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void DeviceMemory::invalidate(
+        std::optional<VULKAN_HPP_NAMESPACE::DeviceSize> offset,
+        std::optional<VULKAN_HPP_NAMESPACE::DeviceSize> size
+    ) {
+        try {
+            if (propertyFlags.has_value() && (propertyFlags.value() & VULKAN_HPP_NAMESPACE::MemoryPropertyFlagBits::eHostCoherent)) {
+                return;
+            }
+
+            VULKAN_HPP_NAMESPACE::Device(target.getDevice()).invalidateMappedMemoryRanges(mappedMemoryRangeFrom(offset, size), *target.getDispatcher());
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
     EXQUDENS_VULKAN_INLINE void DeviceMemory::clear() {
         try {
+            // a target handed off elsewhere is unmapped when it is freed
+            if (mappedData != nullptr && *target) {
+                target.unmapMemory();
+            }
+            mappedData = nullptr;
             allocateInfo.reset();
+            allocateFlagsInfo.reset();
+            propertyFlags.reset();
+            nonCoherentAtomSize.reset();
+            persistentMap = false;
             target.clear();
         } catch (...) {
             std::throw_with_nested(std::runtime_error(CALL_INFO));
@@ -151,6 +391,49 @@ namespace exqudens::vulkan {
         return *this;
     }
 
+    EXQUDENS_VULKAN_INLINE DeviceMemory::Builder& DeviceMemory::Builder::setAllocateFlagsInfo(const VULKAN_HPP_NAMESPACE::MemoryAllocateFlagsInfo& value) {
+        object.allocateFlagsInfo = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DeviceMemory::Builder& DeviceMemory::Builder::setPropertyFlags(const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& value) {
+        object.propertyFlags = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DeviceMemory::Builder& DeviceMemory::Builder::setNonCoherentAtomSize(const VULKAN_HPP_NAMESPACE::DeviceSize& value) {
+        object.nonCoherentAtomSize = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DeviceMemory::Builder& DeviceMemory::Builder::setPersistentMap(bool value) {
+        object.persistentMap = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE DeviceMemory& DeviceMemory::Builder::build(
+        VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice,
+        VULKAN_HPP_NAMESPACE::raii::Device& device
+    ) {
+        try {
+            if (!object.allocateInfo.has_value()) {
+                object.allocateInfo = VULKAN_HPP_NAMESPACE::MemoryAllocateInfo();
+            }
+
+            if (!object.propertyFlags.has_value()) {
+                object.propertyFlags = memoryPropertiesFrom(physicalDevice).memoryTypes.at(object.allocateInfo.value().memoryTypeIndex).propertyFlags;
+            }
+
+            if (!object.nonCoherentAtomSize.has_value()) {
+                object.nonCoherentAtomSize = physicalDevice.getProperties().limits.nonCoherentAtomSize;
+            }
+
+            return build(device);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
     EXQUDENS_VULKAN_INLINE DeviceMemory& DeviceMemory::Builder::build(
         VULKAN_HPP_NAMESPACE::raii::Device& device
     ) {
@@ -159,8 +442,17 @@ namespace exqudens::vulkan {
                 object.allocateInfo = VULKAN_HPP_NAMESPACE::MemoryAllocateInfo();
             }
 
+            // e.g. 'eDeviceAddress' for buffers read through their device address
+            if (object.allocateFlagsInfo.has_value()) {
+                object.allocateInfo.value().pNext = &object.allocateFlagsInfo.value();
+            }
+
             object.target = device.allocateMemory(object.allocateInfo.value());
 
+            if (object.persistentMap) {
+                object.mappedData = object.target.mapMemory(0, VK_WHOLE_SIZE);
+            }
+
             return object;
         } catch (...) {
             std::throw_with_nested(std::runtime_error(CALL_INFO));
@@ -0,0 +1,396 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "exqudens/vulkan/export.hpp"
+#include "exqudens/vulkan/Pipeline.hpp"
+
+namespace exqudens::vulkan {
+
+    struct EXQUDENS_VULKAN_EXPORT ExtendedDynamicState {
+
+        class Builder;
+
+        // values a draw needs, recorded as commands when dynamic and baked into the pipeline otherwise
+        struct State {
+            std::optional<VULKAN_HPP_NAMESPACE::CullModeFlags> cullMode = {};
+            std::optional<VULKAN_HPP_NAMESPACE::FrontFace> frontFace = {};
+            std::optional<VULKAN_HPP_NAMESPACE::PrimitiveTopology> primitiveTopology = {};
+            std::optional<bool> depthTestEnable = {};
+            std::optional<bool> depthWriteEnable = {};
+            std::optional<VULKAN_HPP_NAMESPACE::CompareOp> depthCompareOp = {};
+            std::optional<bool> depthBoundsTestEnable = {};
+            std::optional<bool> stencilTestEnable = {};
+            std::optional<bool> rasterizerDiscardEnable = {};
+            std::optional<bool> depthBiasEnable = {};
+            std::optional<bool> primitiveRestartEnable = {};
+            std::optional<VULKAN_HPP_NAMESPACE::PolygonMode> polygonMode = {};
+            std::vector<VULKAN_HPP_NAMESPACE::Bool32> colorBlendEnables = {};
+            std::vector<VULKAN_HPP_NAMESPACE::ColorComponentFlags> colorWriteMasks = {};
+        };
+
+        bool enabled = false;
+        bool extendedDynamicState = false;
+        bool extendedDynamicState2 = false;
+        bool extendedDynamicState3PolygonMode = false;
+        bool extendedDynamicState3ColorBlendEnable = false;
+        bool extendedDynamicState3ColorWriteMask = false;
+        std::vector<const char*> extensions = {};
+        std::optional<VULKAN_HPP_NAMESPACE::PhysicalDeviceExtendedDynamicStateFeaturesEXT> features = {};
+        std::optional<VULKAN_HPP_NAMESPACE::PhysicalDeviceExtendedDynamicState2FeaturesEXT> features2 = {};
+        std::optional<VULKAN_HPP_NAMESPACE::PhysicalDeviceExtendedDynamicState3FeaturesEXT> features3 = {};
+
+        static Builder builder(ExtendedDynamicState& object);
+
+        std::vector<VULKAN_HPP_NAMESPACE::DynamicState> dynamicStates() const;
+
+        const void* link(const void* next = nullptr);
+
+        void apply(Pipeline& pipeline, const State& state) const;
+
+        // 'pipeline' is the description passed to 'apply()', unset fields fall back to the values baked into it
+        void record(VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer, const Pipeline& pipeline, const State& state) const;
+
+        void clear();
+
+        void clearAndRelease();
+
+    };
+
+    class EXQUDENS_VULKAN_EXPORT ExtendedDynamicState::Builder {
+
+        private:
+
+            ExtendedDynamicState& object;
+
+        public:
+
+            explicit Builder(ExtendedDynamicState& object);
+
+            Builder& setEnabled(bool value);
+
+            ExtendedDynamicState& build(
+                VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice
+            );
+
+    };
+
+}
+
+// implementation ---
+
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <filesystem>
+#include <stdexcept>
+
+#define CALL_INFO std::string(__FUNCTION__) + " (" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::vulkan {
+
+    EXQUDENS_VULKAN_INLINE ExtendedDynamicState::Builder ExtendedDynamicState::builder(ExtendedDynamicState& object) {
+        return Builder(object);
+    }
+
+    EXQUDENS_VULKAN_INLINE std::vector<VULKAN_HPP_NAMESPACE::DynamicState> ExtendedDynamicState::dynamicStates() const {
+        try {
+            std::vector<VULKAN_HPP_NAMESPACE::DynamicState> result = {};
+
+            if (extendedDynamicState) {
+                result.insert(result.end(), {
+                    VULKAN_HPP_NAMESPACE::DynamicState::eCullMode,
+                    VULKAN_HPP_NAMESPACE::DynamicState::eFrontFace,
+                    VULKAN_HPP_NAMESPACE::DynamicState::ePrimitiveTopology,
+                    VULKAN_HPP_NAMESPACE::DynamicState::eDepthTestEnable,
+                    VULKAN_HPP_NAMESPACE::DynamicState::eDepthWriteEnable,
+                    VULKAN_HPP_NAMESPACE::DynamicState::eDepthCompareOp,
+                    VULKAN_HPP_NAMESPACE::DynamicState::eDepthBoundsTestEnable,
+                    VULKAN_HPP_NAMESPACE::DynamicState::eStencilTestEnable
+                });
+            }
+
+            if (extendedDynamicState2) {
+                result.insert(result.end(), {
+                    VULKAN_HPP_NAMESPACE::DynamicState::eRasterizerDiscardEnable,
+                    VULKAN_HPP_NAMESPACE::DynamicState::eDepthBiasEnable,
+                    VULKAN_HPP_NAMESPACE::DynamicState::ePrimitiveRestartEnable
+                });
+            }
+
+            if (extendedDynamicState3PolygonMode) {
+                result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::ePolygonModeEXT);
+            }
+
+            if (extendedDynamicState3ColorBlendEnable) {
+                result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eColorBlendEnableEXT);
+            }
+
+            if (extendedDynamicState3ColorWriteMask) {
+                result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eColorWriteMaskEXT);
+            }
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE const void* ExtendedDynamicState::link(const void* next) {
+        try {
+            // device create info -> 3 -> 2 -> 1 -> next
+            if (features.has_value()) {
+                features.value().pNext = const_cast<void*>(next);
+                next = &features.value();
+            }
+            if (features2.has_value()) {
+                features2.value().pNext = const_cast<void*>(next);
+                next = &features2.value();
+            }
+            if (features3.has_value()) {
+                features3.value().pNext = const_cast<void*>(next);
+                next = &features3.value();
+            }
+            return next;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void ExtendedDynamicState::apply(Pipeline& pipeline, const State& state) const {
+        try {
+            // dynamic fields keep the pipeline defaults, so every permutation maps to the same key
+            for (VULKAN_HPP_NAMESPACE::DynamicState value : dynamicStates()) {
+                if (std::find(pipeline.dynamicStates.begin(), pipeline.dynamicStates.end(), value) == pipeline.dynamicStates.end()) {
+                    pipeline.dynamicStates.emplace_back(value);
+                }
+            }
+
+            if (!extendedDynamicState) {
+                if (state.cullMode.has_value() || state.frontFace.has_value()) {
+                    if (!pipeline.rasterizationStateCreateInfo.has_value()) {
+                        pipeline.rasterizationStateCreateInfo = VULKAN_HPP_NAMESPACE::PipelineRasterizationStateCreateInfo();
+                    }
+                    if (state.cullMode.has_value()) {
+                        pipeline.rasterizationStateCreateInfo.value().cullMode = state.cullMode.value();
+                    }
+                    if (state.frontFace.has_value()) {
+                        pipeline.rasterizationStateCreateInfo.value().frontFace = state.frontFace.value();
+                    }
+                }
+
+                if (state.primitiveTopology.has_value()) {
+                    if (!pipeline.inputAssemblyStateCreateInfo.has_value()) {
+                        pipeline.inputAssemblyStateCreateInfo = VULKAN_HPP_NAMESPACE::PipelineInputAssemblyStateCreateInfo();
+                    }
+                    pipeline.inputAssemblyStateCreateInfo.value().topology = state.primitiveTopology.value();
+                }
+
+                if (state.depthTestEnable.has_value() || state.depthWriteEnable.has_value() || state.depthCompareOp.has_value() || state.depthBoundsTestEnable.has_value() || state.stencilTestEnable.has_value()) {
+                    if (!pipeline.depthStencilStateCreateInfo.has_value()) {
+                        pipeline.depthStencilStateCreateInfo = VULKAN_HPP_NAMESPACE::PipelineDepthStencilStateCreateInfo();
+                    }
+                    VULKAN_HPP_NAMESPACE::PipelineDepthStencilStateCreateInfo& info = pipeline.depthStencilStateCreateInfo.value();
+                    info.depthTestEnable = state.depthTestEnable.value_or(info.depthTestEnable);
+                    info.depthWriteEnable = state.depthWriteEnable.value_or(info.depthWriteEnable);
+                    info.depthCompareOp = state.depthCompareOp.value_or(info.depthCompareOp);
+                    info.depthBoundsTestEnable = state.depthBoundsTestEnable.value_or(info.depthBoundsTestEnable);
+                    info.stencilTestEnable = state.stencilTestEnable.value_or(info.stencilTestEnable);
+                }
+            }
+
+            if (!extendedDynamicState2) {
+                if (state.rasterizerDiscardEnable.has_value() || state.depthBiasEnable.has_value()) {
+                    if (!pipeline.rasterizationStateCreateInfo.has_value()) {
+                        pipeline.rasterizationStateCreateInfo = VULKAN_HPP_NAMESPACE::PipelineRasterizationStateCreateInfo();
+                    }
+                    VULKAN_HPP_NAMESPACE::PipelineRasterizationStateCreateInfo& info = pipeline.rasterizationStateCreateInfo.value();
+                    info.rasterizerDiscardEnable = state.rasterizerDiscardEnable.value_or(info.rasterizerDiscardEnable);
+                    info.depthBiasEnable = state.depthBiasEnable.value_or(info.depthBiasEnable);
+                }
+
+                if (state.primitiveRestartEnable.has_value()) {
+                    if (!pipeline.inputAssemblyStateCreateInfo.has_value()) {
+                        pipeline.inputAssemblyStateCreateInfo = VULKAN_HPP_NAMESPACE::PipelineInputAssemblyStateCreateInfo();
+                    }
+                    pipeline.inputAssemblyStateCreateInfo.value().primitiveRestartEnable = state.primitiveRestartEnable.value();
+                }
+            }
+
+            if (!extendedDynamicState3PolygonMode && state.polygonMode.has_value()) {
+                if (!pipeline.rasterizationStateCreateInfo.has_value()) {
+                    pipeline.rasterizationStateCreateInfo = VULKAN_HPP_NAMESPACE::PipelineRasterizationStateCreateInfo();
+                }
+                pipeline.rasterizationStateCreateInfo.value().polygonMode = state.polygonMode.value();
+            }
+
+            if (!extendedDynamicState3ColorBlendEnable) {
+                for (size_t i = 0; i < state.colorBlendEnables.size() && i < pipeline.colorBlendAttachmentStates.size(); i++) {
+                    pipeline.colorBlendAttachmentStates.at(i).blendEnable = state.colorBlendEnables.at(i);
+                }
+            }
+
+            if (!extendedDynamicState3ColorWriteMask) {
+                for (size_t i = 0; i < state.colorWriteMasks.size() && i < pipeline.colorBlendAttachmentStates.size(); i++) {
+                    pipeline.colorBlendAttachmentStates.at(i).colorWriteMask = state.colorWriteMasks.at(i);
+                }
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void ExtendedDynamicState::record(VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer, const Pipeline& pipeline, const State& state) const {
+        try {
+            // every state 'apply()' declared dynamic is undefined until set, so each one is emitted
+            VULKAN_HPP_NAMESPACE::PipelineRasterizationStateCreateInfo rasterization = pipeline.rasterizationStateCreateInfo.value_or(VULKAN_HPP_NAMESPACE::PipelineRasterizationStateCreateInfo());
+            VULKAN_HPP_NAMESPACE::PipelineInputAssemblyStateCreateInfo inputAssembly = pipeline.inputAssemblyStateCreateInfo.value_or(VULKAN_HPP_NAMESPACE::PipelineInputAssemblyStateCreateInfo());
+            VULKAN_HPP_NAMESPACE::PipelineDepthStencilStateCreateInfo depthStencil = pipeline.depthStencilStateCreateInfo.value_or(VULKAN_HPP_NAMESPACE::PipelineDepthStencilStateCreateInfo());
+
+            if (extendedDynamicState) {
+                commandBuffer.setCullModeEXT(state.cullMode.value_or(rasterization.cullMode));
+                commandBuffer.setFrontFaceEXT(state.frontFace.value_or(rasterization.frontFace));
+                commandBuffer.setPrimitiveTopologyEXT(state.primitiveTopology.value_or(inputAssembly.topology));
+                commandBuffer.setDepthTestEnableEXT(state.depthTestEnable.value_or(depthStencil.depthTestEnable));
+                commandBuffer.setDepthWriteEnableEXT(state.depthWriteEnable.value_or(depthStencil.depthWriteEnable));
+                commandBuffer.setDepthCompareOpEXT(state.depthCompareOp.value_or(depthStencil.depthCompareOp));
+                commandBuffer.setDepthBoundsTestEnableEXT(state.depthBoundsTestEnable.value_or(depthStencil.depthBoundsTestEnable));
+                commandBuffer.setStencilTestEnableEXT(state.stencilTestEnable.value_or(depthStencil.stencilTestEnable));
+            }
+
+            if (extendedDynamicState2) {
+                commandBuffer.setRasterizerDiscardEnableEXT(state.rasterizerDiscardEnable.value_or(rasterization.rasterizerDiscardEnable));
+                commandBuffer.setDepthBiasEnableEXT(state.depthBiasEnable.value_or(rasterization.depthBiasEnable));
+                commandBuffer.setPrimitiveRestartEnableEXT(state.primitiveRestartEnable.value_or(inputAssembly.primitiveRestartEnable));
+            }
+
+            if (extendedDynamicState3PolygonMode) {
+                commandBuffer.setPolygonModeEXT(state.polygonMode.value_or(rasterization.polygonMode));
+            }
+
+            // per attachment values cover every attachment of the pipeline
+            size_t attachmentCount = pipeline.colorBlendAttachmentStates.size();
+
+            if (extendedDynamicState3ColorBlendEnable) {
+                std::vector<VULKAN_HPP_NAMESPACE::Bool32> values(std::max(attachmentCount, state.colorBlendEnables.size()));
+                for (size_t i = 0; i < values.size(); i++) {
+                    values.at(i) = i < state.colorBlendEnables.size() ? state.colorBlendEnables.at(i) : pipeline.colorBlendAttachmentStates.at(i).blendEnable;
+                }
+                if (!values.empty()) {
+                    commandBuffer.setColorBlendEnableEXT(0, values);
+                }
+            }
+
+            if (extendedDynamicState3ColorWriteMask) {
+                std::vector<VULKAN_HPP_NAMESPACE::ColorComponentFlags> values(std::max(attachmentCount, state.colorWriteMasks.size()));
+                for (size_t i = 0; i < values.size(); i++) {
+                    values.at(i) = i < state.colorWriteMasks.size() ? state.colorWriteMasks.at(i) : pipeline.colorBlendAttachmentStates.at(i).colorWriteMask;
+                }
+                if (!values.empty()) {
+                    commandBuffer.setColorWriteMaskEXT(0, values);
+                }
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void ExtendedDynamicState::clear() {
+        try {
+            enabled = false;
+            extendedDynamicState = false;
+            extendedDynamicState2 = false;
+            extendedDynamicState3PolygonMode = false;
+            extendedDynamicState3ColorBlendEnable = false;
+            extendedDynamicState3ColorWriteMask = false;
+            extensions.clear();
+            features.reset();
+            features2.reset();
+            features3.reset();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void ExtendedDynamicState::clearAndRelease() {
+        try {
+            clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE ExtendedDynamicState::Builder::Builder(ExtendedDynamicState& object): object(object) {
+    }
+
+    EXQUDENS_VULKAN_INLINE ExtendedDynamicState::Builder& ExtendedDynamicState::Builder::setEnabled(bool value) {
+        object.enabled = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE ExtendedDynamicState& ExtendedDynamicState::Builder::build(
+        VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice
+    ) {
+        try {
+            bool enabled = object.enabled;
+            object.clear();
+            object.enabled = enabled;
+
+            // disabled or unsupported leaves every flag false, which bakes all state into permutations
+            if (!object.enabled) {
+                return object;
+            }
+
+            std::vector<VULKAN_HPP_NAMESPACE::ExtensionProperties> properties = physicalDevice.enumerateDeviceExtensionProperties();
+            auto supported = [&properties](const char* name) {
+                return std::any_of(properties.begin(), properties.end(), [name](const VULKAN_HPP_NAMESPACE::ExtensionProperties& value) {
+                    return std::strcmp(value.extensionName, name) == 0;
+                });
+            };
+
+            auto chain = physicalDevice.getFeatures2<
+                VULKAN_HPP_NAMESPACE::PhysicalDeviceFeatures2,
+                VULKAN_HPP_NAMESPACE::PhysicalDeviceExtendedDynamicStateFeaturesEXT,
+                VULKAN_HPP_NAMESPACE::PhysicalDeviceExtendedDynamicState2FeaturesEXT,
+                VULKAN_HPP_NAMESPACE::PhysicalDeviceExtendedDynamicState3FeaturesEXT
+            >();
+
+            if (supported(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME) && chain.get<VULKAN_HPP_NAMESPACE::PhysicalDeviceExtendedDynamicStateFeaturesEXT>().extendedDynamicState) {
+                object.extendedDynamicState = true;
+                object.extensions.emplace_back(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME);
+                object.features = VULKAN_HPP_NAMESPACE::PhysicalDeviceExtendedDynamicStateFeaturesEXT().setExtendedDynamicState(true);
+            }
+
+            if (supported(VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME) && chain.get<VULKAN_HPP_NAMESPACE::PhysicalDeviceExtendedDynamicState2FeaturesEXT>().extendedDynamicState2) {
+                object.extendedDynamicState2 = true;
+                object.extensions.emplace_back(VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME);
+                object.features2 = VULKAN_HPP_NAMESPACE::PhysicalDeviceExtendedDynamicState2FeaturesEXT().setExtendedDynamicState2(true);
+            }
+
+            if (supported(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME)) {
+                const VULKAN_HPP_NAMESPACE::PhysicalDeviceExtendedDynamicState3FeaturesEXT& value = chain.get<VULKAN_HPP_NAMESPACE::PhysicalDeviceExtendedDynamicState3FeaturesEXT>();
+                object.extendedDynamicState3PolygonMode = value.extendedDynamicState3PolygonMode;
+                object.extendedDynamicState3ColorBlendEnable = value.extendedDynamicState3ColorBlendEnable;
+                object.extendedDynamicState3ColorWriteMask = value.extendedDynamicState3ColorWriteMask;
+
+                if (object.extendedDynamicState3PolygonMode || object.extendedDynamicState3ColorBlendEnable || object.extendedDynamicState3ColorWriteMask) {
+                    object.extensions.emplace_back(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME);
+                    object.features3 = VULKAN_HPP_NAMESPACE::PhysicalDeviceExtendedDynamicState3FeaturesEXT()
+                    .setExtendedDynamicState3PolygonMode(object.extendedDynamicState3PolygonMode)
+                    .setExtendedDynamicState3ColorBlendEnable(object.extendedDynamicState3ColorBlendEnable)
+                    .setExtendedDynamicState3ColorWriteMask(object.extendedDynamicState3ColorWriteMask);
+                }
+            }
+
+            return object;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
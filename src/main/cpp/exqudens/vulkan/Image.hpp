@@ -0,0 +1,357 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "exqudens/vulkan/export.hpp"
+
+namespace exqudens::vulkan {
+
+    struct EXQUDENS_VULKAN_EXPORT Image {
+
+        class Builder;
+
+        std::optional<VULKAN_HPP_NAMESPACE::ImageCreateInfo> createInfo = {};
+        // features of 'createInfo.format' for its tiling, pick the filter of the mip blits
+        std::optional<VULKAN_HPP_NAMESPACE::FormatFeatureFlags> formatFeatures = {};
+        VULKAN_HPP_NAMESPACE::raii::Image target = nullptr;
+
+        static VULKAN_HPP_NAMESPACE::ImageAspectFlags aspectMaskFrom(const VULKAN_HPP_NAMESPACE::Format& format);
+
+        static Builder builder(Image& object);
+
+        VULKAN_HPP_NAMESPACE::ImageSubresourceRange subresourceRange();
+
+        void upload(
+            VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer,
+            const VULKAN_HPP_NAMESPACE::Buffer& buffer,
+            const VULKAN_HPP_NAMESPACE::DeviceSize& bufferOffset = 0,
+            const VULKAN_HPP_NAMESPACE::ImageLayout& finalLayout = VULKAN_HPP_NAMESPACE::ImageLayout::eShaderReadOnlyOptimal,
+            const VULKAN_HPP_NAMESPACE::PipelineStageFlags& dstStageMask = VULKAN_HPP_NAMESPACE::PipelineStageFlagBits::eFragmentShader,
+            const VULKAN_HPP_NAMESPACE::AccessFlags& dstAccessMask = VULKAN_HPP_NAMESPACE::AccessFlagBits::eShaderRead,
+            uint32_t srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            uint32_t dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED
+        );
+
+        void clear();
+
+        void clearAndRelease();
+
+    };
+
+    class EXQUDENS_VULKAN_EXPORT Image::Builder {
+
+        private:
+
+            Image& object;
+
+        public:
+
+            explicit Builder(Image& object);
+
+            Builder& setCreateInfo(const VULKAN_HPP_NAMESPACE::ImageCreateInfo& value);
+
+            Builder& setFormatFeatures(const VULKAN_HPP_NAMESPACE::FormatFeatureFlags& value);
+
+            Image& build(
+                VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice,
+                VULKAN_HPP_NAMESPACE::raii::Device& device
+            );
+
+            Image& build(
+                VULKAN_HPP_NAMESPACE::raii::Device& device
+            );
+
+    };
+
+}
+
+// implementation ---
+
+#include <algorithm>
+#include <string>
+#include <filesystem>
+#include <stdexcept>
+
+#define CALL_INFO std::string(__FUNCTION__) + " (" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::vulkan {
+
+    EXQUDENS_VULKAN_INLINE VULKAN_HPP_NAMESPACE::ImageAspectFlags Image::aspectMaskFrom(const VULKAN_HPP_NAMESPACE::Format& format) {
+        try {
+            switch (format) {
+                case VULKAN_HPP_NAMESPACE::Format::eD16Unorm:
+                case VULKAN_HPP_NAMESPACE::Format::eX8D24UnormPack32:
+                case VULKAN_HPP_NAMESPACE::Format::eD32Sfloat:
+                    return VULKAN_HPP_NAMESPACE::ImageAspectFlagBits::eDepth;
+                case VULKAN_HPP_NAMESPACE::Format::eS8Uint:
+                    return VULKAN_HPP_NAMESPACE::ImageAspectFlagBits::eStencil;
+                case VULKAN_HPP_NAMESPACE::Format::eD16UnormS8Uint:
+                case VULKAN_HPP_NAMESPACE::Format::eD24UnormS8Uint:
+                case VULKAN_HPP_NAMESPACE::Format::eD32SfloatS8Uint:
+                    return VULKAN_HPP_NAMESPACE::ImageAspectFlagBits::eDepth | VULKAN_HPP_NAMESPACE::ImageAspectFlagBits::eStencil;
+                default:
+                    return VULKAN_HPP_NAMESPACE::ImageAspectFlagBits::eColor;
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE Image::Builder Image::builder(Image& object) {
+        return Builder(object);
+    }
+
+    EXQUDENS_VULKAN_INLINE VULKAN_HPP_NAMESPACE::ImageSubresourceRange Image::subresourceRange() {
+        try {
+            return VULKAN_HPP_NAMESPACE::ImageSubresourceRange()
+            .setAspectMask(aspectMaskFrom(createInfo.value().format))
+            .setBaseMipLevel(0)
+            .setLevelCount(createInfo.value().mipLevels)
+            .setBaseArrayLayer(0)
+            .setLayerCount(createInfo.value().arrayLayers);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void Image::upload(
+        VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer,
+        const VULKAN_HPP_NAMESPACE::Buffer& buffer,
+        const VULKAN_HPP_NAMESPACE::DeviceSize& bufferOffset,
+        const VULKAN_HPP_NAMESPACE::ImageLayout& finalLayout,
+        const VULKAN_HPP_NAMESPACE::PipelineStageFlags& dstStageMask,
+        const VULKAN_HPP_NAMESPACE::AccessFlags& dstAccessMask,
+        uint32_t srcQueueFamilyIndex,
+        uint32_t dstQueueFamilyIndex
+    ) {
+        try {
+            VULKAN_HPP_NAMESPACE::ImageSubresourceRange range = subresourceRange();
+
+            // previous contents are discarded, the whole image is overwritten by the copy
+            commandBuffer.pipelineBarrier(
+                VULKAN_HPP_NAMESPACE::PipelineStageFlagBits::eTopOfPipe,
+                VULKAN_HPP_NAMESPACE::PipelineStageFlagBits::eTransfer,
+                {},
+                nullptr,
+                nullptr,
+                VULKAN_HPP_NAMESPACE::ImageMemoryBarrier()
+                .setSrcAccessMask({})
+                .setDstAccessMask(VULKAN_HPP_NAMESPACE::AccessFlagBits::eTransferWrite)
+                .setOldLayout(VULKAN_HPP_NAMESPACE::ImageLayout::eUndefined)
+                .setNewLayout(VULKAN_HPP_NAMESPACE::ImageLayout::eTransferDstOptimal)
+                .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+                .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+                .setImage(*target)
+                .setSubresourceRange(range)
+            );
+
+            commandBuffer.copyBufferToImage(
+                buffer,
+                *target,
+                VULKAN_HPP_NAMESPACE::ImageLayout::eTransferDstOptimal,
+                VULKAN_HPP_NAMESPACE::BufferImageCopy()
+                .setBufferOffset(bufferOffset)
+                .setBufferRowLength(0)
+                .setBufferImageHeight(0)
+                .setImageSubresource(
+                    VULKAN_HPP_NAMESPACE::ImageSubresourceLayers()
+                    .setAspectMask(range.aspectMask)
+                    .setMipLevel(0)
+                    .setBaseArrayLayer(0)
+                    .setLayerCount(range.layerCount)
+                )
+                .setImageOffset(VULKAN_HPP_NAMESPACE::Offset3D(0, 0, 0))
+                .setImageExtent(createInfo.value().extent)
+            );
+
+            // the copy fills mip 0 only, every other level is blitted down from the one above it
+            // so 'eTransferSrc' usage is required when 'mipLevels' > 1,
+            // without known 'formatFeatures' the blits stay on 'eNearest'
+            VULKAN_HPP_NAMESPACE::Filter filter = VULKAN_HPP_NAMESPACE::Filter::eNearest;
+
+            if (range.levelCount > 1 && formatFeatures.has_value()) {
+                VULKAN_HPP_NAMESPACE::FormatFeatureFlags blitFeatures = VULKAN_HPP_NAMESPACE::FormatFeatureFlagBits::eBlitSrc | VULKAN_HPP_NAMESPACE::FormatFeatureFlagBits::eBlitDst;
+
+                if ((formatFeatures.value() & blitFeatures) != blitFeatures) {
+                    throw std::runtime_error(CALL_INFO + ": format does not support blits, 'mipLevels' > 1 can't be generated");
+                }
+
+                // depth and stencil blits only allow 'eNearest'
+                if (range.aspectMask == VULKAN_HPP_NAMESPACE::ImageAspectFlagBits::eColor && (formatFeatures.value() & VULKAN_HPP_NAMESPACE::FormatFeatureFlagBits::eSampledImageFilterLinear)) {
+                    filter = VULKAN_HPP_NAMESPACE::Filter::eLinear;
+                }
+            }
+
+            int32_t width = static_cast<int32_t>(createInfo.value().extent.width);
+            int32_t height = static_cast<int32_t>(createInfo.value().extent.height);
+            int32_t depth = static_cast<int32_t>(createInfo.value().extent.depth);
+
+            for (uint32_t i = 1; i < range.levelCount; i++) {
+                commandBuffer.pipelineBarrier(
+                    VULKAN_HPP_NAMESPACE::PipelineStageFlagBits::eTransfer,
+                    VULKAN_HPP_NAMESPACE::PipelineStageFlagBits::eTransfer,
+                    {},
+                    nullptr,
+                    nullptr,
+                    VULKAN_HPP_NAMESPACE::ImageMemoryBarrier()
+                    .setSrcAccessMask(VULKAN_HPP_NAMESPACE::AccessFlagBits::eTransferWrite)
+                    .setDstAccessMask(VULKAN_HPP_NAMESPACE::AccessFlagBits::eTransferRead)
+                    .setOldLayout(VULKAN_HPP_NAMESPACE::ImageLayout::eTransferDstOptimal)
+                    .setNewLayout(VULKAN_HPP_NAMESPACE::ImageLayout::eTransferSrcOptimal)
+                    .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+                    .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+                    .setImage(*target)
+                    .setSubresourceRange(VULKAN_HPP_NAMESPACE::ImageSubresourceRange(range).setBaseMipLevel(i - 1).setLevelCount(1))
+                );
+
+                int32_t nextWidth = std::max<int32_t>(width / 2, 1);
+                int32_t nextHeight = std::max<int32_t>(height / 2, 1);
+                int32_t nextDepth = std::max<int32_t>(depth / 2, 1);
+
+                commandBuffer.blitImage(
+                    *target,
+                    VULKAN_HPP_NAMESPACE::ImageLayout::eTransferSrcOptimal,
+                    *target,
+                    VULKAN_HPP_NAMESPACE::ImageLayout::eTransferDstOptimal,
+                    VULKAN_HPP_NAMESPACE::ImageBlit()
+                    .setSrcSubresource(VULKAN_HPP_NAMESPACE::ImageSubresourceLayers(range.aspectMask, i - 1, 0, range.layerCount))
+                    .setSrcOffsets({VULKAN_HPP_NAMESPACE::Offset3D(0, 0, 0), VULKAN_HPP_NAMESPACE::Offset3D(width, height, depth)})
+                    .setDstSubresource(VULKAN_HPP_NAMESPACE::ImageSubresourceLayers(range.aspectMask, i, 0, range.layerCount))
+                    .setDstOffsets({VULKAN_HPP_NAMESPACE::Offset3D(0, 0, 0), VULKAN_HPP_NAMESPACE::Offset3D(nextWidth, nextHeight, nextDepth)}),
+                    filter
+                );
+
+                width = nextWidth;
+                height = nextHeight;
+                depth = nextDepth;
+            }
+
+            // levels above the last one already sit in 'eTransferSrcOptimal'
+            // with different queue families these are the release half of an ownership transfer
+            std::vector<VULKAN_HPP_NAMESPACE::ImageMemoryBarrier> barriers = {
+                VULKAN_HPP_NAMESPACE::ImageMemoryBarrier()
+                .setSrcAccessMask(VULKAN_HPP_NAMESPACE::AccessFlagBits::eTransferWrite)
+                .setDstAccessMask(dstAccessMask)
+                .setOldLayout(VULKAN_HPP_NAMESPACE::ImageLayout::eTransferDstOptimal)
+                .setNewLayout(finalLayout)
+                .setSrcQueueFamilyIndex(srcQueueFamilyIndex)
+                .setDstQueueFamilyIndex(dstQueueFamilyIndex)
+                .setImage(*target)
+                .setSubresourceRange(VULKAN_HPP_NAMESPACE::ImageSubresourceRange(range).setBaseMipLevel(range.levelCount - 1).setLevelCount(1))
+            };
+
+            if (range.levelCount > 1) {
+                barriers.emplace_back(
+                    VULKAN_HPP_NAMESPACE::ImageMemoryBarrier()
+                    .setSrcAccessMask(VULKAN_HPP_NAMESPACE::AccessFlagBits::eTransferRead)
+                    .setDstAccessMask(dstAccessMask)
+                    .setOldLayout(VULKAN_HPP_NAMESPACE::ImageLayout::eTransferSrcOptimal)
+                    .setNewLayout(finalLayout)
+                    .setSrcQueueFamilyIndex(srcQueueFamilyIndex)
+                    .setDstQueueFamilyIndex(dstQueueFamilyIndex)
+                    .setImage(*target)
+                    .setSubresourceRange(VULKAN_HPP_NAMESPACE::ImageSubresourceRange(range).setBaseMipLevel(0).setLevelCount(range.levelCount - 1))
+                );
+            }
+
+            commandBuffer.pipelineBarrier(
+                VULKAN_HPP_NAMESPACE::PipelineStageFlagBits::eTransfer,
+                dstStageMask,
+                {},
+                nullptr,
+                nullptr,
+                barriers
+            );
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void Image::clear() {
+        try {
+            createInfo.reset();
+            formatFeatures.reset();
+            target.clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void Image::clearAndRelease() {
+        try {
+            clear();
+            target.release();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE Image::Builder::Builder(Image& object): object(object) {
+    }
+
+    EXQUDENS_VULKAN_INLINE Image::Builder& Image::Builder::setCreateInfo(const VULKAN_HPP_NAMESPACE::ImageCreateInfo& value) {
+        object.createInfo = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE Image::Builder& Image::Builder::setFormatFeatures(const VULKAN_HPP_NAMESPACE::FormatFeatureFlags& value) {
+        object.formatFeatures = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE Image& Image::Builder::build(
+        VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice,
+        VULKAN_HPP_NAMESPACE::raii::Device& device
+    ) {
+        try {
+            if (object.createInfo.has_value() && !object.formatFeatures.has_value()) {
+                VULKAN_HPP_NAMESPACE::FormatProperties properties = physicalDevice.getFormatProperties(object.createInfo.value().format);
+                if (object.createInfo.value().tiling == VULKAN_HPP_NAMESPACE::ImageTiling::eLinear) {
+                    object.formatFeatures = properties.linearTilingFeatures;
+                } else {
+                    object.formatFeatures = properties.optimalTilingFeatures;
+                }
+            }
+
+            return build(device);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE Image& Image::Builder::build(
+        VULKAN_HPP_NAMESPACE::raii::Device& device
+    ) {
+        try {
+            if (!object.createInfo.has_value()) {
+                object.createInfo = VULKAN_HPP_NAMESPACE::ImageCreateInfo()
+                .setImageType(VULKAN_HPP_NAMESPACE::ImageType::e2D)
+                .setMipLevels(1)
+                .setArrayLayers(1)
+                .setSamples(VULKAN_HPP_NAMESPACE::SampleCountFlagBits::e1)
+                .setTiling(VULKAN_HPP_NAMESPACE::ImageTiling::eOptimal)
+                .setUsage(VULKAN_HPP_NAMESPACE::ImageUsageFlagBits::eTransferDst | VULKAN_HPP_NAMESPACE::ImageUsageFlagBits::eSampled)
+                .setSharingMode(VULKAN_HPP_NAMESPACE::SharingMode::eExclusive)
+                .setInitialLayout(VULKAN_HPP_NAMESPACE::ImageLayout::eUndefined);
+            }
+
+            const VULKAN_HPP_NAMESPACE::Extent3D& extent = object.createInfo.value().extent;
+
+            if (extent.width == 0 || extent.height == 0 || extent.depth == 0) {
+                throw std::runtime_error(CALL_INFO + ": 'createInfo.extent' has a zero dimension");
+            }
+
+            object.target = device.createImage(object.createInfo.value());
+
+            return object;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
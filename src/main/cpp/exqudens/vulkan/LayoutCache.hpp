@@ -0,0 +1,307 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "exqudens/vulkan/export.hpp"
+#include "exqudens/vulkan/DescriptorSetLayout.hpp"
+#include "exqudens/vulkan/PipelineLayout.hpp"
+
+namespace exqudens::vulkan {
+
+    struct EXQUDENS_VULKAN_EXPORT LayoutCache {
+
+        class Builder;
+
+        // canonical words of a layout description, compared in full so a hash collision never aliases two layouts
+        using Key = std::vector<uint64_t>;
+
+        struct EXQUDENS_VULKAN_EXPORT KeyHash {
+            size_t operator()(const Key& value) const;
+        };
+
+        std::unordered_map<Key, std::shared_ptr<DescriptorSetLayout>, KeyHash> setLayouts = {};
+        std::unordered_map<Key, std::shared_ptr<PipelineLayout>, KeyHash> pipelineLayouts = {};
+        std::mutex mutex = {};
+
+        static Key keyFrom(const DescriptorSetLayout& description);
+
+        static Key keyFrom(const PipelineLayout& description);
+
+        static Builder builder(LayoutCache& object);
+
+        // 'description' is filled through its builder but not built, identical descriptions share one object
+        std::shared_ptr<DescriptorSetLayout> obtain(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            const DescriptorSetLayout& description
+        );
+
+        std::shared_ptr<PipelineLayout> obtain(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            const PipelineLayout& description
+        );
+
+        size_t size();
+
+        void clear();
+
+        void clearAndRelease();
+
+    };
+
+    class EXQUDENS_VULKAN_EXPORT LayoutCache::Builder {
+
+        private:
+
+            LayoutCache& object;
+
+        public:
+
+            explicit Builder(LayoutCache& object);
+
+            LayoutCache& build();
+
+    };
+
+}
+
+// implementation ---
+
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <string>
+#include <filesystem>
+#include <stdexcept>
+
+#include "exqudens/vulkan/PipelineStateKey.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + " (" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::vulkan {
+
+    EXQUDENS_VULKAN_INLINE size_t LayoutCache::KeyHash::operator()(const Key& value) const {
+        return static_cast<size_t>(PipelineStateKey::hashBytes(value.data(), sizeof(uint64_t) * value.size()));
+    }
+
+    EXQUDENS_VULKAN_INLINE LayoutCache::Key LayoutCache::keyFrom(const DescriptorSetLayout& description) {
+        try {
+            VULKAN_HPP_NAMESPACE::DescriptorSetLayoutCreateInfo createInfo = description.createInfo.value_or(VULKAN_HPP_NAMESPACE::DescriptorSetLayoutCreateInfo());
+
+            if (createInfo.pNext != nullptr) {
+                throw std::runtime_error(CALL_INFO + ": 'createInfo.pNext' is not supported, use 'bindingFlags'");
+            }
+
+            if (!description.bindingFlags.empty() && description.bindingFlags.size() != description.bindings.size()) {
+                throw std::runtime_error(CALL_INFO + ": 'bindingFlags' size does not match 'bindings' size");
+            }
+
+            // binding order does not change the layout, so it does not change the key
+            std::vector<size_t> order(description.bindings.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&description](size_t a, size_t b) {
+                return description.bindings.at(a).binding < description.bindings.at(b).binding;
+            });
+
+            Key result = {};
+            result.emplace_back(static_cast<uint64_t>(static_cast<VkDescriptorSetLayoutCreateFlags>(createInfo.flags)));
+            result.emplace_back(description.bindings.size());
+
+            for (size_t i : order) {
+                const VULKAN_HPP_NAMESPACE::DescriptorSetLayoutBinding& binding = description.bindings.at(i);
+                result.emplace_back(binding.binding);
+                result.emplace_back(static_cast<uint64_t>(binding.descriptorType));
+                result.emplace_back(binding.descriptorCount);
+                result.emplace_back(static_cast<uint64_t>(static_cast<VkShaderStageFlags>(binding.stageFlags)));
+                result.emplace_back(description.bindingFlags.empty() ? 0 : static_cast<uint64_t>(static_cast<VkDescriptorBindingFlags>(description.bindingFlags.at(i))));
+                result.emplace_back(binding.pImmutableSamplers == nullptr ? 0 : binding.descriptorCount);
+
+                if (binding.pImmutableSamplers != nullptr) {
+                    for (uint32_t j = 0; j < binding.descriptorCount; j++) {
+                        result.emplace_back(reinterpret_cast<uint64_t>(static_cast<VkSampler>(binding.pImmutableSamplers[j])));
+                    }
+                }
+            }
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE LayoutCache::Key LayoutCache::keyFrom(const PipelineLayout& description) {
+        try {
+            VULKAN_HPP_NAMESPACE::PipelineLayoutCreateInfo createInfo = description.createInfo.value_or(VULKAN_HPP_NAMESPACE::PipelineLayoutCreateInfo());
+
+            if (createInfo.pNext != nullptr) {
+                throw std::runtime_error(CALL_INFO + ": 'createInfo.pNext' is not supported");
+            }
+
+            // same precedence as 'PipelineLayout::Builder::build'
+            std::vector<VULKAN_HPP_NAMESPACE::DescriptorSetLayout> setLayouts = description.setLayouts;
+            if (setLayouts.empty() && createInfo.pSetLayouts != nullptr) {
+                setLayouts.assign(createInfo.pSetLayouts, createInfo.pSetLayouts + createInfo.setLayoutCount);
+            }
+
+            std::vector<VULKAN_HPP_NAMESPACE::PushConstantRange> ranges = description.pushConstantRanges;
+            if (ranges.empty() && createInfo.pPushConstantRanges != nullptr) {
+                ranges.assign(createInfo.pPushConstantRanges, createInfo.pPushConstantRanges + createInfo.pushConstantRangeCount);
+            }
+
+            std::sort(ranges.begin(), ranges.end(), [](const VULKAN_HPP_NAMESPACE::PushConstantRange& a, const VULKAN_HPP_NAMESPACE::PushConstantRange& b) {
+                return std::make_tuple(a.offset, a.size, static_cast<VkShaderStageFlags>(a.stageFlags)) < std::make_tuple(b.offset, b.size, static_cast<VkShaderStageFlags>(b.stageFlags));
+            });
+
+            // set layouts come interned, so equal sets already share a handle
+            Key result = {};
+            result.emplace_back(static_cast<uint64_t>(static_cast<VkPipelineLayoutCreateFlags>(createInfo.flags)));
+            result.emplace_back(setLayouts.size());
+
+            for (const VULKAN_HPP_NAMESPACE::DescriptorSetLayout& value : setLayouts) {
+                result.emplace_back(reinterpret_cast<uint64_t>(static_cast<VkDescriptorSetLayout>(value)));
+            }
+
+            result.emplace_back(ranges.size());
+
+            for (const VULKAN_HPP_NAMESPACE::PushConstantRange& value : ranges) {
+                result.emplace_back(static_cast<uint64_t>(static_cast<VkShaderStageFlags>(value.stageFlags)));
+                result.emplace_back(value.offset);
+                result.emplace_back(value.size);
+            }
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE LayoutCache::Builder LayoutCache::builder(LayoutCache& object) {
+        return Builder(object);
+    }
+
+    EXQUDENS_VULKAN_INLINE std::shared_ptr<DescriptorSetLayout> LayoutCache::obtain(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        const DescriptorSetLayout& description
+    ) {
+        try {
+            Key key = keyFrom(description);
+
+            // layout creation is cheap, so it runs under the lock
+            std::lock_guard<std::mutex> lock(mutex);
+
+            auto it = setLayouts.find(key);
+
+            if (it != setLayouts.end()) {
+                return it->second;
+            }
+
+            std::shared_ptr<DescriptorSetLayout> value = std::make_shared<DescriptorSetLayout>();
+            DescriptorSetLayout::Builder valueBuilder = DescriptorSetLayout::builder(*value)
+            .setBindings(description.bindings)
+            .setBindingFlags(description.bindingFlags);
+
+            if (description.createInfo.has_value()) {
+                valueBuilder.setCreateInfo(description.createInfo.value());
+            }
+
+            valueBuilder.build(device);
+
+            setLayouts.emplace(std::move(key), value);
+
+            return value;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE std::shared_ptr<PipelineLayout> LayoutCache::obtain(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        const PipelineLayout& description
+    ) {
+        try {
+            Key key = keyFrom(description);
+
+            std::lock_guard<std::mutex> lock(mutex);
+
+            auto it = pipelineLayouts.find(key);
+
+            if (it != pipelineLayouts.end()) {
+                return it->second;
+            }
+
+            std::shared_ptr<PipelineLayout> value = std::make_shared<PipelineLayout>();
+            PipelineLayout::Builder valueBuilder = PipelineLayout::builder(*value)
+            .setSetLayouts(description.setLayouts)
+            .setPushConstantRanges(description.pushConstantRanges);
+
+            if (description.createInfo.has_value()) {
+                valueBuilder.setCreateInfo(description.createInfo.value());
+            }
+
+            valueBuilder.build(device);
+
+            pipelineLayouts.emplace(std::move(key), value);
+
+            return value;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE size_t LayoutCache::size() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            return setLayouts.size() + pipelineLayouts.size();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void LayoutCache::clear() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            // pipeline layouts reference set layouts, so they go first
+            pipelineLayouts.clear();
+            setLayouts.clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void LayoutCache::clearAndRelease() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto& [key, value] : pipelineLayouts) {
+                value->clearAndRelease();
+            }
+            for (auto& [key, value] : setLayouts) {
+                value->clearAndRelease();
+            }
+            pipelineLayouts.clear();
+            setLayouts.clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE LayoutCache::Builder::Builder(LayoutCache& object): object(object) {
+    }
+
+    EXQUDENS_VULKAN_INLINE LayoutCache& LayoutCache::Builder::build() {
+        try {
+            object.clear();
+            return object;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
@@ -0,0 +1,426 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <set>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "exqudens/vulkan/export.hpp"
+#include "exqudens/vulkan/DeviceMemory.hpp"
+
+namespace exqudens::vulkan {
+
+    struct EXQUDENS_VULKAN_EXPORT MemoryArena {
+
+        class Builder;
+
+        // empty 'freeOffsets' marks a released block whose slot can be reused
+        struct Block {
+            uint32_t memoryTypeIndex = 0;
+            uint32_t order = 0;
+            DeviceMemory memory = {};
+            std::vector<std::set<VULKAN_HPP_NAMESPACE::DeviceSize>> freeOffsets = {};
+        };
+
+        struct Allocation {
+            VULKAN_HPP_NAMESPACE::DeviceMemory memory = nullptr;
+            VULKAN_HPP_NAMESPACE::DeviceSize offset = 0;
+            VULKAN_HPP_NAMESPACE::DeviceSize size = 0;
+            size_t blockIndex = 0;
+            uint32_t order = 0;
+        };
+
+        std::optional<VULKAN_HPP_NAMESPACE::DeviceSize> blockSize = {};
+        std::optional<VULKAN_HPP_NAMESPACE::DeviceSize> minAllocationSize = {};
+        std::optional<VULKAN_HPP_NAMESPACE::DeviceSize> bufferImageGranularity = {};
+        std::optional<VULKAN_HPP_NAMESPACE::PhysicalDeviceMemoryProperties> memoryProperties = {};
+        std::vector<Block> blocks = {};
+
+        static Builder builder(MemoryArena& object);
+
+        Allocation allocate(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            const VULKAN_HPP_NAMESPACE::MemoryRequirements& requirements,
+            const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& flags,
+            const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& preferredFlags = {},
+            const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& avoidedFlags = {}
+        );
+
+        Allocation bind(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            VULKAN_HPP_NAMESPACE::raii::Buffer& buffer,
+            const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& flags,
+            const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& preferredFlags = {},
+            const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& avoidedFlags = {}
+        );
+
+        Allocation bind(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            VULKAN_HPP_NAMESPACE::raii::Image& image,
+            const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& flags,
+            const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& preferredFlags = {},
+            const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& avoidedFlags = {}
+        );
+
+        void free(const Allocation& allocation);
+
+        void clear();
+
+        void clearAndRelease();
+
+    };
+
+    class EXQUDENS_VULKAN_EXPORT MemoryArena::Builder {
+
+        private:
+
+            MemoryArena& object;
+
+        public:
+
+            explicit Builder(MemoryArena& object);
+
+            Builder& setBlockSize(const VULKAN_HPP_NAMESPACE::DeviceSize& value);
+
+            Builder& setMinAllocationSize(const VULKAN_HPP_NAMESPACE::DeviceSize& value);
+
+            Builder& setBufferImageGranularity(const VULKAN_HPP_NAMESPACE::DeviceSize& value);
+
+            Builder& setMemoryProperties(const VULKAN_HPP_NAMESPACE::PhysicalDeviceMemoryProperties& value);
+
+            MemoryArena& build(
+                VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice
+            );
+
+    };
+
+}
+
+// implementation ---
+
+#include <utility>
+#include <string>
+#include <filesystem>
+#include <stdexcept>
+
+#define CALL_INFO std::string(__FUNCTION__) + " (" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::vulkan {
+
+    EXQUDENS_VULKAN_INLINE MemoryArena::Builder MemoryArena::builder(MemoryArena& object) {
+        return Builder(object);
+    }
+
+    EXQUDENS_VULKAN_INLINE MemoryArena::Allocation MemoryArena::allocate(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        const VULKAN_HPP_NAMESPACE::MemoryRequirements& requirements,
+        const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& flags,
+        const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& preferredFlags,
+        const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& avoidedFlags
+    ) {
+        try {
+            if (!blockSize.has_value() || !minAllocationSize.has_value() || !memoryProperties.has_value()) {
+                throw std::runtime_error(CALL_INFO + ": arena is not built");
+            }
+
+            std::optional<uint32_t> memoryTypeIndex = DeviceMemory::memoryTypeIndexFrom(
+                memoryProperties.value(),
+                requirements.memoryTypeBits,
+                flags,
+                preferredFlags,
+                avoidedFlags
+            );
+
+            if (!memoryTypeIndex.has_value()) {
+                throw std::runtime_error(CALL_INFO + ": failed to find suitable memory type!");
+            }
+
+            // buddy blocks are aligned to their own size, so rounding up to the alignment is enough
+            VULKAN_HPP_NAMESPACE::DeviceSize size = requirements.size;
+            if (size < requirements.alignment) {
+                size = requirements.alignment;
+            }
+
+            uint32_t blockOrder = 0;
+            while ((minAllocationSize.value() << blockOrder) < blockSize.value()) {
+                blockOrder++;
+            }
+
+            // bounded by the block order, so the shift cannot overflow
+            uint32_t order = 0;
+            while (order < blockOrder && (minAllocationSize.value() << order) < size) {
+                order++;
+            }
+
+            if ((minAllocationSize.value() << order) < size) {
+                throw std::runtime_error(CALL_INFO + ": 'size' is greater than 'blockSize'");
+            }
+
+            std::optional<size_t> releasedIndex = {};
+
+            for (size_t i = 0; i < blocks.size(); i++) {
+                Block& block = blocks.at(i);
+
+                if (block.freeOffsets.empty()) {
+                    if (!releasedIndex.has_value()) {
+                        releasedIndex = i;
+                    }
+                    continue;
+                }
+
+                if (block.memoryTypeIndex != memoryTypeIndex.value() || block.order < order) {
+                    continue;
+                }
+
+                uint32_t freeOrder = order;
+                while (freeOrder <= block.order && block.freeOffsets.at(freeOrder).empty()) {
+                    freeOrder++;
+                }
+
+                if (freeOrder > block.order) {
+                    continue;
+                }
+
+                VULKAN_HPP_NAMESPACE::DeviceSize offset = *block.freeOffsets.at(freeOrder).begin();
+                block.freeOffsets.at(freeOrder).erase(block.freeOffsets.at(freeOrder).begin());
+
+                // split down to the requested order, keeping the upper halves free
+                while (freeOrder > order) {
+                    freeOrder--;
+                    block.freeOffsets.at(freeOrder).insert(offset + (minAllocationSize.value() << freeOrder));
+                }
+
+                Allocation result;
+                result.memory = *block.memory.target;
+                result.offset = offset;
+                result.size = minAllocationSize.value() << order;
+                result.blockIndex = i;
+                result.order = order;
+                return result;
+            }
+
+            Block block;
+            block.memoryTypeIndex = memoryTypeIndex.value();
+            block.order = blockOrder;
+            block.freeOffsets.resize(blockOrder + 1);
+
+            DeviceMemory::builder(block.memory)
+            .setAllocateInfo(
+                VULKAN_HPP_NAMESPACE::MemoryAllocateInfo()
+                .setAllocationSize(minAllocationSize.value() << blockOrder)
+                .setMemoryTypeIndex(memoryTypeIndex.value())
+            )
+            .build(device);
+
+            for (uint32_t i = blockOrder; i > order; i--) {
+                block.freeOffsets.at(i - 1).insert(minAllocationSize.value() << (i - 1));
+            }
+
+            Allocation result;
+            result.memory = *block.memory.target;
+            result.offset = 0;
+            result.size = minAllocationSize.value() << order;
+            result.order = order;
+
+            if (releasedIndex.has_value()) {
+                result.blockIndex = releasedIndex.value();
+                blocks.at(releasedIndex.value()) = std::move(block);
+            } else {
+                result.blockIndex = blocks.size();
+                blocks.emplace_back(std::move(block));
+            }
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE MemoryArena::Allocation MemoryArena::bind(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        VULKAN_HPP_NAMESPACE::raii::Buffer& buffer,
+        const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& flags,
+        const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& preferredFlags,
+        const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& avoidedFlags
+    ) {
+        try {
+            Allocation result = allocate(device, buffer.getMemoryRequirements(), flags, preferredFlags, avoidedFlags);
+            buffer.bindMemory(result.memory, result.offset);
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE MemoryArena::Allocation MemoryArena::bind(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        VULKAN_HPP_NAMESPACE::raii::Image& image,
+        const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& flags,
+        const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& preferredFlags,
+        const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& avoidedFlags
+    ) {
+        try {
+            VULKAN_HPP_NAMESPACE::MemoryRequirements requirements = image.getMemoryRequirements();
+
+            // images occupy whole granularity pages, so no linear buffer can share a page with an optimal-tiling image
+            if (bufferImageGranularity.has_value() && bufferImageGranularity.value() > 1) {
+                VULKAN_HPP_NAMESPACE::DeviceSize granularity = bufferImageGranularity.value();
+                requirements.size = ((requirements.size + granularity - 1) / granularity) * granularity;
+                if (requirements.alignment < granularity) {
+                    requirements.alignment = granularity;
+                }
+            }
+
+            Allocation result = allocate(device, requirements, flags, preferredFlags, avoidedFlags);
+            image.bindMemory(result.memory, result.offset);
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void MemoryArena::free(const Allocation& allocation) {
+        try {
+            if (!minAllocationSize.has_value()) {
+                throw std::runtime_error(CALL_INFO + ": arena is not built");
+            }
+
+            if (allocation.blockIndex >= blocks.size() || blocks.at(allocation.blockIndex).freeOffsets.empty()) {
+                throw std::runtime_error(CALL_INFO + ": 'allocation' does not belong to a live block");
+            }
+
+            Block& block = blocks.at(allocation.blockIndex);
+            VULKAN_HPP_NAMESPACE::DeviceSize offset = allocation.offset;
+            uint32_t order = allocation.order;
+
+            if (
+                allocation.memory != *block.memory.target
+                || order > block.order
+                || offset % (minAllocationSize.value() << order) != 0
+                || offset >= (minAllocationSize.value() << block.order)
+            ) {
+                throw std::runtime_error(CALL_INFO + ": 'allocation' is not valid for its block");
+            }
+
+            // the range is already free if it, or any buddy block containing it, is on a free list
+            for (uint32_t i = order; i <= block.order; i++) {
+                VULKAN_HPP_NAMESPACE::DeviceSize containing = offset & ~((minAllocationSize.value() << i) - 1);
+                if (block.freeOffsets.at(i).count(containing) > 0) {
+                    throw std::runtime_error(CALL_INFO + ": 'allocation' is already free");
+                }
+            }
+
+            // merge with free buddies for as long as possible
+            while (order < block.order) {
+                VULKAN_HPP_NAMESPACE::DeviceSize buddyOffset = offset ^ (minAllocationSize.value() << order);
+                if (block.freeOffsets.at(order).erase(buddyOffset) == 0) {
+                    break;
+                }
+                if (buddyOffset < offset) {
+                    offset = buddyOffset;
+                }
+                order++;
+            }
+
+            // a fully merged block holds no allocations, its memory goes back to the driver
+            if (order == block.order) {
+                block.memory.clear();
+                block.freeOffsets.clear();
+                return;
+            }
+
+            block.freeOffsets.at(order).insert(offset);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void MemoryArena::clear() {
+        try {
+            blockSize.reset();
+            minAllocationSize.reset();
+            bufferImageGranularity.reset();
+            memoryProperties.reset();
+            for (size_t i = 0; i < blocks.size(); i++) {
+                blocks.at(i).memory.clear();
+            }
+            blocks.clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void MemoryArena::clearAndRelease() {
+        try {
+            for (size_t i = 0; i < blocks.size(); i++) {
+                blocks.at(i).memory.clearAndRelease();
+            }
+            clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE MemoryArena::Builder::Builder(MemoryArena& object): object(object) {
+    }
+
+    EXQUDENS_VULKAN_INLINE MemoryArena::Builder& MemoryArena::Builder::setBlockSize(const VULKAN_HPP_NAMESPACE::DeviceSize& value) {
+        object.blockSize = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE MemoryArena::Builder& MemoryArena::Builder::setMinAllocationSize(const VULKAN_HPP_NAMESPACE::DeviceSize& value) {
+        object.minAllocationSize = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE MemoryArena::Builder& MemoryArena::Builder::setBufferImageGranularity(const VULKAN_HPP_NAMESPACE::DeviceSize& value) {
+        object.bufferImageGranularity = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE MemoryArena::Builder& MemoryArena::Builder::setMemoryProperties(const VULKAN_HPP_NAMESPACE::PhysicalDeviceMemoryProperties& value) {
+        object.memoryProperties = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE MemoryArena& MemoryArena::Builder::build(
+        VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice
+    ) {
+        try {
+            if (!object.blockSize.has_value()) {
+                object.blockSize = 67108864; // 64 mb
+            }
+
+            if (!object.minAllocationSize.has_value()) {
+                object.minAllocationSize = 256;
+            }
+
+            if (object.minAllocationSize.value() == 0 || (object.minAllocationSize.value() & (object.minAllocationSize.value() - 1)) != 0) {
+                throw std::runtime_error(CALL_INFO + ": 'minAllocationSize' is not a power of two");
+            }
+
+            if (object.blockSize.value() < object.minAllocationSize.value()) {
+                throw std::runtime_error(CALL_INFO + ": 'blockSize' is less than 'minAllocationSize'");
+            }
+
+            if (!object.bufferImageGranularity.has_value()) {
+                object.bufferImageGranularity = physicalDevice.getProperties().limits.bufferImageGranularity;
+            }
+
+            if (!object.memoryProperties.has_value()) {
+                object.memoryProperties = DeviceMemory::memoryPropertiesFrom(physicalDevice);
+            }
+
+            return object;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
@@ -1,7 +1,15 @@
 #pragma once
 
+#include <cstdint>
+#include <cstring>
 #include <optional>
 #include <vector>
+#include <tuple>
+#include <type_traits>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
 
 #include <vulkan/vulkan_raii.hpp>
 
@@ -14,6 +22,11 @@ namespace exqudens::vulkan {
         class Builder;
 
         std::vector<VULKAN_HPP_NAMESPACE::PipelineShaderStageCreateInfo> shaderStageCreateInfos = {};
+        std::vector<VULKAN_HPP_NAMESPACE::SpecializationMapEntry> specializationMapEntries = {};
+        std::vector<uint8_t> specializationData = {};
+        std::optional<VULKAN_HPP_NAMESPACE::SpecializationInfo> specializationInfo = {};
+        // stages 'prepare()' pointed at 'specializationInfo', re-pointed on every call so copies never keep the source address
+        std::vector<bool> sharedSpecializationStages = {};
 
         std::vector<VULKAN_HPP_NAMESPACE::VertexInputBindingDescription> vertexInputStateCreateInfoBindings = {};
         std::vector<VULKAN_HPP_NAMESPACE::VertexInputAttributeDescription> vertexInputStateCreateInfoAttributes = {};
@@ -32,11 +45,27 @@ namespace exqudens::vulkan {
         std::optional<VULKAN_HPP_NAMESPACE::PipelineDepthStencilStateCreateInfo> depthStencilStateCreateInfo = {};
         std::optional<VULKAN_HPP_NAMESPACE::PipelineTessellationStateCreateInfo> tessellationStateCreateInfo = {};
         std::optional<VULKAN_HPP_NAMESPACE::PipelineRenderingCreateInfo> renderingCreateInfo = {};
+        std::optional<VULKAN_HPP_NAMESPACE::GraphicsPipelineLibraryCreateInfoEXT> libraryCreateInfo = {};
+        std::vector<VULKAN_HPP_NAMESPACE::Pipeline> libraries = {};
+        std::optional<VULKAN_HPP_NAMESPACE::PipelineLibraryCreateInfoKHR> libraryLinkCreateInfo = {};
         std::optional<VULKAN_HPP_NAMESPACE::GraphicsPipelineCreateInfo> graphicsCreateInfo = {};
+        std::optional<VULKAN_HPP_NAMESPACE::ComputePipelineCreateInfo> computeCreateInfo = {};
         VULKAN_HPP_NAMESPACE::raii::Pipeline target = nullptr;
 
+        // opt-in hook called after every successful build, builds run on compiler threads so the pointer is only touched under 'listenerMutex'
+        // the call itself runs unlocked, a listener may build pipelines but must not call 'setListener'
+        inline static std::shared_ptr<const std::function<void(const Pipeline&)>> listener = {};
+        inline static std::mutex listenerMutex = {};
+
+        static void setListener(const std::function<void(const Pipeline&)>& value);
+
+        static void notify(const Pipeline& value);
+
         static Builder builder(Pipeline& object);
 
+        // true for a stage of this object that 'prepare()' pointed at 'specializationInfo', false for any other stage
+        bool usesSharedSpecialization(const VULKAN_HPP_NAMESPACE::PipelineShaderStageCreateInfo& stage) const;
+
         void clear();
 
         void clearAndRelease();
@@ -57,6 +86,46 @@ namespace exqudens::vulkan {
 
             Builder& addShaderStageCreateInfo(const VULKAN_HPP_NAMESPACE::PipelineShaderStageCreateInfo& value);
 
+            Builder& setSpecializationMapEntries(const std::vector<VULKAN_HPP_NAMESPACE::SpecializationMapEntry>& value);
+
+            Builder& setSpecializationData(const std::vector<uint8_t>& value);
+
+            template<typename T>
+            Builder& addSpecialization(uint32_t constantId, const T& value) {
+                static_assert(std::is_trivially_copyable_v<T>, "specialization constant must be trivially copyable");
+
+                if constexpr (std::is_same_v<T, bool>) {
+                    // spir-v booleans are specialized through a 32-bit value
+                    return addSpecialization<VULKAN_HPP_NAMESPACE::Bool32>(constantId, value ? VK_TRUE : VK_FALSE);
+                } else {
+                    // a repeated id replaces the earlier entry, its bytes are left unused
+                    std::erase_if(object.specializationMapEntries, [constantId](const VULKAN_HPP_NAMESPACE::SpecializationMapEntry& entry) {
+                        return entry.constantID == constantId;
+                    });
+
+                    uint32_t offset = static_cast<uint32_t>(object.specializationData.size());
+                    object.specializationData.resize(offset + sizeof(T));
+                    std::memcpy(object.specializationData.data() + offset, &value, sizeof(T));
+                    object.specializationMapEntries.emplace_back(constantId, offset, sizeof(T));
+
+                    return *this;
+                }
+            }
+
+            template<uint32_t... ConstantIds, typename... Types>
+            Builder& setSpecialization(const std::tuple<Types...>& values) {
+                static_assert(sizeof...(ConstantIds) == sizeof...(Types), "one constant id per value");
+
+                object.specializationMapEntries.clear();
+                object.specializationData.clear();
+
+                std::apply([this](const Types&... value) {
+                    (addSpecialization(ConstantIds, value), ...);
+                }, values);
+
+                return *this;
+            }
+
             Builder& setVertexInputStateCreateInfoBindings(const std::vector<VULKAN_HPP_NAMESPACE::VertexInputBindingDescription>& value);
             Builder& setVertexInputStateCreateInfoAttributes(const std::vector<VULKAN_HPP_NAMESPACE::VertexInputAttributeDescription>& value);
             Builder& setVertexInputStateCreateInfo(const VULKAN_HPP_NAMESPACE::PipelineVertexInputStateCreateInfo& value);
@@ -95,8 +164,18 @@ namespace exqudens::vulkan {
 
             Builder& setRenderingCreateInfo(const VULKAN_HPP_NAMESPACE::PipelineRenderingCreateInfo& value);
 
+            Builder& setLibraryFlags(const VULKAN_HPP_NAMESPACE::GraphicsPipelineLibraryFlagsEXT& value);
+
+            Builder& setLibraries(const std::vector<VULKAN_HPP_NAMESPACE::Pipeline>& value);
+
+            Builder& addLibrary(const VULKAN_HPP_NAMESPACE::Pipeline& value);
+
             Builder& setGraphicsCreateInfo(const VULKAN_HPP_NAMESPACE::GraphicsPipelineCreateInfo& value);
 
+            Builder& setComputeCreateInfo(const VULKAN_HPP_NAMESPACE::ComputePipelineCreateInfo& value);
+
+            Pipeline& prepare();
+
             Pipeline& build(
                 VULKAN_HPP_NAMESPACE::raii::Device& device,
                 VULKAN_HPP_NAMESPACE::raii::PipelineCache& cache
@@ -111,8 +190,8 @@ namespace exqudens::vulkan {
 
 // implementation ---
 
-#include <cstdint>
 #include <string>
+#include <thread>
 #include <filesystem>
 #include <stdexcept>
 
@@ -120,13 +199,73 @@ namespace exqudens::vulkan {
 
 namespace exqudens::vulkan {
 
+    EXQUDENS_VULKAN_INLINE void Pipeline::setListener(const std::function<void(const Pipeline&)>& value) {
+        try {
+            std::shared_ptr<const std::function<void(const Pipeline&)>> previous = {};
+
+            {
+                std::lock_guard<std::mutex> lock(listenerMutex);
+                previous = std::move(listener);
+                if (value) {
+                    listener = std::make_shared<const std::function<void(const Pipeline&)>>(value);
+                }
+            }
+
+            // calls already running keep their own reference, wait for them so a detached listener is never running
+            while (previous && previous.use_count() > 1) {
+                std::this_thread::yield();
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void Pipeline::notify(const Pipeline& value) {
+        try {
+            std::shared_ptr<const std::function<void(const Pipeline&)>> current = {};
+
+            {
+                std::lock_guard<std::mutex> lock(listenerMutex);
+                current = listener;
+            }
+
+            if (current) {
+                (*current)(value);
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
     EXQUDENS_VULKAN_INLINE Pipeline::Builder Pipeline::builder(Pipeline& object) {
         return Builder(object);
     }
 
+    EXQUDENS_VULKAN_INLINE bool Pipeline::usesSharedSpecialization(const VULKAN_HPP_NAMESPACE::PipelineShaderStageCreateInfo& stage) const {
+        if (stage.pSpecializationInfo == nullptr) {
+            return false;
+        }
+
+        // the stage may live in another object, so the range is checked before the pointers are subtracted
+        const VULKAN_HPP_NAMESPACE::PipelineShaderStageCreateInfo* begin = shaderStageCreateInfos.data();
+        const VULKAN_HPP_NAMESPACE::PipelineShaderStageCreateInfo* end = begin + shaderStageCreateInfos.size();
+        std::less<const VULKAN_HPP_NAMESPACE::PipelineShaderStageCreateInfo*> less = {};
+
+        if (begin == nullptr || less(&stage, begin) || !less(&stage, end)) {
+            return false;
+        }
+
+        size_t index = static_cast<size_t>(&stage - begin);
+        return index < sharedSpecializationStages.size() && sharedSpecializationStages.at(index);
+    }
+
     EXQUDENS_VULKAN_INLINE void Pipeline::clear() {
         try {
             shaderStageCreateInfos.clear();
+            specializationMapEntries.clear();
+            specializationData.clear();
+            specializationInfo.reset();
+            sharedSpecializationStages.clear();
             vertexInputStateCreateInfo.reset();
             inputAssemblyStateCreateInfo.reset();
             viewports.clear();
@@ -141,7 +280,11 @@ namespace exqudens::vulkan {
             depthStencilStateCreateInfo.reset();
             tessellationStateCreateInfo.reset();
             renderingCreateInfo.reset();
+            libraryCreateInfo.reset();
+            libraries.clear();
+            libraryLinkCreateInfo.reset();
             graphicsCreateInfo.reset();
+            computeCreateInfo.reset();
             target.clear();
         } catch (...) {
             std::throw_with_nested(std::runtime_error(CALL_INFO));
@@ -170,6 +313,16 @@ namespace exqudens::vulkan {
         return *this;
     }
 
+    EXQUDENS_VULKAN_INLINE Pipeline::Builder& Pipeline::Builder::setSpecializationMapEntries(const std::vector<VULKAN_HPP_NAMESPACE::SpecializationMapEntry>& value) {
+        object.specializationMapEntries = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE Pipeline::Builder& Pipeline::Builder::setSpecializationData(const std::vector<uint8_t>& value) {
+        object.specializationData = value;
+        return *this;
+    }
+
     EXQUDENS_VULKAN_INLINE Pipeline::Builder& Pipeline::Builder::setVertexInputStateCreateInfoBindings(const std::vector<VULKAN_HPP_NAMESPACE::VertexInputBindingDescription>& value) {
         object.vertexInputStateCreateInfoBindings = value;
         return *this;
@@ -270,16 +423,57 @@ namespace exqudens::vulkan {
         return *this;
     }
 
+    EXQUDENS_VULKAN_INLINE Pipeline::Builder& Pipeline::Builder::setLibraryFlags(const VULKAN_HPP_NAMESPACE::GraphicsPipelineLibraryFlagsEXT& value) {
+        object.libraryCreateInfo = VULKAN_HPP_NAMESPACE::GraphicsPipelineLibraryCreateInfoEXT().setFlags(value);
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE Pipeline::Builder& Pipeline::Builder::setLibraries(const std::vector<VULKAN_HPP_NAMESPACE::Pipeline>& value) {
+        object.libraries = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE Pipeline::Builder& Pipeline::Builder::addLibrary(const VULKAN_HPP_NAMESPACE::Pipeline& value) {
+        object.libraries.emplace_back(value);
+        return *this;
+    }
+
     EXQUDENS_VULKAN_INLINE Pipeline::Builder& Pipeline::Builder::setGraphicsCreateInfo(const VULKAN_HPP_NAMESPACE::GraphicsPipelineCreateInfo& value) {
         object.graphicsCreateInfo = value;
         return *this;
     }
 
-    EXQUDENS_VULKAN_INLINE Pipeline& Pipeline::Builder::build(
-        VULKAN_HPP_NAMESPACE::raii::Device& device,
-        VULKAN_HPP_NAMESPACE::raii::PipelineCache& cache
-    ) {
+    EXQUDENS_VULKAN_INLINE Pipeline::Builder& Pipeline::Builder::setComputeCreateInfo(const VULKAN_HPP_NAMESPACE::ComputePipelineCreateInfo& value) {
+        object.computeCreateInfo = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE Pipeline& Pipeline::Builder::prepare() {
         try {
+            if (object.graphicsCreateInfo.has_value() && object.computeCreateInfo.has_value()) {
+                throw std::runtime_error(CALL_INFO + ": 'graphicsCreateInfo' and 'computeCreateInfo' are both set");
+            }
+
+            object.sharedSpecializationStages.resize(object.shaderStageCreateInfos.size(), false);
+
+            if (!object.specializationMapEntries.empty()) {
+                object.specializationInfo = VULKAN_HPP_NAMESPACE::SpecializationInfo()
+                .setMapEntries(object.specializationMapEntries)
+                .setDataSize(object.specializationData.size())
+                .setPData(object.specializationData.empty() ? nullptr : object.specializationData.data());
+            } else {
+                object.specializationInfo.reset();
+            }
+
+            // stages with their own specialization info keep it, shared ones follow this object's info
+            for (size_t i = 0; i < object.shaderStageCreateInfos.size(); i++) {
+                VULKAN_HPP_NAMESPACE::PipelineShaderStageCreateInfo& stage = object.shaderStageCreateInfos.at(i);
+                if (stage.pSpecializationInfo == nullptr || object.sharedSpecializationStages.at(i)) {
+                    stage.pSpecializationInfo = object.specializationInfo.has_value() ? &object.specializationInfo.value() : nullptr;
+                    object.sharedSpecializationStages.at(i) = object.specializationInfo.has_value();
+                }
+            }
+
             if (!object.viewports.empty() || !object.scissors.empty()) {
                 if (!object.viewportStateCreateInfo.has_value()) {
                     object.viewportStateCreateInfo = VULKAN_HPP_NAMESPACE::PipelineViewportStateCreateInfo();
@@ -328,9 +522,62 @@ namespace exqudens::vulkan {
                 object.graphicsCreateInfo.value().pDynamicState = object.dynamicStateCreateInfo.has_value() ? &object.dynamicStateCreateInfo.value() : nullptr;
                 object.graphicsCreateInfo.value().pDepthStencilState = object.depthStencilStateCreateInfo.has_value() ? &object.depthStencilStateCreateInfo.value() : nullptr;
                 object.graphicsCreateInfo.value().pTessellationState = object.tessellationStateCreateInfo.has_value() ? &object.tessellationStateCreateInfo.value() : nullptr;
-                object.graphicsCreateInfo.value().pNext = object.renderingCreateInfo.has_value() ? &object.renderingCreateInfo.value() : nullptr;
 
+                if (!object.libraries.empty()) {
+                    object.libraryLinkCreateInfo = VULKAN_HPP_NAMESPACE::PipelineLibraryCreateInfoKHR().setLibraries(object.libraries);
+                } else {
+                    object.libraryLinkCreateInfo.reset();
+                }
+
+                if (object.libraryCreateInfo.has_value()) {
+                    object.graphicsCreateInfo.value().flags |= VULKAN_HPP_NAMESPACE::PipelineCreateFlagBits::eLibraryKHR;
+                }
+
+                // rendering -> graphics pipeline library -> pipeline library
+                const void* next = nullptr;
+                if (object.libraryLinkCreateInfo.has_value()) {
+                    object.libraryLinkCreateInfo.value().pNext = next;
+                    next = &object.libraryLinkCreateInfo.value();
+                }
+                if (object.libraryCreateInfo.has_value()) {
+                    object.libraryCreateInfo.value().pNext = next;
+                    next = &object.libraryCreateInfo.value();
+                }
+                if (object.renderingCreateInfo.has_value()) {
+                    object.renderingCreateInfo.value().pNext = next;
+                    next = &object.renderingCreateInfo.value();
+                }
+                object.graphicsCreateInfo.value().pNext = next;
+            }
+
+            if (object.computeCreateInfo.has_value()) {
+                if (object.shaderStageCreateInfos.size() != 1) {
+                    throw std::runtime_error(CALL_INFO + ": compute pipeline requires exactly one shader stage");
+                }
+                object.computeCreateInfo.value().stage = object.shaderStageCreateInfos.front();
+            }
+
+            return object;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE Pipeline& Pipeline::Builder::build(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        VULKAN_HPP_NAMESPACE::raii::PipelineCache& cache
+    ) {
+        try {
+            prepare();
+
+            if (object.graphicsCreateInfo.has_value()) {
                 object.target = device.createGraphicsPipeline(cache, object.graphicsCreateInfo.value());
+            } else if (object.computeCreateInfo.has_value()) {
+                object.target = device.createComputePipeline(cache, object.computeCreateInfo.value());
+            }
+
+            if (*object.target) {
+                notify(object);
             }
 
             return object;
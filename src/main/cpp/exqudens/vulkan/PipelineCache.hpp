@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstdint>
 #include <optional>
+#include <string>
+#include <vector>
 
 #include <vulkan/vulkan_raii.hpp>
 
@@ -12,11 +15,21 @@ namespace exqudens::vulkan {
 
         class Builder;
 
+        std::optional<std::string> file = {};
+        std::vector<uint8_t> initialData = {};
+        bool readFile = false;
         std::optional<VULKAN_HPP_NAMESPACE::PipelineCacheCreateInfo> createInfo = {};
         VULKAN_HPP_NAMESPACE::raii::PipelineCache target = nullptr;
 
+        static bool isCompatible(
+            const std::vector<uint8_t>& data,
+            const VULKAN_HPP_NAMESPACE::PhysicalDeviceProperties& properties
+        );
+
         static Builder builder(PipelineCache& object);
 
+        void save(std::optional<std::string> path = {});
+
         void clear();
 
         void clearAndRelease();
@@ -32,8 +45,19 @@ namespace exqudens::vulkan {
 
             explicit Builder(PipelineCache& object);
 
+            Builder& setFile(const std::optional<std::string>& value);
+
+            Builder& setInitialData(const std::vector<uint8_t>& value);
+
+            Builder& setReadFile(bool value);
+
             Builder& setCreateInfo(const VULKAN_HPP_NAMESPACE::PipelineCacheCreateInfo& value);
 
+            PipelineCache& build(
+                VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice,
+                VULKAN_HPP_NAMESPACE::raii::Device& device
+            );
+
             PipelineCache& build(
                 VULKAN_HPP_NAMESPACE::raii::Device& device
             );
@@ -44,20 +68,88 @@ namespace exqudens::vulkan {
 
 // implementation ---
 
+#include <cstring>
 #include <string>
 #include <filesystem>
 #include <stdexcept>
+#include <fstream>
 
 #define CALL_INFO std::string(__FUNCTION__) + " (" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
 
 namespace exqudens::vulkan {
 
+    EXQUDENS_VULKAN_INLINE bool PipelineCache::isCompatible(
+        const std::vector<uint8_t>& data,
+        const VULKAN_HPP_NAMESPACE::PhysicalDeviceProperties& properties
+    ) {
+        try {
+            VkPipelineCacheHeaderVersionOne header = {};
+
+            if (data.size() < sizeof(header)) {
+                return false;
+            }
+
+            std::memcpy(&header, data.data(), sizeof(header));
+
+            return header.headerSize >= sizeof(header)
+                && header.headerSize <= data.size()
+                && header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+                && header.vendorID == properties.vendorID
+                && header.deviceID == properties.deviceID
+                && std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID.data(), VK_UUID_SIZE) == 0;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
     EXQUDENS_VULKAN_INLINE PipelineCache::Builder PipelineCache::builder(PipelineCache& object) {
         return Builder(object);
     }
 
+    EXQUDENS_VULKAN_INLINE void PipelineCache::save(std::optional<std::string> path) {
+        try {
+            if (!path.has_value()) {
+                path = file;
+            }
+
+            if (!path.has_value()) {
+                throw std::runtime_error(CALL_INFO + ": 'path' is not initialized");
+            }
+
+            std::vector<uint8_t> data = target.getData();
+
+            // write next to the target and rename, so a crash never leaves a truncated cache behind
+            std::filesystem::path filePath(path.value());
+            std::filesystem::path tmpFilePath(path.value() + ".tmp");
+
+            if (filePath.has_parent_path()) {
+                std::filesystem::create_directories(filePath.parent_path());
+            }
+
+            std::ofstream fileStream(tmpFilePath, std::ios::binary | std::ios::trunc);
+
+            if (!fileStream.is_open()) {
+                throw std::runtime_error(CALL_INFO + ": failed to open file " + tmpFilePath.generic_string());
+            }
+
+            fileStream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            fileStream.close();
+
+            if (!fileStream) {
+                throw std::runtime_error(CALL_INFO + ": failed to write file " + tmpFilePath.generic_string());
+            }
+
+            std::filesystem::rename(tmpFilePath, filePath);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
     EXQUDENS_VULKAN_INLINE void PipelineCache::clear() {
         try {
+            file.reset();
+            initialData.clear();
+            readFile = false;
             createInfo.reset();
             target.clear();
         } catch (...) {
@@ -77,11 +169,54 @@ namespace exqudens::vulkan {
     EXQUDENS_VULKAN_INLINE PipelineCache::Builder::Builder(PipelineCache& object): object(object) {
     }
 
+    EXQUDENS_VULKAN_INLINE PipelineCache::Builder& PipelineCache::Builder::setFile(const std::optional<std::string>& value) {
+        object.file = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineCache::Builder& PipelineCache::Builder::setInitialData(const std::vector<uint8_t>& value) {
+        object.initialData = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineCache::Builder& PipelineCache::Builder::setReadFile(bool value) {
+        object.readFile = value;
+        return *this;
+    }
+
     EXQUDENS_VULKAN_INLINE PipelineCache::Builder& PipelineCache::Builder::setCreateInfo(const VULKAN_HPP_NAMESPACE::PipelineCacheCreateInfo& value) {
         object.createInfo = value;
         return *this;
     }
 
+    EXQUDENS_VULKAN_INLINE PipelineCache& PipelineCache::Builder::build(
+        VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice,
+        VULKAN_HPP_NAMESPACE::raii::Device& device
+    ) {
+        try {
+            if (object.readFile && object.file.has_value() && std::filesystem::exists(object.file.value())) {
+                std::ifstream fileStream(object.file.value(), std::ios::ate | std::ios::binary);
+
+                if (fileStream.is_open()) {
+                    std::vector<uint8_t> buffer(static_cast<size_t>(fileStream.tellg()));
+                    fileStream.seekg(0, std::ios::beg);
+                    fileStream.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+                    fileStream.close();
+                    object.initialData = buffer;
+                }
+            }
+
+            // data from another driver, device or a corrupted file starts an empty cache instead
+            if (!object.initialData.empty() && !isCompatible(object.initialData, physicalDevice.getProperties())) {
+                object.initialData.clear();
+            }
+
+            return build(device);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
     EXQUDENS_VULKAN_INLINE PipelineCache& PipelineCache::Builder::build(
         VULKAN_HPP_NAMESPACE::raii::Device& device
     ) {
@@ -90,7 +225,20 @@ namespace exqudens::vulkan {
                 object.createInfo = VULKAN_HPP_NAMESPACE::PipelineCacheCreateInfo();
             }
 
-            object.target = device.createPipelineCache(object.createInfo.value());
+            object.createInfo.value().initialDataSize = object.initialData.size();
+            object.createInfo.value().pInitialData = object.initialData.empty() ? nullptr : object.initialData.data();
+
+            try {
+                object.target = device.createPipelineCache(object.createInfo.value());
+            } catch (const VULKAN_HPP_NAMESPACE::SystemError&) {
+                if (object.initialData.empty()) {
+                    throw;
+                }
+                object.initialData.clear();
+                object.createInfo.value().initialDataSize = 0;
+                object.createInfo.value().pInitialData = nullptr;
+                object.target = device.createPipelineCache(object.createInfo.value());
+            }
 
             return object;
         } catch (...) {
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "exqudens/vulkan/export.hpp"
+#include "exqudens/vulkan/Pipeline.hpp"
+
+namespace exqudens::vulkan {
+
+    struct EXQUDENS_VULKAN_EXPORT PipelineCompiler {
+
+        class Builder;
+
+        std::optional<uint32_t> threadCount = {};
+        std::vector<std::thread> threads = {};
+        std::deque<std::function<void()>> tasks = {};
+        std::mutex mutex = {};
+        std::condition_variable condition = {};
+        bool stopping = false;
+
+        static Builder builder(PipelineCompiler& object);
+
+        ~PipelineCompiler();
+
+        std::future<void> submit(std::function<void()> task);
+
+        std::future<void> compile(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            VULKAN_HPP_NAMESPACE::raii::PipelineCache& cache,
+            Pipeline& pipeline
+        );
+
+        std::future<void> compileBatch(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            VULKAN_HPP_NAMESPACE::raii::PipelineCache& cache,
+            const std::vector<Pipeline*>& pipelines
+        );
+
+        void run();
+
+        void clear();
+
+    };
+
+    class EXQUDENS_VULKAN_EXPORT PipelineCompiler::Builder {
+
+        private:
+
+            PipelineCompiler& object;
+
+        public:
+
+            explicit Builder(PipelineCompiler& object);
+
+            Builder& setThreadCount(uint32_t value);
+
+            PipelineCompiler& build();
+
+    };
+
+}
+
+// implementation ---
+
+#include <memory>
+#include <utility>
+#include <string>
+#include <filesystem>
+#include <stdexcept>
+
+#define CALL_INFO std::string(__FUNCTION__) + " (" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::vulkan {
+
+    EXQUDENS_VULKAN_INLINE PipelineCompiler::Builder PipelineCompiler::builder(PipelineCompiler& object) {
+        return Builder(object);
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineCompiler::~PipelineCompiler() {
+        try {
+            clear();
+        } catch (...) {
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE std::future<void> PipelineCompiler::submit(std::function<void()> task) {
+        try {
+            std::shared_ptr<std::packaged_task<void()>> packagedTask = std::make_shared<std::packaged_task<void()>>(std::move(task));
+            std::future<void> result = packagedTask->get_future();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+
+                if (threads.empty()) {
+                    throw std::runtime_error(CALL_INFO + ": compiler is not built");
+                }
+
+                tasks.emplace_back([packagedTask]() { (*packagedTask)(); });
+            }
+
+            condition.notify_one();
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE std::future<void> PipelineCompiler::compile(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        VULKAN_HPP_NAMESPACE::raii::PipelineCache& cache,
+        Pipeline& pipeline
+    ) {
+        try {
+            // the pipeline cache is internally synchronized, so every worker can share it
+            return submit([&device, &cache, &pipeline]() {
+                Pipeline::builder(pipeline).build(device, cache);
+            });
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE std::future<void> PipelineCompiler::compileBatch(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        VULKAN_HPP_NAMESPACE::raii::PipelineCache& cache,
+        const std::vector<Pipeline*>& pipelines
+    ) {
+        try {
+            return submit([&device, &cache, pipelines]() {
+                std::vector<VULKAN_HPP_NAMESPACE::GraphicsPipelineCreateInfo> createInfos = {};
+
+                for (Pipeline* pipeline : pipelines) {
+                    Pipeline::builder(*pipeline).prepare();
+
+                    if (!pipeline->graphicsCreateInfo.has_value()) {
+                        throw std::runtime_error(CALL_INFO + ": 'graphicsCreateInfo' is not initialized");
+                    }
+
+                    createInfos.emplace_back(pipeline->graphicsCreateInfo.value());
+                }
+
+                VULKAN_HPP_NAMESPACE::raii::Pipelines targets(device, cache, createInfos);
+
+                for (size_t i = 0; i < pipelines.size(); i++) {
+                    pipelines.at(i)->target = std::move(targets.at(i));
+
+                    Pipeline::notify(*pipelines.at(i));
+                }
+            });
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void PipelineCompiler::run() {
+        while (true) {
+            std::function<void()> task;
+
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+
+                if (tasks.empty()) {
+                    return;
+                }
+
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+
+            // exceptions end up in the future of the task
+            task();
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void PipelineCompiler::clear() {
+        try {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+
+            condition.notify_all();
+
+            for (std::thread& thread : threads) {
+                if (thread.joinable()) {
+                    thread.join();
+                }
+            }
+
+            threads.clear();
+            tasks.clear();
+            threadCount.reset();
+            stopping = false;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineCompiler::Builder::Builder(PipelineCompiler& object): object(object) {
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineCompiler::Builder& PipelineCompiler::Builder::setThreadCount(uint32_t value) {
+        object.threadCount = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineCompiler& PipelineCompiler::Builder::build() {
+        try {
+            if (!object.threads.empty()) {
+                throw std::runtime_error(CALL_INFO + ": compiler is already built");
+            }
+
+            if (!object.threadCount.has_value()) {
+                object.threadCount = std::thread::hardware_concurrency();
+            }
+
+            if (object.threadCount.value() == 0) {
+                object.threadCount = 1;
+            }
+
+            object.stopping = false;
+
+            PipelineCompiler* compiler = &object;
+            for (uint32_t i = 0; i < object.threadCount.value(); i++) {
+                object.threads.emplace_back([compiler]() { compiler->run(); });
+            }
+
+            return object;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <optional>
+#include <vector>
 
 #include <vulkan/vulkan_raii.hpp>
 
@@ -12,6 +13,8 @@ namespace exqudens::vulkan {
 
         class Builder;
 
+        std::vector<VULKAN_HPP_NAMESPACE::DescriptorSetLayout> setLayouts = {};
+        std::vector<VULKAN_HPP_NAMESPACE::PushConstantRange> pushConstantRanges = {};
         std::optional<VULKAN_HPP_NAMESPACE::PipelineLayoutCreateInfo> createInfo = {};
         VULKAN_HPP_NAMESPACE::raii::PipelineLayout target = nullptr;
 
@@ -33,6 +36,14 @@ namespace exqudens::vulkan {
 
             explicit Builder(PipelineLayout& object);
 
+            Builder& setSetLayouts(const std::vector<VULKAN_HPP_NAMESPACE::DescriptorSetLayout>& value);
+
+            Builder& addSetLayout(const VULKAN_HPP_NAMESPACE::DescriptorSetLayout& value);
+
+            Builder& setPushConstantRanges(const std::vector<VULKAN_HPP_NAMESPACE::PushConstantRange>& value);
+
+            Builder& addPushConstantRange(const VULKAN_HPP_NAMESPACE::PushConstantRange& value);
+
             Builder& setCreateInfo(const VULKAN_HPP_NAMESPACE::PipelineLayoutCreateInfo& value);
 
             PipelineLayout& build(
@@ -58,6 +69,8 @@ namespace exqudens::vulkan {
 
     EXQUDENS_VULKAN_INLINE void PipelineLayout::clear() {
         try {
+            setLayouts.clear();
+            pushConstantRanges.clear();
             createInfo.reset();
             target.clear();
         } catch (...) {
@@ -77,6 +90,26 @@ namespace exqudens::vulkan {
     EXQUDENS_VULKAN_INLINE PipelineLayout::Builder::Builder(PipelineLayout& object): object(object) {
     }
 
+    EXQUDENS_VULKAN_INLINE PipelineLayout::Builder& PipelineLayout::Builder::setSetLayouts(const std::vector<VULKAN_HPP_NAMESPACE::DescriptorSetLayout>& value) {
+        object.setLayouts = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineLayout::Builder& PipelineLayout::Builder::addSetLayout(const VULKAN_HPP_NAMESPACE::DescriptorSetLayout& value) {
+        object.setLayouts.emplace_back(value);
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineLayout::Builder& PipelineLayout::Builder::setPushConstantRanges(const std::vector<VULKAN_HPP_NAMESPACE::PushConstantRange>& value) {
+        object.pushConstantRanges = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineLayout::Builder& PipelineLayout::Builder::addPushConstantRange(const VULKAN_HPP_NAMESPACE::PushConstantRange& value) {
+        object.pushConstantRanges.emplace_back(value);
+        return *this;
+    }
+
     EXQUDENS_VULKAN_INLINE PipelineLayout::Builder& PipelineLayout::Builder::setCreateInfo(const VULKAN_HPP_NAMESPACE::PipelineLayoutCreateInfo& value) {
         object.createInfo = value;
         return *this;
@@ -90,6 +123,17 @@ namespace exqudens::vulkan {
                 object.createInfo = VULKAN_HPP_NAMESPACE::PipelineLayoutCreateInfo();
             }
 
+            // a create info with its own arrays is kept as is
+            if (!object.setLayouts.empty()) {
+                object.createInfo.value().setLayoutCount = static_cast<uint32_t>(object.setLayouts.size());
+                object.createInfo.value().pSetLayouts = object.setLayouts.data();
+            }
+
+            if (!object.pushConstantRanges.empty()) {
+                object.createInfo.value().pushConstantRangeCount = static_cast<uint32_t>(object.pushConstantRanges.size());
+                object.createInfo.value().pPushConstantRanges = object.pushConstantRanges.data();
+            }
+
             object.target = device.createPipelineLayout(object.createInfo.value());
 
             return object;
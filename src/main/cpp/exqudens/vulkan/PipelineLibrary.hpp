@@ -0,0 +1,425 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <future>
+#include <mutex>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "exqudens/vulkan/export.hpp"
+#include "exqudens/vulkan/Pipeline.hpp"
+#include "exqudens/vulkan/PipelineStateKey.hpp"
+#include "exqudens/vulkan/PipelineCompiler.hpp"
+
+namespace exqudens::vulkan {
+
+    struct EXQUDENS_VULKAN_EXPORT PipelineLibrary {
+
+        class Builder;
+
+        struct Part {
+            Pipeline pipeline = {};
+            // copies of the stage owned specialization infos, a part never points into the pipeline it came from
+            std::vector<std::vector<VULKAN_HPP_NAMESPACE::SpecializationMapEntry>> specializationMapEntries = {};
+            std::vector<std::vector<uint8_t>> specializationData = {};
+            std::vector<VULKAN_HPP_NAMESPACE::SpecializationInfo> specializationInfos = {};
+        };
+
+        std::optional<bool> retainLinkTimeOptimizationInfo = {};
+        std::unordered_map<PipelineStateKey, std::unique_ptr<Part>, PipelineStateKey::Hash> parts = {};
+        std::mutex mutex = {};
+
+        static Builder builder(PipelineLibrary& object);
+
+        Pipeline& part(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            VULKAN_HPP_NAMESPACE::raii::PipelineCache& cache,
+            const Pipeline& pipeline,
+            const VULKAN_HPP_NAMESPACE::GraphicsPipelineLibraryFlagBitsEXT& flag
+        );
+
+        // the four parts in link order
+        std::vector<VULKAN_HPP_NAMESPACE::Pipeline> libraries(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            VULKAN_HPP_NAMESPACE::raii::PipelineCache& cache,
+            const Pipeline& pipeline
+        );
+
+        VULKAN_HPP_NAMESPACE::raii::Pipeline link(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            VULKAN_HPP_NAMESPACE::raii::PipelineCache& cache,
+            const Pipeline& pipeline,
+            bool optimize = false
+        );
+
+        static VULKAN_HPP_NAMESPACE::raii::Pipeline link(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            VULKAN_HPP_NAMESPACE::raii::PipelineCache& cache,
+            const std::vector<VULKAN_HPP_NAMESPACE::Pipeline>& values,
+            const VULKAN_HPP_NAMESPACE::PipelineLayout& layout,
+            bool optimize
+        );
+
+        // parts are looked up or compiled on the calling thread, only the optimized link runs on the compiler,
+        // so 'pipeline' may go away on return but 'device', 'cache' and this library must outlive the future
+        std::future<VULKAN_HPP_NAMESPACE::raii::Pipeline> linkAsync(
+            PipelineCompiler& compiler,
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            VULKAN_HPP_NAMESPACE::raii::PipelineCache& cache,
+            const Pipeline& pipeline
+        );
+
+        size_t size();
+
+        void clear();
+
+        void clearAndRelease();
+
+    };
+
+    class EXQUDENS_VULKAN_EXPORT PipelineLibrary::Builder {
+
+        private:
+
+            PipelineLibrary& object;
+
+        public:
+
+            explicit Builder(PipelineLibrary& object);
+
+            Builder& setRetainLinkTimeOptimizationInfo(bool value);
+
+            PipelineLibrary& build();
+
+    };
+
+}
+
+// implementation ---
+
+#include <utility>
+#include <exception>
+#include <string>
+#include <filesystem>
+#include <stdexcept>
+
+#define CALL_INFO std::string(__FUNCTION__) + " (" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::vulkan {
+
+    EXQUDENS_VULKAN_INLINE PipelineLibrary::Builder PipelineLibrary::builder(PipelineLibrary& object) {
+        return Builder(object);
+    }
+
+    EXQUDENS_VULKAN_INLINE Pipeline& PipelineLibrary::part(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        VULKAN_HPP_NAMESPACE::raii::PipelineCache& cache,
+        const Pipeline& pipeline,
+        const VULKAN_HPP_NAMESPACE::GraphicsPipelineLibraryFlagBitsEXT& flag
+    ) {
+        try {
+            if (!pipeline.graphicsCreateInfo.has_value()) {
+                throw std::runtime_error(CALL_INFO + ": 'graphicsCreateInfo' is not initialized");
+            }
+
+            PipelineStateKey key = PipelineStateKey::from(pipeline).part(flag);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto it = parts.find(key);
+                if (it != parts.end()) {
+                    return it->second->pipeline;
+                }
+            }
+
+            const VULKAN_HPP_NAMESPACE::GraphicsPipelineCreateInfo& source = pipeline.graphicsCreateInfo.value();
+            std::unique_ptr<Part> value = std::make_unique<Part>();
+            Pipeline::Builder builder = Pipeline::builder(value->pipeline);
+
+            // stages on the shared info are re-pointed by 'prepare()', stages with their own info get a copy,
+            // reserved up front so the copied infos keep their addresses
+            value->specializationInfos.reserve(pipeline.shaderStageCreateInfos.size());
+            auto addStage = [&pipeline, &builder, &value](const VULKAN_HPP_NAMESPACE::PipelineShaderStageCreateInfo& stage) {
+                VULKAN_HPP_NAMESPACE::PipelineShaderStageCreateInfo copy = stage;
+
+                if (pipeline.usesSharedSpecialization(stage)) {
+                    copy.pSpecializationInfo = nullptr;
+                } else if (stage.pSpecializationInfo != nullptr) {
+                    const VULKAN_HPP_NAMESPACE::SpecializationInfo& info = *stage.pSpecializationInfo;
+                    const uint8_t* data = static_cast<const uint8_t*>(info.pData);
+                    std::vector<VULKAN_HPP_NAMESPACE::SpecializationMapEntry>& entries = value->specializationMapEntries.emplace_back(info.pMapEntries, info.pMapEntries + info.mapEntryCount);
+                    std::vector<uint8_t>& bytes = value->specializationData.emplace_back(data, data + (data == nullptr ? 0 : info.dataSize));
+                    copy.pSpecializationInfo = &value->specializationInfos.emplace_back(
+                        VULKAN_HPP_NAMESPACE::SpecializationInfo()
+                        .setMapEntries(entries)
+                        .setDataSize(bytes.size())
+                        .setPData(bytes.empty() ? nullptr : bytes.data())
+                    );
+                }
+
+                builder.addShaderStageCreateInfo(copy);
+            };
+
+            VULKAN_HPP_NAMESPACE::GraphicsPipelineCreateInfo createInfo = VULKAN_HPP_NAMESPACE::GraphicsPipelineCreateInfo()
+            .setFlags(source.flags);
+
+            if (retainLinkTimeOptimizationInfo.value_or(true)) {
+                createInfo.flags |= VULKAN_HPP_NAMESPACE::PipelineCreateFlagBits::eRetainLinkTimeOptimizationInfoEXT;
+            }
+
+            builder.setLibraryFlags(flag);
+            builder.setDynamicStates(pipeline.dynamicStates);
+            if (pipeline.dynamicStateCreateInfo.has_value()) {
+                builder.setDynamicStateCreateInfo(pipeline.dynamicStateCreateInfo.value());
+            }
+
+            switch (flag) {
+                case VULKAN_HPP_NAMESPACE::GraphicsPipelineLibraryFlagBitsEXT::eVertexInputInterface:
+                    builder.setVertexInputStateCreateInfoBindings(pipeline.vertexInputStateCreateInfoBindings);
+                    builder.setVertexInputStateCreateInfoAttributes(pipeline.vertexInputStateCreateInfoAttributes);
+                    if (pipeline.vertexInputStateCreateInfo.has_value()) {
+                        builder.setVertexInputStateCreateInfo(pipeline.vertexInputStateCreateInfo.value());
+                    }
+                    if (pipeline.inputAssemblyStateCreateInfo.has_value()) {
+                        builder.setInputAssemblyStateCreateInfo(pipeline.inputAssemblyStateCreateInfo.value());
+                    }
+                    break;
+                case VULKAN_HPP_NAMESPACE::GraphicsPipelineLibraryFlagBitsEXT::ePreRasterizationShaders:
+                    createInfo.setLayout(source.layout).setRenderPass(source.renderPass).setSubpass(source.subpass);
+                    for (const VULKAN_HPP_NAMESPACE::PipelineShaderStageCreateInfo& stage : pipeline.shaderStageCreateInfos) {
+                        if (stage.stage != VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eFragment) {
+                            addStage(stage);
+                        }
+                    }
+                    builder.setSpecializationMapEntries(pipeline.specializationMapEntries);
+                    builder.setSpecializationData(pipeline.specializationData);
+                    builder.setViewports(pipeline.viewports);
+                    builder.setScissors(pipeline.scissors);
+                    if (pipeline.viewportStateCreateInfo.has_value()) {
+                        builder.setViewportStateCreateInfo(pipeline.viewportStateCreateInfo.value());
+                    }
+                    if (pipeline.rasterizationStateCreateInfo.has_value()) {
+                        builder.setRasterizationStateCreateInfo(pipeline.rasterizationStateCreateInfo.value());
+                    }
+                    if (pipeline.tessellationStateCreateInfo.has_value()) {
+                        builder.setTessellationStateCreateInfo(pipeline.tessellationStateCreateInfo.value());
+                    }
+                    if (pipeline.renderingCreateInfo.has_value()) {
+                        builder.setRenderingCreateInfo(pipeline.renderingCreateInfo.value());
+                    }
+                    break;
+                case VULKAN_HPP_NAMESPACE::GraphicsPipelineLibraryFlagBitsEXT::eFragmentShader:
+                    createInfo.setLayout(source.layout).setRenderPass(source.renderPass).setSubpass(source.subpass);
+                    for (const VULKAN_HPP_NAMESPACE::PipelineShaderStageCreateInfo& stage : pipeline.shaderStageCreateInfos) {
+                        if (stage.stage == VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eFragment) {
+                            addStage(stage);
+                        }
+                    }
+                    builder.setSpecializationMapEntries(pipeline.specializationMapEntries);
+                    builder.setSpecializationData(pipeline.specializationData);
+                    if (pipeline.depthStencilStateCreateInfo.has_value()) {
+                        builder.setDepthStencilStateCreateInfo(pipeline.depthStencilStateCreateInfo.value());
+                    }
+                    if (pipeline.multisampleStateCreateInfo.has_value()) {
+                        builder.setMultisampleStateCreateInfo(pipeline.multisampleStateCreateInfo.value());
+                    }
+                    if (pipeline.renderingCreateInfo.has_value()) {
+                        builder.setRenderingCreateInfo(pipeline.renderingCreateInfo.value());
+                    }
+                    break;
+                case VULKAN_HPP_NAMESPACE::GraphicsPipelineLibraryFlagBitsEXT::eFragmentOutputInterface:
+                    createInfo.setRenderPass(source.renderPass).setSubpass(source.subpass);
+                    builder.setColorBlendAttachmentStates(pipeline.colorBlendAttachmentStates);
+                    if (pipeline.colorBlendStateCreateInfo.has_value()) {
+                        builder.setColorBlendStateCreateInfo(pipeline.colorBlendStateCreateInfo.value());
+                    }
+                    if (pipeline.multisampleStateCreateInfo.has_value()) {
+                        builder.setMultisampleStateCreateInfo(pipeline.multisampleStateCreateInfo.value());
+                    }
+                    if (pipeline.renderingCreateInfo.has_value()) {
+                        builder.setRenderingCreateInfo(pipeline.renderingCreateInfo.value());
+                    }
+                    break;
+                default:
+                    throw std::runtime_error(CALL_INFO + ": unsupported library part");
+            }
+
+            builder.setGraphicsCreateInfo(createInfo);
+
+            // compiled outside the lock, a part compiled concurrently by another thread wins and this one is dropped
+            builder.build(device, cache);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = parts.emplace(key, std::move(value)).first;
+            return it->second->pipeline;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE std::vector<VULKAN_HPP_NAMESPACE::Pipeline> PipelineLibrary::libraries(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        VULKAN_HPP_NAMESPACE::raii::PipelineCache& cache,
+        const Pipeline& pipeline
+    ) {
+        try {
+            std::vector<VULKAN_HPP_NAMESPACE::GraphicsPipelineLibraryFlagBitsEXT> flags = {
+                VULKAN_HPP_NAMESPACE::GraphicsPipelineLibraryFlagBitsEXT::eVertexInputInterface,
+                VULKAN_HPP_NAMESPACE::GraphicsPipelineLibraryFlagBitsEXT::ePreRasterizationShaders,
+                VULKAN_HPP_NAMESPACE::GraphicsPipelineLibraryFlagBitsEXT::eFragmentShader,
+                VULKAN_HPP_NAMESPACE::GraphicsPipelineLibraryFlagBitsEXT::eFragmentOutputInterface
+            };
+
+            std::vector<VULKAN_HPP_NAMESPACE::Pipeline> result = {};
+
+            for (const VULKAN_HPP_NAMESPACE::GraphicsPipelineLibraryFlagBitsEXT& flag : flags) {
+                result.emplace_back(*part(device, cache, pipeline, flag).target);
+            }
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE VULKAN_HPP_NAMESPACE::raii::Pipeline PipelineLibrary::link(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        VULKAN_HPP_NAMESPACE::raii::PipelineCache& cache,
+        const Pipeline& pipeline,
+        bool optimize
+    ) {
+        try {
+            VULKAN_HPP_NAMESPACE::raii::Pipeline result = link(device, cache, libraries(device, cache, pipeline), pipeline.graphicsCreateInfo.value().layout, optimize);
+
+            // the recorder skips parts and links, it keeps the complete description they came from instead
+            Pipeline::notify(pipeline);
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE VULKAN_HPP_NAMESPACE::raii::Pipeline PipelineLibrary::link(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        VULKAN_HPP_NAMESPACE::raii::PipelineCache& cache,
+        const std::vector<VULKAN_HPP_NAMESPACE::Pipeline>& values,
+        const VULKAN_HPP_NAMESPACE::PipelineLayout& layout,
+        bool optimize
+    ) {
+        try {
+            Pipeline linked = {};
+            Pipeline::Builder builder = Pipeline::builder(linked);
+
+            for (const VULKAN_HPP_NAMESPACE::Pipeline& library : values) {
+                builder.addLibrary(library);
+            }
+
+            // without link time optimization this is the fast link, cheap enough to do on first use
+            builder.setGraphicsCreateInfo(
+                VULKAN_HPP_NAMESPACE::GraphicsPipelineCreateInfo()
+                .setFlags(optimize ? VULKAN_HPP_NAMESPACE::PipelineCreateFlagBits::eLinkTimeOptimizationEXT : VULKAN_HPP_NAMESPACE::PipelineCreateFlags())
+                .setLayout(layout)
+            );
+            builder.build(device, cache);
+
+            return std::move(linked.target);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE std::future<VULKAN_HPP_NAMESPACE::raii::Pipeline> PipelineLibrary::linkAsync(
+        PipelineCompiler& compiler,
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        VULKAN_HPP_NAMESPACE::raii::PipelineCache& cache,
+        const Pipeline& pipeline
+    ) {
+        try {
+            if (!retainLinkTimeOptimizationInfo.value_or(true)) {
+                throw std::runtime_error(CALL_INFO + ": link time optimization info is not retained");
+            }
+
+            // after a fast link these are all cache hits, the task then only holds handles owned by this library
+            std::vector<VULKAN_HPP_NAMESPACE::Pipeline> values = libraries(device, cache, pipeline);
+            VULKAN_HPP_NAMESPACE::PipelineLayout layout = pipeline.graphicsCreateInfo.value().layout;
+
+            // the caller swaps the result in once the future is ready, on its own thread and after the gpu is done
+            // with the fast linked pipeline, which stays usable meanwhile
+            std::shared_ptr<std::promise<VULKAN_HPP_NAMESPACE::raii::Pipeline>> promise = std::make_shared<std::promise<VULKAN_HPP_NAMESPACE::raii::Pipeline>>();
+            std::future<VULKAN_HPP_NAMESPACE::raii::Pipeline> result = promise->get_future();
+
+            compiler.submit([&device, &cache, values, layout, promise]() {
+                try {
+                    promise->set_value(link(device, cache, values, layout, true));
+                } catch (...) {
+                    promise->set_exception(std::current_exception());
+                }
+            });
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE size_t PipelineLibrary::size() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            return parts.size();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void PipelineLibrary::clear() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            parts.clear();
+            retainLinkTimeOptimizationInfo.reset();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void PipelineLibrary::clearAndRelease() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto& [key, value] : parts) {
+                value->pipeline.clearAndRelease();
+            }
+            parts.clear();
+            retainLinkTimeOptimizationInfo.reset();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineLibrary::Builder::Builder(PipelineLibrary& object): object(object) {
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineLibrary::Builder& PipelineLibrary::Builder::setRetainLinkTimeOptimizationInfo(bool value) {
+        object.retainLinkTimeOptimizationInfo = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineLibrary& PipelineLibrary::Builder::build() {
+        try {
+            if (!object.retainLinkTimeOptimizationInfo.has_value()) {
+                object.retainLinkTimeOptimizationInfo = true;
+            }
+
+            return object;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
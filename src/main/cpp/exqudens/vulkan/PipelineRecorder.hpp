@@ -0,0 +1,805 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <future>
+#include <mutex>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "exqudens/vulkan/export.hpp"
+#include "exqudens/vulkan/Pipeline.hpp"
+#include "exqudens/vulkan/PipelineCompiler.hpp"
+#include "exqudens/vulkan/PipelineStateKey.hpp"
+
+namespace exqudens::vulkan {
+
+    struct EXQUDENS_VULKAN_EXPORT PipelineRecorder {
+
+        class Builder;
+
+        static constexpr uint32_t MANIFEST_MAGIC = 0x4D505845;
+        static constexpr uint32_t MANIFEST_VERSION = 1;
+
+        static constexpr uint32_t PRESENT_COMPUTE = 1u << 0;
+        static constexpr uint32_t PRESENT_VERTEX_INPUT = 1u << 1;
+        static constexpr uint32_t PRESENT_INPUT_ASSEMBLY = 1u << 2;
+        static constexpr uint32_t PRESENT_VIEWPORT = 1u << 3;
+        static constexpr uint32_t PRESENT_RASTERIZATION = 1u << 4;
+        static constexpr uint32_t PRESENT_MULTISAMPLE = 1u << 5;
+        static constexpr uint32_t PRESENT_COLOR_BLEND = 1u << 6;
+        static constexpr uint32_t PRESENT_DYNAMIC = 1u << 7;
+        static constexpr uint32_t PRESENT_DEPTH_STENCIL = 1u << 8;
+        static constexpr uint32_t PRESENT_TESSELLATION = 1u << 9;
+        static constexpr uint32_t PRESENT_RENDERING = 1u << 10;
+
+        struct Record {
+            // handles are replaced by the ids they were registered with
+            PipelineStateKey key = {};
+            uint32_t presence = 0;
+            // per shader stage, pre-rasterization stages first and fragment last
+            std::vector<std::string> names = {};
+            std::vector<std::vector<VULKAN_HPP_NAMESPACE::SpecializationMapEntry>> specializationMapEntries = {};
+            std::vector<std::vector<uint8_t>> specializationData = {};
+            std::vector<VULKAN_HPP_NAMESPACE::Viewport> viewports = {};
+            std::vector<VULKAN_HPP_NAMESPACE::Rect2D> scissors = {};
+        };
+
+        struct Replay {
+            Record record = {};
+            std::vector<VULKAN_HPP_NAMESPACE::SpecializationInfo> specializationInfos = {};
+            std::vector<VULKAN_HPP_NAMESPACE::Format> colorAttachmentFormats = {};
+            Pipeline pipeline = {};
+        };
+
+        std::optional<std::string> file = {};
+        bool readFile = false;
+        bool listen = false;
+        bool attached = false;
+        std::unordered_map<uint64_t, uint64_t> ids = {};
+        std::unordered_map<uint64_t, uint64_t> handles = {};
+        std::vector<Record> records = {};
+        std::unordered_set<PipelineStateKey, PipelineStateKey::Hash> keys = {};
+        std::mutex mutex = {};
+
+        static Builder builder(PipelineRecorder& object);
+
+        ~PipelineRecorder();
+
+        // ids must be stable across launches, so they are derived from a caller chosen name
+        template<typename T>
+        void registerHandle(std::string_view name, const T& handle) {
+            registerHandle(
+                PipelineStateKey::hashBytes(name.data(), name.size()),
+                reinterpret_cast<uint64_t>(static_cast<typename T::CType>(handle))
+            );
+        }
+
+        void registerHandle(uint64_t id, uint64_t handle);
+
+        bool record(const Pipeline& pipeline);
+
+        bool resolve(Replay& replay);
+
+        void attach();
+
+        void detach();
+
+        void save(std::optional<std::string> path = {});
+
+        bool load(std::optional<std::string> path = {});
+
+        std::vector<std::future<void>> warmUp(
+            PipelineCompiler& compiler,
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            VULKAN_HPP_NAMESPACE::raii::PipelineCache& cache
+        );
+
+        size_t size();
+
+        void clear();
+
+        void clearAndRelease();
+
+    };
+
+    class EXQUDENS_VULKAN_EXPORT PipelineRecorder::Builder {
+
+        private:
+
+            PipelineRecorder& object;
+
+        public:
+
+            explicit Builder(PipelineRecorder& object);
+
+            Builder& setFile(const std::optional<std::string>& value);
+
+            Builder& setReadFile(bool value);
+
+            Builder& setListen(bool value);
+
+            PipelineRecorder& build();
+
+    };
+
+}
+
+// implementation ---
+
+#include <cstring>
+#include <array>
+#include <utility>
+#include <filesystem>
+#include <stdexcept>
+#include <fstream>
+
+#define CALL_INFO std::string(__FUNCTION__) + " (" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::vulkan {
+
+    EXQUDENS_VULKAN_INLINE PipelineRecorder::Builder PipelineRecorder::builder(PipelineRecorder& object) {
+        return Builder(object);
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineRecorder::~PipelineRecorder() {
+        try {
+            detach();
+        } catch (...) {
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void PipelineRecorder::registerHandle(uint64_t id, uint64_t handle) {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            // a recreated object replaces the stale handle registered under the same id
+            auto it = handles.find(id);
+            if (it != handles.end()) {
+                ids.erase(it->second);
+            }
+
+            handles[id] = handle;
+            ids[handle] = id;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE bool PipelineRecorder::record(const Pipeline& pipeline) {
+        try {
+            // library parts and links are rebuilt from the complete pipelines they came from
+            if (pipeline.libraryCreateInfo.has_value() || !pipeline.libraries.empty()) {
+                return false;
+            }
+
+            if (!pipeline.graphicsCreateInfo.has_value() && !pipeline.computeCreateInfo.has_value()) {
+                return false;
+            }
+
+            // the key only keeps a hash of the sample mask, a replay could not rebuild the same pipeline
+            if (pipeline.multisampleStateCreateInfo.has_value() && pipeline.multisampleStateCreateInfo.value().pSampleMask != nullptr) {
+                return false;
+            }
+
+            Record value = {};
+            value.key = PipelineStateKey::from(pipeline);
+
+            value.presence |= pipeline.computeCreateInfo.has_value() && !pipeline.graphicsCreateInfo.has_value() ? PRESENT_COMPUTE : 0;
+            value.presence |= pipeline.vertexInputStateCreateInfo.has_value() ? PRESENT_VERTEX_INPUT : 0;
+            value.presence |= pipeline.inputAssemblyStateCreateInfo.has_value() ? PRESENT_INPUT_ASSEMBLY : 0;
+            value.presence |= pipeline.viewportStateCreateInfo.has_value() ? PRESENT_VIEWPORT : 0;
+            value.presence |= pipeline.rasterizationStateCreateInfo.has_value() ? PRESENT_RASTERIZATION : 0;
+            value.presence |= pipeline.multisampleStateCreateInfo.has_value() ? PRESENT_MULTISAMPLE : 0;
+            value.presence |= pipeline.colorBlendStateCreateInfo.has_value() ? PRESENT_COLOR_BLEND : 0;
+            value.presence |= pipeline.dynamicStateCreateInfo.has_value() || !pipeline.dynamicStates.empty() ? PRESENT_DYNAMIC : 0;
+            value.presence |= pipeline.depthStencilStateCreateInfo.has_value() ? PRESENT_DEPTH_STENCIL : 0;
+            value.presence |= pipeline.tessellationStateCreateInfo.has_value() ? PRESENT_TESSELLATION : 0;
+            value.presence |= pipeline.renderingCreateInfo.has_value() ? PRESENT_RENDERING : 0;
+
+            // same order the key lays the stages out in
+            std::vector<const VULKAN_HPP_NAMESPACE::PipelineShaderStageCreateInfo*> stages = {};
+            for (const VULKAN_HPP_NAMESPACE::PipelineShaderStageCreateInfo& stage : pipeline.shaderStageCreateInfos) {
+                if (stage.stage != VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eFragment) {
+                    stages.emplace_back(&stage);
+                }
+            }
+            for (const VULKAN_HPP_NAMESPACE::PipelineShaderStageCreateInfo& stage : pipeline.shaderStageCreateInfos) {
+                if (stage.stage == VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eFragment) {
+                    stages.emplace_back(&stage);
+                }
+            }
+
+            for (const VULKAN_HPP_NAMESPACE::PipelineShaderStageCreateInfo* stage : stages) {
+                value.names.emplace_back(stage->pName == nullptr ? "" : stage->pName);
+
+                // a stage without its own info is pointed at the shared one by 'prepare()'
+                bool shared = pipeline.usesSharedSpecialization(*stage) || (stage->pSpecializationInfo == nullptr && !pipeline.specializationMapEntries.empty());
+                if (shared) {
+                    value.specializationMapEntries.emplace_back(pipeline.specializationMapEntries);
+                    value.specializationData.emplace_back(pipeline.specializationData);
+                } else if (stage->pSpecializationInfo != nullptr) {
+                    const VULKAN_HPP_NAMESPACE::SpecializationInfo& info = *stage->pSpecializationInfo;
+                    const uint8_t* data = static_cast<const uint8_t*>(info.pData);
+                    value.specializationMapEntries.emplace_back(info.pMapEntries, info.pMapEntries + info.mapEntryCount);
+                    value.specializationData.emplace_back(data, data + (data == nullptr ? 0 : info.dataSize));
+                } else {
+                    value.specializationMapEntries.emplace_back();
+                    value.specializationData.emplace_back();
+                }
+            }
+
+            value.viewports = pipeline.viewports;
+            value.scissors = pipeline.scissors;
+            if (pipeline.viewportStateCreateInfo.has_value()) {
+                const VULKAN_HPP_NAMESPACE::PipelineViewportStateCreateInfo& info = pipeline.viewportStateCreateInfo.value();
+                if (value.viewports.empty() && info.pViewports != nullptr) {
+                    value.viewports.assign(info.pViewports, info.pViewports + info.viewportCount);
+                }
+                if (value.scissors.empty() && info.pScissors != nullptr) {
+                    value.scissors.assign(info.pScissors, info.pScissors + info.scissorCount);
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+
+            // a pipeline built from unregistered objects cannot be rebuilt on the next launch
+            auto translate = [this](uint64_t& handle) {
+                if (handle == 0) {
+                    return true;
+                }
+                auto it = ids.find(handle);
+                if (it == ids.end()) {
+                    return false;
+                }
+                handle = it->second;
+                return true;
+            };
+
+            bool translated = translate(value.key.layout) && translate(value.key.renderPass) && translate(value.key.fragmentShader.stage.module);
+            for (uint32_t i = 0; i < value.key.preRasterization.stageCount && translated; i++) {
+                translated = translate(value.key.preRasterization.stages[i].module);
+            }
+
+            if (!translated || !keys.insert(value.key).second) {
+                return false;
+            }
+
+            records.emplace_back(std::move(value));
+
+            return true;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE bool PipelineRecorder::resolve(Replay& replay) {
+        try {
+            const Record& value = replay.record;
+            const PipelineStateKey& key = value.key;
+            Pipeline& pipeline = replay.pipeline;
+
+            auto handleFrom = [this](uint64_t id, uint64_t& handle) {
+                handle = 0;
+                if (id == 0) {
+                    return true;
+                }
+                auto it = handles.find(id);
+                if (it == handles.end()) {
+                    return false;
+                }
+                handle = it->second;
+                return true;
+            };
+
+            uint64_t layout = 0;
+            uint64_t renderPass = 0;
+
+            if (!handleFrom(key.layout, layout) || !handleFrom(key.renderPass, renderPass)) {
+                return false;
+            }
+
+            uint32_t stageCount = key.preRasterization.stageCount + (key.fragmentShader.stage.stage == 0 ? 0 : 1);
+
+            if (value.names.size() != stageCount || value.specializationMapEntries.size() != stageCount || value.specializationData.size() != stageCount) {
+                throw std::runtime_error(CALL_INFO + ": record does not match its key");
+            }
+
+            pipeline.clear();
+
+            // sized once, stages point into it
+            replay.specializationInfos.assign(stageCount, VULKAN_HPP_NAMESPACE::SpecializationInfo());
+
+            for (uint32_t i = 0; i < stageCount; i++) {
+                const PipelineStateKey::ShaderStage& stage = i < key.preRasterization.stageCount ? key.preRasterization.stages[i] : key.fragmentShader.stage;
+                uint64_t module = 0;
+
+                if (!handleFrom(stage.module, module)) {
+                    return false;
+                }
+
+                VULKAN_HPP_NAMESPACE::PipelineShaderStageCreateInfo info = VULKAN_HPP_NAMESPACE::PipelineShaderStageCreateInfo()
+                .setFlags(VULKAN_HPP_NAMESPACE::PipelineShaderStageCreateFlags(stage.flags))
+                .setStage(static_cast<VULKAN_HPP_NAMESPACE::ShaderStageFlagBits>(stage.stage))
+                .setModule(VULKAN_HPP_NAMESPACE::ShaderModule(reinterpret_cast<VkShaderModule>(module)))
+                .setPName(value.names.at(i).c_str());
+
+                if (!value.specializationMapEntries.at(i).empty()) {
+                    replay.specializationInfos.at(i)
+                    .setMapEntries(value.specializationMapEntries.at(i))
+                    .setDataSize(value.specializationData.at(i).size())
+                    .setPData(value.specializationData.at(i).empty() ? nullptr : value.specializationData.at(i).data());
+                    info.setPSpecializationInfo(&replay.specializationInfos.at(i));
+                }
+
+                pipeline.shaderStageCreateInfos.emplace_back(info);
+            }
+
+            if ((value.presence & PRESENT_COMPUTE) != 0) {
+                pipeline.computeCreateInfo = VULKAN_HPP_NAMESPACE::ComputePipelineCreateInfo()
+                .setFlags(VULKAN_HPP_NAMESPACE::PipelineCreateFlags(key.flags))
+                .setLayout(VULKAN_HPP_NAMESPACE::PipelineLayout(reinterpret_cast<VkPipelineLayout>(layout)));
+
+                return true;
+            }
+
+            pipeline.graphicsCreateInfo = VULKAN_HPP_NAMESPACE::GraphicsPipelineCreateInfo()
+            .setFlags(VULKAN_HPP_NAMESPACE::PipelineCreateFlags(key.flags))
+            .setLayout(VULKAN_HPP_NAMESPACE::PipelineLayout(reinterpret_cast<VkPipelineLayout>(layout)))
+            .setRenderPass(VULKAN_HPP_NAMESPACE::RenderPass(reinterpret_cast<VkRenderPass>(renderPass)))
+            .setSubpass(key.subpass);
+
+            if ((value.presence & PRESENT_VERTEX_INPUT) != 0) {
+                pipeline.vertexInputStateCreateInfoBindings.assign(key.vertexInput.bindings, key.vertexInput.bindings + key.vertexInput.bindingCount);
+                pipeline.vertexInputStateCreateInfoAttributes.assign(key.vertexInput.attributes, key.vertexInput.attributes + key.vertexInput.attributeCount);
+                pipeline.vertexInputStateCreateInfo = VULKAN_HPP_NAMESPACE::PipelineVertexInputStateCreateInfo();
+            }
+
+            if ((value.presence & PRESENT_INPUT_ASSEMBLY) != 0) {
+                pipeline.inputAssemblyStateCreateInfo = VULKAN_HPP_NAMESPACE::PipelineInputAssemblyStateCreateInfo()
+                .setTopology(static_cast<VULKAN_HPP_NAMESPACE::PrimitiveTopology>(key.vertexInput.topology))
+                .setPrimitiveRestartEnable(key.vertexInput.primitiveRestartEnable);
+            }
+
+            if ((value.presence & PRESENT_VIEWPORT) != 0) {
+                pipeline.viewports = value.viewports;
+                pipeline.scissors = value.scissors;
+                pipeline.viewportStateCreateInfo = VULKAN_HPP_NAMESPACE::PipelineViewportStateCreateInfo()
+                .setViewportCount(key.preRasterization.viewportCount)
+                .setScissorCount(key.preRasterization.scissorCount);
+            }
+
+            if ((value.presence & PRESENT_RASTERIZATION) != 0) {
+                pipeline.rasterizationStateCreateInfo = VULKAN_HPP_NAMESPACE::PipelineRasterizationStateCreateInfo()
+                .setDepthClampEnable(key.preRasterization.depthClampEnable)
+                .setRasterizerDiscardEnable(key.preRasterization.rasterizerDiscardEnable)
+                .setPolygonMode(static_cast<VULKAN_HPP_NAMESPACE::PolygonMode>(key.preRasterization.polygonMode))
+                .setCullMode(VULKAN_HPP_NAMESPACE::CullModeFlags(key.preRasterization.cullMode))
+                .setFrontFace(static_cast<VULKAN_HPP_NAMESPACE::FrontFace>(key.preRasterization.frontFace))
+                .setDepthBiasEnable(key.preRasterization.depthBiasEnable)
+                .setDepthBiasConstantFactor(key.preRasterization.depthBiasConstantFactor)
+                .setDepthBiasClamp(key.preRasterization.depthBiasClamp)
+                .setDepthBiasSlopeFactor(key.preRasterization.depthBiasSlopeFactor)
+                .setLineWidth(key.preRasterization.lineWidth);
+            }
+
+            if ((value.presence & PRESENT_TESSELLATION) != 0) {
+                pipeline.tessellationStateCreateInfo = VULKAN_HPP_NAMESPACE::PipelineTessellationStateCreateInfo()
+                .setPatchControlPoints(key.preRasterization.patchControlPoints);
+            }
+
+            if ((value.presence & PRESENT_DEPTH_STENCIL) != 0) {
+                pipeline.depthStencilStateCreateInfo = VULKAN_HPP_NAMESPACE::PipelineDepthStencilStateCreateInfo()
+                .setDepthTestEnable(key.fragmentShader.depthTestEnable)
+                .setDepthWriteEnable(key.fragmentShader.depthWriteEnable)
+                .setDepthCompareOp(static_cast<VULKAN_HPP_NAMESPACE::CompareOp>(key.fragmentShader.depthCompareOp))
+                .setDepthBoundsTestEnable(key.fragmentShader.depthBoundsTestEnable)
+                .setStencilTestEnable(key.fragmentShader.stencilTestEnable)
+                .setFront(key.fragmentShader.front)
+                .setBack(key.fragmentShader.back)
+                .setMinDepthBounds(key.fragmentShader.minDepthBounds)
+                .setMaxDepthBounds(key.fragmentShader.maxDepthBounds);
+            }
+
+            if ((value.presence & PRESENT_MULTISAMPLE) != 0) {
+                pipeline.multisampleStateCreateInfo = VULKAN_HPP_NAMESPACE::PipelineMultisampleStateCreateInfo()
+                .setRasterizationSamples(static_cast<VULKAN_HPP_NAMESPACE::SampleCountFlagBits>(key.fragmentOutput.rasterizationSamples))
+                .setSampleShadingEnable(key.fragmentOutput.sampleShadingEnable)
+                .setMinSampleShading(key.fragmentOutput.minSampleShading)
+                .setAlphaToCoverageEnable(key.fragmentOutput.alphaToCoverageEnable)
+                .setAlphaToOneEnable(key.fragmentOutput.alphaToOneEnable);
+            }
+
+            pipeline.colorBlendAttachmentStates.assign(key.fragmentOutput.attachments, key.fragmentOutput.attachments + key.fragmentOutput.attachmentCount);
+
+            if ((value.presence & PRESENT_COLOR_BLEND) != 0) {
+                pipeline.colorBlendStateCreateInfo = VULKAN_HPP_NAMESPACE::PipelineColorBlendStateCreateInfo()
+                .setLogicOpEnable(key.fragmentOutput.logicOpEnable)
+                .setLogicOp(static_cast<VULKAN_HPP_NAMESPACE::LogicOp>(key.fragmentOutput.logicOp))
+                .setBlendConstants({
+                    key.fragmentOutput.blendConstants[0],
+                    key.fragmentOutput.blendConstants[1],
+                    key.fragmentOutput.blendConstants[2],
+                    key.fragmentOutput.blendConstants[3]
+                });
+            }
+
+            if ((value.presence & PRESENT_DYNAMIC) != 0) {
+                for (uint32_t i = 0; i < key.dynamicStateCount; i++) {
+                    pipeline.dynamicStates.emplace_back(static_cast<VULKAN_HPP_NAMESPACE::DynamicState>(key.dynamicStates[i]));
+                }
+                pipeline.dynamicStateCreateInfo = VULKAN_HPP_NAMESPACE::PipelineDynamicStateCreateInfo();
+            }
+
+            if ((value.presence & PRESENT_RENDERING) != 0) {
+                replay.colorAttachmentFormats.clear();
+                for (uint32_t i = 0; i < key.fragmentOutput.colorAttachmentFormatCount; i++) {
+                    replay.colorAttachmentFormats.emplace_back(static_cast<VULKAN_HPP_NAMESPACE::Format>(key.fragmentOutput.colorAttachmentFormats[i]));
+                }
+                pipeline.renderingCreateInfo = VULKAN_HPP_NAMESPACE::PipelineRenderingCreateInfo()
+                .setViewMask(key.viewMask)
+                .setColorAttachmentFormats(replay.colorAttachmentFormats)
+                .setDepthAttachmentFormat(static_cast<VULKAN_HPP_NAMESPACE::Format>(key.fragmentOutput.depthAttachmentFormat))
+                .setStencilAttachmentFormat(static_cast<VULKAN_HPP_NAMESPACE::Format>(key.fragmentOutput.stencilAttachmentFormat));
+            }
+
+            return true;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void PipelineRecorder::attach() {
+        try {
+            Pipeline::setListener([this](const Pipeline& value) {
+                // recording must never fail the build that triggered it
+                try {
+                    record(value);
+                } catch (...) {
+                }
+            });
+            attached = true;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void PipelineRecorder::detach() {
+        try {
+            if (attached) {
+                Pipeline::setListener({});
+                attached = false;
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void PipelineRecorder::save(std::optional<std::string> path) {
+        try {
+            if (!path.has_value()) {
+                path = file;
+            }
+
+            if (!path.has_value()) {
+                throw std::runtime_error(CALL_INFO + ": 'path' is not initialized");
+            }
+
+            std::vector<uint8_t> data = {};
+
+            auto write = [&data](const void* value, size_t size) {
+                const uint8_t* bytes = static_cast<const uint8_t*>(value);
+                data.insert(data.end(), bytes, bytes + size);
+            };
+            auto writeUint32 = [&write](uint32_t value) {
+                write(&value, sizeof(value));
+            };
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+
+                writeUint32(MANIFEST_MAGIC);
+                writeUint32(MANIFEST_VERSION);
+                writeUint32(static_cast<uint32_t>(sizeof(PipelineStateKey)));
+                writeUint32(static_cast<uint32_t>(records.size()));
+
+                for (const Record& value : records) {
+                    write(&value.key, sizeof(value.key));
+                    writeUint32(value.presence);
+                    writeUint32(static_cast<uint32_t>(value.names.size()));
+
+                    for (size_t i = 0; i < value.names.size(); i++) {
+                        writeUint32(static_cast<uint32_t>(value.names.at(i).size()));
+                        write(value.names.at(i).data(), value.names.at(i).size());
+
+                        // 'size_t' differs between targets, entries are written field by field
+                        writeUint32(static_cast<uint32_t>(value.specializationMapEntries.at(i).size()));
+                        for (const VULKAN_HPP_NAMESPACE::SpecializationMapEntry& entry : value.specializationMapEntries.at(i)) {
+                            uint64_t entrySize = entry.size;
+                            writeUint32(entry.constantID);
+                            writeUint32(entry.offset);
+                            write(&entrySize, sizeof(entrySize));
+                        }
+
+                        writeUint32(static_cast<uint32_t>(value.specializationData.at(i).size()));
+                        write(value.specializationData.at(i).data(), value.specializationData.at(i).size());
+                    }
+
+                    writeUint32(static_cast<uint32_t>(value.viewports.size()));
+                    write(value.viewports.data(), sizeof(VkViewport) * value.viewports.size());
+                    writeUint32(static_cast<uint32_t>(value.scissors.size()));
+                    write(value.scissors.data(), sizeof(VkRect2D) * value.scissors.size());
+                }
+            }
+
+            // write next to the target and rename, so a crash never leaves a truncated manifest behind
+            std::filesystem::path filePath(path.value());
+            std::filesystem::path tmpFilePath(path.value() + ".tmp");
+
+            if (filePath.has_parent_path()) {
+                std::filesystem::create_directories(filePath.parent_path());
+            }
+
+            std::ofstream fileStream(tmpFilePath, std::ios::binary | std::ios::trunc);
+
+            if (!fileStream.is_open()) {
+                throw std::runtime_error(CALL_INFO + ": failed to open file " + tmpFilePath.generic_string());
+            }
+
+            fileStream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            fileStream.close();
+
+            if (!fileStream) {
+                throw std::runtime_error(CALL_INFO + ": failed to write file " + tmpFilePath.generic_string());
+            }
+
+            std::filesystem::rename(tmpFilePath, filePath);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE bool PipelineRecorder::load(std::optional<std::string> path) {
+        try {
+            if (!path.has_value()) {
+                path = file;
+            }
+
+            if (!path.has_value()) {
+                throw std::runtime_error(CALL_INFO + ": 'path' is not initialized");
+            }
+
+            if (!std::filesystem::exists(path.value())) {
+                return false;
+            }
+
+            std::ifstream fileStream(path.value(), std::ios::ate | std::ios::binary);
+
+            if (!fileStream.is_open()) {
+                throw std::runtime_error(CALL_INFO + ": failed to open file " + path.value());
+            }
+
+            std::vector<uint8_t> data(static_cast<size_t>(fileStream.tellg()));
+            fileStream.seekg(0);
+            fileStream.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            fileStream.close();
+
+            size_t offset = 0;
+
+            // a corrupt manifest is treated like a missing one, counts are checked against the remaining bytes
+            // before anything is sized from them
+            auto read = [&data, &offset](void* value, size_t size) {
+                if (size > data.size() - offset) {
+                    return false;
+                }
+                std::memcpy(value, data.data() + offset, size);
+                offset += size;
+                return true;
+            };
+            auto readUint32 = [&read](uint32_t& value) {
+                return read(&value, sizeof(value));
+            };
+            auto fits = [&data, &offset](uint32_t count, size_t size) {
+                return count <= (data.size() - offset) / size;
+            };
+
+            uint32_t magic = 0;
+            uint32_t version = 0;
+            uint32_t keySize = 0;
+            uint32_t recordCount = 0;
+
+            if (!readUint32(magic) || !readUint32(version) || !readUint32(keySize) || !readUint32(recordCount)) {
+                return false;
+            }
+
+            // a manifest written by another build of the key layout is stale, not broken
+            if (magic != MANIFEST_MAGIC || version != MANIFEST_VERSION || keySize != sizeof(PipelineStateKey)) {
+                return false;
+            }
+
+            std::vector<Record> values = {};
+
+            for (uint32_t r = 0; r < recordCount; r++) {
+                Record value = {};
+                uint32_t stageCount = 0;
+
+                if (!read(&value.key, sizeof(value.key)) || !readUint32(value.presence) || !readUint32(stageCount)) {
+                    return false;
+                }
+
+                if (stageCount > PipelineStateKey::MAX_PRE_RASTERIZATION_STAGES + 1) {
+                    return false;
+                }
+
+                for (uint32_t i = 0; i < stageCount; i++) {
+                    uint32_t count = 0;
+
+                    if (!readUint32(count) || !fits(count, 1)) {
+                        return false;
+                    }
+                    std::string name(count, '\0');
+                    read(name.data(), name.size());
+                    value.names.emplace_back(std::move(name));
+
+                    // each entry is written as two uint32 and one uint64
+                    if (!readUint32(count) || !fits(count, sizeof(uint32_t) * 2 + sizeof(uint64_t))) {
+                        return false;
+                    }
+                    std::vector<VULKAN_HPP_NAMESPACE::SpecializationMapEntry> entries(count);
+                    for (VULKAN_HPP_NAMESPACE::SpecializationMapEntry& entry : entries) {
+                        uint64_t entrySize = 0;
+                        readUint32(entry.constantID);
+                        readUint32(entry.offset);
+                        read(&entrySize, sizeof(entrySize));
+                        entry.size = static_cast<size_t>(entrySize);
+                    }
+                    value.specializationMapEntries.emplace_back(std::move(entries));
+
+                    if (!readUint32(count) || !fits(count, 1)) {
+                        return false;
+                    }
+                    std::vector<uint8_t> bytes(count);
+                    read(bytes.data(), bytes.size());
+                    value.specializationData.emplace_back(std::move(bytes));
+                }
+
+                uint32_t count = 0;
+
+                if (!readUint32(count) || !fits(count, sizeof(VkViewport))) {
+                    return false;
+                }
+                value.viewports.resize(count);
+                read(value.viewports.data(), sizeof(VkViewport) * value.viewports.size());
+
+                if (!readUint32(count) || !fits(count, sizeof(VkRect2D))) {
+                    return false;
+                }
+                value.scissors.resize(count);
+                read(value.scissors.data(), sizeof(VkRect2D) * value.scissors.size());
+
+                values.emplace_back(std::move(value));
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+
+            for (Record& value : values) {
+                if (keys.insert(value.key).second) {
+                    records.emplace_back(std::move(value));
+                }
+            }
+
+            return true;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE std::vector<std::future<void>> PipelineRecorder::warmUp(
+        PipelineCompiler& compiler,
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        VULKAN_HPP_NAMESPACE::raii::PipelineCache& cache
+    ) {
+        try {
+            std::vector<std::future<void>> result = {};
+            std::lock_guard<std::mutex> lock(mutex);
+
+            for (const Record& value : records) {
+                std::shared_ptr<Replay> replay = std::make_shared<Replay>();
+                replay->record = value;
+
+                // objects not registered on this launch are skipped, their pipelines compile on first use
+                if (!resolve(*replay)) {
+                    continue;
+                }
+
+                // the task owns its replay, so repeated warm-ups do not accumulate descriptions
+                // only the cache entry is kept, the real build on first use hits it
+                result.emplace_back(compiler.submit([&device, &cache, replay]() {
+                    Pipeline::builder(replay->pipeline).build(device, cache);
+                    replay->pipeline.target.clear();
+                }));
+            }
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE size_t PipelineRecorder::size() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            return records.size();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void PipelineRecorder::clear() {
+        try {
+            detach();
+            std::lock_guard<std::mutex> lock(mutex);
+            file.reset();
+            readFile = false;
+            listen = false;
+            ids.clear();
+            handles.clear();
+            records.clear();
+            keys.clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void PipelineRecorder::clearAndRelease() {
+        try {
+            // replays are owned by their warm-up tasks and drop their pipelines as soon as they are built
+            clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineRecorder::Builder::Builder(PipelineRecorder& object): object(object) {
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineRecorder::Builder& PipelineRecorder::Builder::setFile(const std::optional<std::string>& value) {
+        object.file = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineRecorder::Builder& PipelineRecorder::Builder::setReadFile(bool value) {
+        object.readFile = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineRecorder::Builder& PipelineRecorder::Builder::setListen(bool value) {
+        object.listen = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineRecorder& PipelineRecorder::Builder::build() {
+        try {
+            if (object.readFile && object.file.has_value()) {
+                object.load();
+            }
+
+            if (object.listen) {
+                object.attach();
+            }
+
+            return object;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <memory>
+#include <future>
+#include <mutex>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "exqudens/vulkan/export.hpp"
+#include "exqudens/vulkan/Pipeline.hpp"
+#include "exqudens/vulkan/PipelineStateKey.hpp"
+
+namespace exqudens::vulkan {
+
+    struct EXQUDENS_VULKAN_EXPORT PipelineStateCache {
+
+        class Builder;
+
+        struct Entry {
+            std::shared_future<void> ready = {};
+            VULKAN_HPP_NAMESPACE::raii::Pipeline target = nullptr;
+        };
+
+        std::unordered_map<PipelineStateKey, std::unique_ptr<Entry>, PipelineStateKey::Hash> entries = {};
+        std::mutex mutex = {};
+
+        static Builder builder(PipelineStateCache& object);
+
+        VULKAN_HPP_NAMESPACE::Pipeline obtain(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            VULKAN_HPP_NAMESPACE::raii::PipelineCache& cache,
+            Pipeline& pipeline
+        );
+
+        size_t size();
+
+        void clear();
+
+        void clearAndRelease();
+
+    };
+
+    class EXQUDENS_VULKAN_EXPORT PipelineStateCache::Builder {
+
+        private:
+
+            PipelineStateCache& object;
+
+        public:
+
+            explicit Builder(PipelineStateCache& object);
+
+            PipelineStateCache& build();
+
+    };
+
+}
+
+// implementation ---
+
+#include <utility>
+#include <exception>
+#include <string>
+#include <filesystem>
+#include <stdexcept>
+
+#define CALL_INFO std::string(__FUNCTION__) + " (" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::vulkan {
+
+    EXQUDENS_VULKAN_INLINE PipelineStateCache::Builder PipelineStateCache::builder(PipelineStateCache& object) {
+        return Builder(object);
+    }
+
+    EXQUDENS_VULKAN_INLINE VULKAN_HPP_NAMESPACE::Pipeline PipelineStateCache::obtain(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        VULKAN_HPP_NAMESPACE::raii::PipelineCache& cache,
+        Pipeline& pipeline
+    ) {
+        try {
+            PipelineStateKey key = PipelineStateKey::from(pipeline);
+            Entry* entry = nullptr;
+            std::shared_future<void> ready = {};
+            std::promise<void> promise;
+            bool owner = false;
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+
+                auto it = entries.find(key);
+
+                if (it == entries.end()) {
+                    std::unique_ptr<Entry> value = std::make_unique<Entry>();
+                    value->ready = promise.get_future().share();
+                    it = entries.emplace(key, std::move(value)).first;
+                    owner = true;
+                }
+
+                entry = it->second.get();
+                ready = entry->ready;
+            }
+
+            if (!owner) {
+                // another thread may still be compiling the same state, a failed compile rethrows here
+                ready.get();
+                return *entry->target;
+            }
+
+            // compile outside the lock, waiters block on the entry only
+            try {
+                Pipeline::builder(pipeline).build(device, cache);
+                entry->target = std::move(pipeline.target);
+                promise.set_value();
+            } catch (...) {
+                promise.set_exception(std::current_exception());
+                std::lock_guard<std::mutex> lock(mutex);
+                entries.erase(key);
+                throw;
+            }
+
+            return *entry->target;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE size_t PipelineStateCache::size() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            return entries.size();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void PipelineStateCache::clear() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            entries.clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void PipelineStateCache::clearAndRelease() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto& [key, entry] : entries) {
+                entry->target.release();
+            }
+            entries.clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineStateCache::Builder::Builder(PipelineStateCache& object): object(object) {
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineStateCache& PipelineStateCache::Builder::build() {
+        try {
+            object.clear();
+            return object;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
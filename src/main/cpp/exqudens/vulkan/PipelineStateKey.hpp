@@ -0,0 +1,572 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "exqudens/vulkan/export.hpp"
+#include "exqudens/vulkan/Pipeline.hpp"
+
+namespace exqudens::vulkan {
+
+    struct EXQUDENS_VULKAN_EXPORT PipelineStateKey {
+
+        static constexpr uint32_t MAX_PRE_RASTERIZATION_STAGES = 4;
+        static constexpr uint32_t MAX_VERTEX_BINDINGS = 16;
+        static constexpr uint32_t MAX_VERTEX_ATTRIBUTES = 16;
+        static constexpr uint32_t MAX_COLOR_ATTACHMENTS = 8;
+        static constexpr uint32_t MAX_DYNAMIC_STATES = 64;
+        static constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+        static constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+        struct Hash {
+            size_t operator()(const PipelineStateKey& value) const;
+        };
+
+        struct ShaderStage {
+            VkShaderStageFlagBits stage;
+            VkPipelineShaderStageCreateFlags flags;
+            uint64_t module;
+            uint64_t nameHash;
+            uint64_t specializationHash;
+        };
+
+        struct VertexInput {
+            uint32_t bindingCount;
+            VkVertexInputBindingDescription bindings[MAX_VERTEX_BINDINGS];
+            uint32_t attributeCount;
+            VkVertexInputAttributeDescription attributes[MAX_VERTEX_ATTRIBUTES];
+            VkPrimitiveTopology topology;
+            VkBool32 primitiveRestartEnable;
+        };
+
+        struct PreRasterization {
+            uint32_t stageCount;
+            ShaderStage stages[MAX_PRE_RASTERIZATION_STAGES];
+            uint32_t viewportCount;
+            uint32_t scissorCount;
+            uint64_t viewportHash;
+            VkBool32 depthClampEnable;
+            VkBool32 rasterizerDiscardEnable;
+            VkPolygonMode polygonMode;
+            VkCullModeFlags cullMode;
+            VkFrontFace frontFace;
+            VkBool32 depthBiasEnable;
+            float depthBiasConstantFactor;
+            float depthBiasClamp;
+            float depthBiasSlopeFactor;
+            float lineWidth;
+            uint32_t patchControlPoints;
+        };
+
+        struct FragmentShader {
+            ShaderStage stage;
+            VkBool32 depthTestEnable;
+            VkBool32 depthWriteEnable;
+            VkCompareOp depthCompareOp;
+            VkBool32 depthBoundsTestEnable;
+            VkBool32 stencilTestEnable;
+            VkStencilOpState front;
+            VkStencilOpState back;
+            float minDepthBounds;
+            float maxDepthBounds;
+        };
+
+        struct FragmentOutput {
+            VkSampleCountFlagBits rasterizationSamples;
+            VkBool32 sampleShadingEnable;
+            float minSampleShading;
+            uint64_t sampleMaskHash;
+            VkBool32 alphaToCoverageEnable;
+            VkBool32 alphaToOneEnable;
+            VkBool32 logicOpEnable;
+            VkLogicOp logicOp;
+            uint32_t attachmentCount;
+            VkPipelineColorBlendAttachmentState attachments[MAX_COLOR_ATTACHMENTS];
+            float blendConstants[4];
+            uint32_t colorAttachmentFormatCount;
+            VkFormat colorAttachmentFormats[MAX_COLOR_ATTACHMENTS];
+            VkFormat depthAttachmentFormat;
+            VkFormat stencilAttachmentFormat;
+        };
+
+        VkPipelineCreateFlags flags;
+        VkGraphicsPipelineLibraryFlagsEXT libraryFlags;
+        uint64_t libraryHash;
+        uint64_t layout;
+        uint64_t renderPass;
+        uint32_t subpass;
+        uint32_t viewMask;
+        uint32_t dynamicStateCount;
+        VkDynamicState dynamicStates[MAX_DYNAMIC_STATES];
+        VertexInput vertexInput;
+        PreRasterization preRasterization;
+        FragmentShader fragmentShader;
+        FragmentOutput fragmentOutput;
+
+        static uint64_t hashBytes(const void* data, size_t size, uint64_t seed = FNV_OFFSET_BASIS);
+
+        static PipelineStateKey from(const Pipeline& pipeline);
+
+        PipelineStateKey part(const VULKAN_HPP_NAMESPACE::GraphicsPipelineLibraryFlagBitsEXT& value) const;
+
+        uint64_t hash() const;
+
+        bool operator==(const PipelineStateKey& other) const;
+
+        bool operator!=(const PipelineStateKey& other) const;
+
+    };
+
+}
+
+// implementation ---
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <filesystem>
+#include <stdexcept>
+
+#define CALL_INFO std::string(__FUNCTION__) + " (" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::vulkan {
+
+    EXQUDENS_VULKAN_INLINE size_t PipelineStateKey::Hash::operator()(const PipelineStateKey& value) const {
+        return static_cast<size_t>(value.hash());
+    }
+
+    EXQUDENS_VULKAN_INLINE uint64_t PipelineStateKey::hashBytes(const void* data, size_t size, uint64_t seed) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        uint64_t result = seed;
+        for (size_t i = 0; i < size; i++) {
+            result ^= bytes[i];
+            result *= FNV_PRIME;
+        }
+        return result;
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineStateKey PipelineStateKey::from(const Pipeline& pipeline) {
+        try {
+            PipelineStateKey result;
+
+            // padding takes part in hashing and comparison, so it has to be zero
+            std::memset(&result, 0, sizeof(result));
+
+            // extension structs are not part of the key, so a chain would make two different pipelines look equal,
+            // the graphics, rendering and library infos are excluded because 'prepare()' rebuilds their chain
+            auto checkNext = [](const void* value, const std::string& name) {
+                if (value != nullptr) {
+                    throw std::runtime_error(CALL_INFO + ": '" + name + ".pNext' is not supported");
+                }
+            };
+            for (const VULKAN_HPP_NAMESPACE::PipelineShaderStageCreateInfo& value : pipeline.shaderStageCreateInfos) {
+                checkNext(value.pNext, "shaderStageCreateInfos");
+            }
+            if (pipeline.vertexInputStateCreateInfo.has_value()) {
+                checkNext(pipeline.vertexInputStateCreateInfo.value().pNext, "vertexInputStateCreateInfo");
+            }
+            if (pipeline.inputAssemblyStateCreateInfo.has_value()) {
+                checkNext(pipeline.inputAssemblyStateCreateInfo.value().pNext, "inputAssemblyStateCreateInfo");
+            }
+            if (pipeline.viewportStateCreateInfo.has_value()) {
+                checkNext(pipeline.viewportStateCreateInfo.value().pNext, "viewportStateCreateInfo");
+            }
+            if (pipeline.rasterizationStateCreateInfo.has_value()) {
+                checkNext(pipeline.rasterizationStateCreateInfo.value().pNext, "rasterizationStateCreateInfo");
+            }
+            if (pipeline.multisampleStateCreateInfo.has_value()) {
+                checkNext(pipeline.multisampleStateCreateInfo.value().pNext, "multisampleStateCreateInfo");
+            }
+            if (pipeline.colorBlendStateCreateInfo.has_value()) {
+                checkNext(pipeline.colorBlendStateCreateInfo.value().pNext, "colorBlendStateCreateInfo");
+            }
+            if (pipeline.dynamicStateCreateInfo.has_value()) {
+                checkNext(pipeline.dynamicStateCreateInfo.value().pNext, "dynamicStateCreateInfo");
+            }
+            if (pipeline.depthStencilStateCreateInfo.has_value()) {
+                checkNext(pipeline.depthStencilStateCreateInfo.value().pNext, "depthStencilStateCreateInfo");
+            }
+            if (pipeline.tessellationStateCreateInfo.has_value()) {
+                checkNext(pipeline.tessellationStateCreateInfo.value().pNext, "tessellationStateCreateInfo");
+            }
+            if (pipeline.computeCreateInfo.has_value()) {
+                checkNext(pipeline.computeCreateInfo.value().pNext, "computeCreateInfo");
+            }
+
+            auto shaderStageFrom = [&pipeline](const VULKAN_HPP_NAMESPACE::PipelineShaderStageCreateInfo& value) {
+                ShaderStage stage;
+                std::memset(&stage, 0, sizeof(stage));
+                stage.stage = static_cast<VkShaderStageFlagBits>(value.stage);
+                stage.flags = static_cast<VkPipelineShaderStageCreateFlags>(value.flags);
+                stage.module = reinterpret_cast<uint64_t>(static_cast<VkShaderModule>(value.module));
+                stage.nameHash = value.pName == nullptr ? 0 : hashBytes(value.pName, std::strlen(value.pName));
+                // a stage without its own info is pointed at the shared one by 'prepare()', so it hashes the same either way
+                bool shared = pipeline.usesSharedSpecialization(value) || (value.pSpecializationInfo == nullptr && !pipeline.specializationMapEntries.empty());
+                if (shared) {
+                    // same bytes 'prepare()' points the stage at, read from this object even if the pointer came from a copy
+                    stage.specializationHash = hashBytes(pipeline.specializationMapEntries.data(), sizeof(VkSpecializationMapEntry) * pipeline.specializationMapEntries.size());
+                    stage.specializationHash = hashBytes(pipeline.specializationData.data(), pipeline.specializationData.size(), stage.specializationHash);
+                } else if (value.pSpecializationInfo != nullptr) {
+                    const VULKAN_HPP_NAMESPACE::SpecializationInfo& info = *value.pSpecializationInfo;
+                    stage.specializationHash = hashBytes(info.pMapEntries, sizeof(VkSpecializationMapEntry) * info.mapEntryCount);
+                    stage.specializationHash = hashBytes(info.pData, info.dataSize, stage.specializationHash);
+                }
+                return stage;
+            };
+
+            if (pipeline.graphicsCreateInfo.has_value()) {
+                result.flags = static_cast<VkPipelineCreateFlags>(pipeline.graphicsCreateInfo.value().flags);
+                result.layout = reinterpret_cast<uint64_t>(static_cast<VkPipelineLayout>(pipeline.graphicsCreateInfo.value().layout));
+                result.renderPass = reinterpret_cast<uint64_t>(static_cast<VkRenderPass>(pipeline.graphicsCreateInfo.value().renderPass));
+                result.subpass = pipeline.graphicsCreateInfo.value().subpass;
+            } else if (pipeline.computeCreateInfo.has_value()) {
+                result.flags = static_cast<VkPipelineCreateFlags>(pipeline.computeCreateInfo.value().flags);
+                result.layout = reinterpret_cast<uint64_t>(static_cast<VkPipelineLayout>(pipeline.computeCreateInfo.value().layout));
+            }
+
+            if (pipeline.libraryCreateInfo.has_value()) {
+                result.libraryFlags = static_cast<VkGraphicsPipelineLibraryFlagsEXT>(pipeline.libraryCreateInfo.value().flags);
+            }
+            result.libraryHash = hashBytes(pipeline.libraries.data(), sizeof(VkPipeline) * pipeline.libraries.size());
+
+            std::vector<VULKAN_HPP_NAMESPACE::DynamicState> dynamicStates = pipeline.dynamicStates;
+            if (dynamicStates.empty() && pipeline.dynamicStateCreateInfo.has_value() && pipeline.dynamicStateCreateInfo.value().pDynamicStates != nullptr) {
+                const VULKAN_HPP_NAMESPACE::PipelineDynamicStateCreateInfo& info = pipeline.dynamicStateCreateInfo.value();
+                dynamicStates.assign(info.pDynamicStates, info.pDynamicStates + info.dynamicStateCount);
+            }
+            // the declaration order does not change the pipeline, so it must not change the key
+            std::sort(dynamicStates.begin(), dynamicStates.end());
+            dynamicStates.erase(std::unique(dynamicStates.begin(), dynamicStates.end()), dynamicStates.end());
+            if (dynamicStates.size() > MAX_DYNAMIC_STATES) {
+                throw std::runtime_error(CALL_INFO + ": too many dynamic states");
+            }
+            result.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+            for (size_t i = 0; i < dynamicStates.size(); i++) {
+                result.dynamicStates[i] = static_cast<VkDynamicState>(dynamicStates.at(i));
+            }
+
+            // vertex input
+            if (pipeline.vertexInputStateCreateInfo.has_value()) {
+                if (pipeline.vertexInputStateCreateInfoBindings.size() > MAX_VERTEX_BINDINGS || pipeline.vertexInputStateCreateInfoAttributes.size() > MAX_VERTEX_ATTRIBUTES) {
+                    throw std::runtime_error(CALL_INFO + ": too many vertex bindings or attributes");
+                }
+                result.vertexInput.bindingCount = static_cast<uint32_t>(pipeline.vertexInputStateCreateInfoBindings.size());
+                for (size_t i = 0; i < pipeline.vertexInputStateCreateInfoBindings.size(); i++) {
+                    result.vertexInput.bindings[i] = pipeline.vertexInputStateCreateInfoBindings.at(i);
+                }
+                result.vertexInput.attributeCount = static_cast<uint32_t>(pipeline.vertexInputStateCreateInfoAttributes.size());
+                for (size_t i = 0; i < pipeline.vertexInputStateCreateInfoAttributes.size(); i++) {
+                    result.vertexInput.attributes[i] = pipeline.vertexInputStateCreateInfoAttributes.at(i);
+                }
+            }
+            if (pipeline.inputAssemblyStateCreateInfo.has_value()) {
+                result.vertexInput.topology = static_cast<VkPrimitiveTopology>(pipeline.inputAssemblyStateCreateInfo.value().topology);
+                result.vertexInput.primitiveRestartEnable = pipeline.inputAssemblyStateCreateInfo.value().primitiveRestartEnable;
+            }
+
+            // pre-rasterization
+            for (const VULKAN_HPP_NAMESPACE::PipelineShaderStageCreateInfo& value : pipeline.shaderStageCreateInfos) {
+                if (value.stage == VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eFragment) {
+                    result.fragmentShader.stage = shaderStageFrom(value);
+                    continue;
+                }
+                if (result.preRasterization.stageCount >= MAX_PRE_RASTERIZATION_STAGES) {
+                    throw std::runtime_error(CALL_INFO + ": too many shader stages");
+                }
+                result.preRasterization.stages[result.preRasterization.stageCount++] = shaderStageFrom(value);
+            }
+            if (pipeline.viewportStateCreateInfo.has_value()) {
+                result.preRasterization.viewportCount = pipeline.viewportStateCreateInfo.value().viewportCount;
+                result.preRasterization.scissorCount = pipeline.viewportStateCreateInfo.value().scissorCount;
+            }
+            if (!pipeline.viewports.empty()) {
+                result.preRasterization.viewportCount = static_cast<uint32_t>(pipeline.viewports.size());
+            }
+            if (!pipeline.scissors.empty()) {
+                result.preRasterization.scissorCount = static_cast<uint32_t>(pipeline.scissors.size());
+            }
+            result.preRasterization.viewportHash = hashBytes(pipeline.viewports.data(), sizeof(VkViewport) * pipeline.viewports.size());
+            result.preRasterization.viewportHash = hashBytes(pipeline.scissors.data(), sizeof(VkRect2D) * pipeline.scissors.size(), result.preRasterization.viewportHash);
+            if (pipeline.rasterizationStateCreateInfo.has_value()) {
+                const VULKAN_HPP_NAMESPACE::PipelineRasterizationStateCreateInfo& info = pipeline.rasterizationStateCreateInfo.value();
+                result.preRasterization.depthClampEnable = info.depthClampEnable;
+                result.preRasterization.rasterizerDiscardEnable = info.rasterizerDiscardEnable;
+                result.preRasterization.polygonMode = static_cast<VkPolygonMode>(info.polygonMode);
+                result.preRasterization.cullMode = static_cast<VkCullModeFlags>(info.cullMode);
+                result.preRasterization.frontFace = static_cast<VkFrontFace>(info.frontFace);
+                result.preRasterization.depthBiasEnable = info.depthBiasEnable;
+                result.preRasterization.depthBiasConstantFactor = info.depthBiasConstantFactor;
+                result.preRasterization.depthBiasClamp = info.depthBiasClamp;
+                result.preRasterization.depthBiasSlopeFactor = info.depthBiasSlopeFactor;
+                result.preRasterization.lineWidth = info.lineWidth;
+            }
+            if (pipeline.tessellationStateCreateInfo.has_value()) {
+                result.preRasterization.patchControlPoints = pipeline.tessellationStateCreateInfo.value().patchControlPoints;
+            }
+
+            // fragment shader
+            if (pipeline.depthStencilStateCreateInfo.has_value()) {
+                const VULKAN_HPP_NAMESPACE::PipelineDepthStencilStateCreateInfo& info = pipeline.depthStencilStateCreateInfo.value();
+                result.fragmentShader.depthTestEnable = info.depthTestEnable;
+                result.fragmentShader.depthWriteEnable = info.depthWriteEnable;
+                result.fragmentShader.depthCompareOp = static_cast<VkCompareOp>(info.depthCompareOp);
+                result.fragmentShader.depthBoundsTestEnable = info.depthBoundsTestEnable;
+                result.fragmentShader.stencilTestEnable = info.stencilTestEnable;
+                result.fragmentShader.front = info.front;
+                result.fragmentShader.back = info.back;
+                result.fragmentShader.minDepthBounds = info.minDepthBounds;
+                result.fragmentShader.maxDepthBounds = info.maxDepthBounds;
+            }
+
+            // fragment output
+            if (pipeline.multisampleStateCreateInfo.has_value()) {
+                const VULKAN_HPP_NAMESPACE::PipelineMultisampleStateCreateInfo& info = pipeline.multisampleStateCreateInfo.value();
+                result.fragmentOutput.rasterizationSamples = static_cast<VkSampleCountFlagBits>(info.rasterizationSamples);
+                result.fragmentOutput.sampleShadingEnable = info.sampleShadingEnable;
+                result.fragmentOutput.minSampleShading = info.minSampleShading;
+                if (info.pSampleMask != nullptr) {
+                    // one word per 32 samples
+                    size_t wordCount = (static_cast<size_t>(info.rasterizationSamples) + 31) / 32;
+                    result.fragmentOutput.sampleMaskHash = hashBytes(info.pSampleMask, sizeof(VkSampleMask) * wordCount);
+                }
+                result.fragmentOutput.alphaToCoverageEnable = info.alphaToCoverageEnable;
+                result.fragmentOutput.alphaToOneEnable = info.alphaToOneEnable;
+            }
+            if (pipeline.colorBlendStateCreateInfo.has_value()) {
+                const VULKAN_HPP_NAMESPACE::PipelineColorBlendStateCreateInfo& info = pipeline.colorBlendStateCreateInfo.value();
+                result.fragmentOutput.logicOpEnable = info.logicOpEnable;
+                result.fragmentOutput.logicOp = static_cast<VkLogicOp>(info.logicOp);
+                for (size_t i = 0; i < 4; i++) {
+                    result.fragmentOutput.blendConstants[i] = info.blendConstants[i];
+                }
+            }
+            if (pipeline.colorBlendAttachmentStates.size() > MAX_COLOR_ATTACHMENTS) {
+                throw std::runtime_error(CALL_INFO + ": too many color blend attachments");
+            }
+            result.fragmentOutput.attachmentCount = static_cast<uint32_t>(pipeline.colorBlendAttachmentStates.size());
+            for (size_t i = 0; i < pipeline.colorBlendAttachmentStates.size(); i++) {
+                result.fragmentOutput.attachments[i] = pipeline.colorBlendAttachmentStates.at(i);
+            }
+            if (pipeline.renderingCreateInfo.has_value()) {
+                const VULKAN_HPP_NAMESPACE::PipelineRenderingCreateInfo& info = pipeline.renderingCreateInfo.value();
+                if (info.colorAttachmentCount > MAX_COLOR_ATTACHMENTS) {
+                    throw std::runtime_error(CALL_INFO + ": too many color attachment formats");
+                }
+                result.viewMask = info.viewMask;
+                result.fragmentOutput.colorAttachmentFormatCount = info.colorAttachmentCount;
+                for (uint32_t i = 0; i < info.colorAttachmentCount && info.pColorAttachmentFormats != nullptr; i++) {
+                    result.fragmentOutput.colorAttachmentFormats[i] = static_cast<VkFormat>(info.pColorAttachmentFormats[i]);
+                }
+                result.fragmentOutput.depthAttachmentFormat = static_cast<VkFormat>(info.depthAttachmentFormat);
+                result.fragmentOutput.stencilAttachmentFormat = static_cast<VkFormat>(info.stencilAttachmentFormat);
+            }
+
+            // static values of dynamic state are ignored at creation, so they must not split the key
+            bool dynamicViewport = false;
+            bool dynamicScissor = false;
+            for (uint32_t i = 0; i < result.dynamicStateCount; i++) {
+                switch (static_cast<VULKAN_HPP_NAMESPACE::DynamicState>(result.dynamicStates[i])) {
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eViewport:
+                        dynamicViewport = true;
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eScissor:
+                        dynamicScissor = true;
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eViewportWithCount:
+                        dynamicViewport = true;
+                        result.preRasterization.viewportCount = 0;
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eScissorWithCount:
+                        dynamicScissor = true;
+                        result.preRasterization.scissorCount = 0;
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eLineWidth:
+                        result.preRasterization.lineWidth = 0.0f;
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eDepthBias:
+                        result.preRasterization.depthBiasConstantFactor = 0.0f;
+                        result.preRasterization.depthBiasClamp = 0.0f;
+                        result.preRasterization.depthBiasSlopeFactor = 0.0f;
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eBlendConstants:
+                        std::memset(result.fragmentOutput.blendConstants, 0, sizeof(result.fragmentOutput.blendConstants));
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eDepthBounds:
+                        result.fragmentShader.minDepthBounds = 0.0f;
+                        result.fragmentShader.maxDepthBounds = 0.0f;
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eStencilCompareMask:
+                        result.fragmentShader.front.compareMask = 0;
+                        result.fragmentShader.back.compareMask = 0;
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eStencilWriteMask:
+                        result.fragmentShader.front.writeMask = 0;
+                        result.fragmentShader.back.writeMask = 0;
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eStencilReference:
+                        result.fragmentShader.front.reference = 0;
+                        result.fragmentShader.back.reference = 0;
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eCullMode:
+                        result.preRasterization.cullMode = 0;
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eFrontFace:
+                        result.preRasterization.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::ePrimitiveTopology:
+                        // only the topology class stays baked unless 'dynamicPrimitiveTopologyUnrestricted' is used
+                        switch (result.vertexInput.topology) {
+                            case VK_PRIMITIVE_TOPOLOGY_POINT_LIST:
+                                break;
+                            case VK_PRIMITIVE_TOPOLOGY_LINE_LIST:
+                            case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP:
+                            case VK_PRIMITIVE_TOPOLOGY_LINE_LIST_WITH_ADJACENCY:
+                            case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP_WITH_ADJACENCY:
+                                result.vertexInput.topology = VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
+                                break;
+                            case VK_PRIMITIVE_TOPOLOGY_PATCH_LIST:
+                                break;
+                            default:
+                                result.vertexInput.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+                                break;
+                        }
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eDepthTestEnable:
+                        result.fragmentShader.depthTestEnable = VK_FALSE;
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eDepthWriteEnable:
+                        result.fragmentShader.depthWriteEnable = VK_FALSE;
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eDepthCompareOp:
+                        result.fragmentShader.depthCompareOp = VK_COMPARE_OP_NEVER;
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eDepthBoundsTestEnable:
+                        result.fragmentShader.depthBoundsTestEnable = VK_FALSE;
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eStencilTestEnable:
+                        result.fragmentShader.stencilTestEnable = VK_FALSE;
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eStencilOp:
+                        for (VkStencilOpState* state : {&result.fragmentShader.front, &result.fragmentShader.back}) {
+                            state->failOp = VK_STENCIL_OP_KEEP;
+                            state->passOp = VK_STENCIL_OP_KEEP;
+                            state->depthFailOp = VK_STENCIL_OP_KEEP;
+                            state->compareOp = VK_COMPARE_OP_NEVER;
+                        }
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eRasterizerDiscardEnable:
+                        result.preRasterization.rasterizerDiscardEnable = VK_FALSE;
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eDepthBiasEnable:
+                        result.preRasterization.depthBiasEnable = VK_FALSE;
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::ePrimitiveRestartEnable:
+                        result.vertexInput.primitiveRestartEnable = VK_FALSE;
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::ePolygonModeEXT:
+                        result.preRasterization.polygonMode = VK_POLYGON_MODE_FILL;
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eColorBlendEnableEXT:
+                        for (uint32_t j = 0; j < result.fragmentOutput.attachmentCount; j++) {
+                            result.fragmentOutput.attachments[j].blendEnable = VK_FALSE;
+                        }
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eColorWriteMaskEXT:
+                        for (uint32_t j = 0; j < result.fragmentOutput.attachmentCount; j++) {
+                            result.fragmentOutput.attachments[j].colorWriteMask = 0;
+                        }
+                        break;
+                    default:
+                        break;
+                }
+            }
+            if (dynamicViewport && dynamicScissor) {
+                result.preRasterization.viewportHash = 0;
+            }
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineStateKey PipelineStateKey::part(const VULKAN_HPP_NAMESPACE::GraphicsPipelineLibraryFlagBitsEXT& value) const {
+        try {
+            PipelineStateKey result;
+            std::memset(&result, 0, sizeof(result));
+
+            result.flags = flags;
+            result.libraryFlags = static_cast<VkGraphicsPipelineLibraryFlagsEXT>(value);
+            result.dynamicStateCount = dynamicStateCount;
+            std::memcpy(result.dynamicStates, dynamicStates, sizeof(dynamicStates));
+
+            switch (value) {
+                case VULKAN_HPP_NAMESPACE::GraphicsPipelineLibraryFlagBitsEXT::eVertexInputInterface:
+                    std::memcpy(&result.vertexInput, &vertexInput, sizeof(vertexInput));
+                    break;
+                case VULKAN_HPP_NAMESPACE::GraphicsPipelineLibraryFlagBitsEXT::ePreRasterizationShaders:
+                    result.layout = layout;
+                    result.renderPass = renderPass;
+                    result.subpass = subpass;
+                    result.viewMask = viewMask;
+                    std::memcpy(&result.preRasterization, &preRasterization, sizeof(preRasterization));
+                    break;
+                case VULKAN_HPP_NAMESPACE::GraphicsPipelineLibraryFlagBitsEXT::eFragmentShader:
+                    result.layout = layout;
+                    result.renderPass = renderPass;
+                    result.subpass = subpass;
+                    result.viewMask = viewMask;
+                    std::memcpy(&result.fragmentShader, &fragmentShader, sizeof(fragmentShader));
+                    // the fragment shader part is built with the whole multisample state, so all of it takes part
+                    result.fragmentOutput.rasterizationSamples = fragmentOutput.rasterizationSamples;
+                    result.fragmentOutput.sampleShadingEnable = fragmentOutput.sampleShadingEnable;
+                    result.fragmentOutput.minSampleShading = fragmentOutput.minSampleShading;
+                    result.fragmentOutput.sampleMaskHash = fragmentOutput.sampleMaskHash;
+                    result.fragmentOutput.alphaToCoverageEnable = fragmentOutput.alphaToCoverageEnable;
+                    result.fragmentOutput.alphaToOneEnable = fragmentOutput.alphaToOneEnable;
+                    break;
+                case VULKAN_HPP_NAMESPACE::GraphicsPipelineLibraryFlagBitsEXT::eFragmentOutputInterface:
+                    result.renderPass = renderPass;
+                    result.subpass = subpass;
+                    result.viewMask = viewMask;
+                    std::memcpy(&result.fragmentOutput, &fragmentOutput, sizeof(fragmentOutput));
+                    break;
+                default:
+                    throw std::runtime_error(CALL_INFO + ": unsupported library part");
+            }
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE uint64_t PipelineStateKey::hash() const {
+        // the key holds 64 bit members, so its size is a whole number of words and it is hashed a word at a time
+        static_assert(sizeof(PipelineStateKey) % sizeof(uint64_t) == 0);
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(this);
+        uint64_t result = FNV_OFFSET_BASIS;
+        for (size_t i = 0; i < sizeof(PipelineStateKey); i += sizeof(uint64_t)) {
+            uint64_t word = 0;
+            std::memcpy(&word, bytes + i, sizeof(word));
+            result ^= word;
+            result *= FNV_PRIME;
+            result ^= result >> 32;
+        }
+        return result;
+    }
+
+    EXQUDENS_VULKAN_INLINE bool PipelineStateKey::operator==(const PipelineStateKey& other) const {
+        return std::memcmp(this, &other, sizeof(PipelineStateKey)) == 0;
+    }
+
+    EXQUDENS_VULKAN_INLINE bool PipelineStateKey::operator!=(const PipelineStateKey& other) const {
+        return !(*this == other);
+    }
+
+}
+
+#undef CALL_INFO
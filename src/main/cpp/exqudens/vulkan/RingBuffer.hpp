@@ -0,0 +1,296 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <vector>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "exqudens/vulkan/export.hpp"
+#include "exqudens/vulkan/Buffer.hpp"
+#include "exqudens/vulkan/DeviceMemory.hpp"
+
+namespace exqudens::vulkan {
+
+    struct EXQUDENS_VULKAN_EXPORT RingBuffer {
+
+        class Builder;
+
+        struct Allocation {
+            VULKAN_HPP_NAMESPACE::Buffer buffer = nullptr;
+            VULKAN_HPP_NAMESPACE::DeviceSize offset = 0;
+            VULKAN_HPP_NAMESPACE::DeviceSize size = 0;
+            void* data = nullptr;
+        };
+
+        std::optional<uint32_t> frameCount = {};
+        std::optional<VULKAN_HPP_NAMESPACE::DeviceSize> frameSize = {};
+        std::optional<VULKAN_HPP_NAMESPACE::DeviceSize> alignment = {};
+        std::optional<VULKAN_HPP_NAMESPACE::BufferUsageFlags> usage = {};
+        std::optional<VULKAN_HPP_NAMESPACE::MemoryPropertyFlags> memoryPropertyFlags = {};
+        std::vector<VULKAN_HPP_NAMESPACE::Fence> fences = {};
+        uint32_t frameIndex = 0;
+        VULKAN_HPP_NAMESPACE::DeviceSize head = 0;
+        Buffer buffer = {};
+        DeviceMemory memory = {};
+
+        static Builder builder(RingBuffer& object);
+
+        void beginFrame(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            uint32_t index,
+            VULKAN_HPP_NAMESPACE::Fence fence = nullptr
+        );
+
+        Allocation allocate(VULKAN_HPP_NAMESPACE::DeviceSize size);
+
+        template<typename T>
+        Allocation push(const T& value) {
+            Allocation allocation = allocate(sizeof(T));
+            std::memcpy(allocation.data, &value, sizeof(T));
+            return allocation;
+        }
+
+        void flush();
+
+        void clear();
+
+        void clearAndRelease();
+
+    };
+
+    class EXQUDENS_VULKAN_EXPORT RingBuffer::Builder {
+
+        private:
+
+            RingBuffer& object;
+
+        public:
+
+            explicit Builder(RingBuffer& object);
+
+            Builder& setFrameCount(uint32_t value);
+
+            Builder& setFrameSize(const VULKAN_HPP_NAMESPACE::DeviceSize& value);
+
+            Builder& setAlignment(const VULKAN_HPP_NAMESPACE::DeviceSize& value);
+
+            Builder& setUsage(const VULKAN_HPP_NAMESPACE::BufferUsageFlags& value);
+
+            Builder& setMemoryPropertyFlags(const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& value);
+
+            RingBuffer& build(
+                VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice,
+                VULKAN_HPP_NAMESPACE::raii::Device& device
+            );
+
+    };
+
+}
+
+// implementation ---
+
+#include <algorithm>
+#include <string>
+#include <filesystem>
+#include <stdexcept>
+
+#define CALL_INFO std::string(__FUNCTION__) + " (" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::vulkan {
+
+    EXQUDENS_VULKAN_INLINE RingBuffer::Builder RingBuffer::builder(RingBuffer& object) {
+        return Builder(object);
+    }
+
+    EXQUDENS_VULKAN_INLINE void RingBuffer::beginFrame(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        uint32_t index,
+        VULKAN_HPP_NAMESPACE::Fence fence
+    ) {
+        try {
+            if (index >= frameCount.value()) {
+                throw std::runtime_error(CALL_INFO + ": 'index' is out of range");
+            }
+
+            // the segment is reused only after the fence of its previous frame has signaled,
+            // so this has to be called before that fence is reset for the next submit
+            if (fences.at(index)) {
+                VULKAN_HPP_NAMESPACE::Result result = device.waitForFences({fences.at(index)}, true, UINT64_MAX);
+                if (result != VULKAN_HPP_NAMESPACE::Result::eSuccess) {
+                    throw std::runtime_error(CALL_INFO + ": failed to wait for frame fence!");
+                }
+            }
+
+            fences.at(index) = fence;
+            frameIndex = index;
+            head = 0;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE RingBuffer::Allocation RingBuffer::allocate(VULKAN_HPP_NAMESPACE::DeviceSize size) {
+        try {
+            VULKAN_HPP_NAMESPACE::DeviceSize offset = ((head + alignment.value() - 1) / alignment.value()) * alignment.value();
+
+            if (offset + size > frameSize.value()) {
+                throw std::runtime_error(CALL_INFO + ": frame segment overflow, requested " + std::to_string(size) + " bytes at offset " + std::to_string(offset));
+            }
+
+            head = offset + size;
+
+            Allocation result;
+            result.buffer = *buffer.target;
+            result.offset = frameSize.value() * frameIndex + offset;
+            result.size = size;
+            result.data = static_cast<char*>(memory.mappedData) + result.offset;
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void RingBuffer::flush() {
+        try {
+            if (head == 0) {
+                return;
+            }
+
+            memory.flush(frameSize.value() * frameIndex, head);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void RingBuffer::clear() {
+        try {
+            frameCount.reset();
+            frameSize.reset();
+            alignment.reset();
+            usage.reset();
+            memoryPropertyFlags.reset();
+            fences.clear();
+            frameIndex = 0;
+            head = 0;
+            buffer.clear();
+            memory.clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void RingBuffer::clearAndRelease() {
+        try {
+            buffer.clearAndRelease();
+            memory.clearAndRelease();
+            clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE RingBuffer::Builder::Builder(RingBuffer& object): object(object) {
+    }
+
+    EXQUDENS_VULKAN_INLINE RingBuffer::Builder& RingBuffer::Builder::setFrameCount(uint32_t value) {
+        object.frameCount = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE RingBuffer::Builder& RingBuffer::Builder::setFrameSize(const VULKAN_HPP_NAMESPACE::DeviceSize& value) {
+        object.frameSize = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE RingBuffer::Builder& RingBuffer::Builder::setAlignment(const VULKAN_HPP_NAMESPACE::DeviceSize& value) {
+        object.alignment = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE RingBuffer::Builder& RingBuffer::Builder::setUsage(const VULKAN_HPP_NAMESPACE::BufferUsageFlags& value) {
+        object.usage = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE RingBuffer::Builder& RingBuffer::Builder::setMemoryPropertyFlags(const VULKAN_HPP_NAMESPACE::MemoryPropertyFlags& value) {
+        object.memoryPropertyFlags = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE RingBuffer& RingBuffer::Builder::build(
+        VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice,
+        VULKAN_HPP_NAMESPACE::raii::Device& device
+    ) {
+        try {
+            if (!object.frameCount.has_value() || object.frameCount.value() == 0) {
+                throw std::runtime_error(CALL_INFO + ": 'frameCount' is not initialized");
+            }
+
+            if (!object.frameSize.has_value() || object.frameSize.value() == 0) {
+                throw std::runtime_error(CALL_INFO + ": 'frameSize' is not initialized");
+            }
+
+            if (!object.usage.has_value()) {
+                object.usage = VULKAN_HPP_NAMESPACE::BufferUsageFlagBits::eUniformBuffer;
+            }
+
+            if (!object.memoryPropertyFlags.has_value()) {
+                object.memoryPropertyFlags = VULKAN_HPP_NAMESPACE::MemoryPropertyFlagBits::eHostVisible | VULKAN_HPP_NAMESPACE::MemoryPropertyFlagBits::eHostCoherent;
+            }
+
+            if (!object.alignment.has_value()) {
+                VULKAN_HPP_NAMESPACE::PhysicalDeviceLimits limits = physicalDevice.getProperties().limits;
+                VULKAN_HPP_NAMESPACE::DeviceSize value = 1;
+                if (object.usage.value() & VULKAN_HPP_NAMESPACE::BufferUsageFlagBits::eUniformBuffer) {
+                    value = std::max(value, limits.minUniformBufferOffsetAlignment);
+                }
+                if (object.usage.value() & VULKAN_HPP_NAMESPACE::BufferUsageFlagBits::eStorageBuffer) {
+                    value = std::max(value, limits.minStorageBufferOffsetAlignment);
+                }
+                object.alignment = value;
+            }
+
+            // each segment starts on an aligned offset, so dynamic offsets stay valid for every frame
+            object.frameSize = ((object.frameSize.value() + object.alignment.value() - 1) / object.alignment.value()) * object.alignment.value();
+
+            object.fences = std::vector<VULKAN_HPP_NAMESPACE::Fence>(object.frameCount.value(), nullptr);
+            object.frameIndex = 0;
+            object.head = 0;
+
+            Buffer::builder(object.buffer)
+            .setCreateInfo(
+                VULKAN_HPP_NAMESPACE::BufferCreateInfo()
+                .setSize(object.frameSize.value() * object.frameCount.value())
+                .setUsage(object.usage.value())
+                .setSharingMode(VULKAN_HPP_NAMESPACE::SharingMode::eExclusive)
+            )
+            .build(device);
+
+            DeviceMemory::builder(object.memory)
+            .setAllocateInfo(
+                // device local host visible memory (rebar) saves a pcie read on every draw,
+                // host cached only slows down write-only data
+                DeviceMemory::allocateInfoFrom(
+                    physicalDevice,
+                    object.buffer.target,
+                    object.memoryPropertyFlags.value(),
+                    VULKAN_HPP_NAMESPACE::MemoryPropertyFlagBits::eDeviceLocal,
+                    VULKAN_HPP_NAMESPACE::MemoryPropertyFlagBits::eHostCached
+                )
+            )
+            .setPersistentMap(true)
+            .build(physicalDevice, device);
+
+            object.buffer.target.bindMemory(*object.memory.target, 0);
+
+            return object;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
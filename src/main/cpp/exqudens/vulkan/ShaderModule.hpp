@@ -1,11 +1,16 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <vector>
+#include <string>
+#include <span>
 
 #include <vulkan/vulkan_raii.hpp>
 
 #include "exqudens/vulkan/export.hpp"
+#include "exqudens/vulkan/Spirv.hpp"
 
 namespace exqudens::vulkan {
 
@@ -13,14 +18,31 @@ namespace exqudens::vulkan {
 
         class Builder;
 
+        struct FileMapping {
+            const void* data = nullptr;
+            size_t size = 0;
+            void* handle = nullptr;
+
+            explicit FileMapping(const std::string& path);
+            FileMapping(const FileMapping&) = delete;
+            FileMapping& operator=(const FileMapping&) = delete;
+            ~FileMapping();
+        };
+
+        static constexpr uint32_t SPIRV_MAGIC = 0x07230203;
+
         std::optional<const char*> file = {};
         std::vector<char> code = {};
+        std::span<const uint32_t> codeView = {};
         bool readFile = false;
+        bool mapFile = false;
         std::optional<VULKAN_HPP_NAMESPACE::ShaderModuleCreateInfo> createInfo = {};
         VULKAN_HPP_NAMESPACE::raii::ShaderModule target = nullptr;
 
         static Builder builder(ShaderModule& object);
 
+        static bool isSpirv(const void* data, size_t size);
+
         void clear();
 
         void clearAndRelease();
@@ -41,8 +63,14 @@ namespace exqudens::vulkan {
 
             Builder& setCode(const std::vector<char>& value);
 
+            Builder& setCode(std::span<const uint32_t> value);
+
+            Builder& setSpirv(const Spirv& value);
+
             Builder& setReadFile(bool value);
 
+            Builder& setMapFile(bool value);
+
             Builder& setCreateInfo(const VULKAN_HPP_NAMESPACE::ShaderModuleCreateInfo& value);
 
             ShaderModule& build(
@@ -60,6 +88,21 @@ namespace exqudens::vulkan {
 #include <stdexcept>
 #include <fstream>
 
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #define CALL_INFO std::string(__FUNCTION__) + " (" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
 
 namespace exqudens::vulkan {
@@ -68,11 +111,107 @@ namespace exqudens::vulkan {
         return Builder(object);
     }
 
+    EXQUDENS_VULKAN_INLINE ShaderModule::FileMapping::FileMapping(const std::string& path) {
+        try {
+#if defined(_WIN32)
+            HANDLE fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+            if (fileHandle == INVALID_HANDLE_VALUE) {
+                throw std::runtime_error(CALL_INFO + ": failed to open file " + path);
+            }
+
+            LARGE_INTEGER fileSize = {};
+            if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) {
+                CloseHandle(fileHandle);
+                throw std::runtime_error(CALL_INFO + ": failed to get size or empty file " + path);
+            }
+
+            // the mapping object keeps the file open, the file handle itself is not needed anymore
+            HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            CloseHandle(fileHandle);
+
+            if (mappingHandle == nullptr) {
+                throw std::runtime_error(CALL_INFO + ": failed to create mapping of file " + path);
+            }
+
+            const void* view = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+
+            if (view == nullptr) {
+                CloseHandle(mappingHandle);
+                throw std::runtime_error(CALL_INFO + ": failed to map file " + path);
+            }
+
+            data = view;
+            size = static_cast<size_t>(fileSize.QuadPart);
+            handle = mappingHandle;
+#else
+            int descriptor = open(path.c_str(), O_RDONLY);
+
+            if (descriptor < 0) {
+                throw std::runtime_error(CALL_INFO + ": failed to open file " + path);
+            }
+
+            struct stat status = {};
+            if (fstat(descriptor, &status) != 0 || status.st_size == 0) {
+                close(descriptor);
+                throw std::runtime_error(CALL_INFO + ": failed to get size or empty file " + path);
+            }
+
+            // the mapping stays valid after the descriptor is closed
+            void* view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+            close(descriptor);
+
+            if (view == MAP_FAILED) {
+                throw std::runtime_error(CALL_INFO + ": failed to map file " + path);
+            }
+
+            data = view;
+            size = static_cast<size_t>(status.st_size);
+#endif
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE ShaderModule::FileMapping::~FileMapping() {
+#if defined(_WIN32)
+        if (data != nullptr) {
+            UnmapViewOfFile(data);
+        }
+        if (handle != nullptr) {
+            CloseHandle(static_cast<HANDLE>(handle));
+        }
+#else
+        if (data != nullptr) {
+            munmap(const_cast<void*>(data), size);
+        }
+#endif
+    }
+
+    EXQUDENS_VULKAN_INLINE bool ShaderModule::isSpirv(const void* data, size_t size) {
+        try {
+            // header is five words, magic number first
+            if (data == nullptr || size < sizeof(uint32_t) * 5 || size % sizeof(uint32_t) != 0) {
+                return false;
+            }
+
+            if (reinterpret_cast<uintptr_t>(data) % alignof(uint32_t) != 0) {
+                return false;
+            }
+
+            return *static_cast<const uint32_t*>(data) == SPIRV_MAGIC;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
     EXQUDENS_VULKAN_INLINE void ShaderModule::clear() {
         try {
             file.reset();
             code.clear();
+            codeView = {};
             readFile = false;
+            mapFile = false;
             createInfo.reset();
             target.clear();
         } catch (...) {
@@ -102,11 +241,26 @@ namespace exqudens::vulkan {
         return *this;
     }
 
+    EXQUDENS_VULKAN_INLINE ShaderModule::Builder& ShaderModule::Builder::setCode(std::span<const uint32_t> value) {
+        object.codeView = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE ShaderModule::Builder& ShaderModule::Builder::setSpirv(const Spirv& value) {
+        object.codeView = value.code;
+        return *this;
+    }
+
     EXQUDENS_VULKAN_INLINE ShaderModule::Builder& ShaderModule::Builder::setReadFile(bool value) {
         object.readFile = value;
         return *this;
     }
 
+    EXQUDENS_VULKAN_INLINE ShaderModule::Builder& ShaderModule::Builder::setMapFile(bool value) {
+        object.mapFile = value;
+        return *this;
+    }
+
     EXQUDENS_VULKAN_INLINE ShaderModule::Builder& ShaderModule::Builder::setCreateInfo(const VULKAN_HPP_NAMESPACE::ShaderModuleCreateInfo& value) {
         object.createInfo = value;
         return *this;
@@ -116,6 +270,50 @@ namespace exqudens::vulkan {
         VULKAN_HPP_NAMESPACE::raii::Device& device
     ) {
         try {
+            if (!object.codeView.empty()) {
+                // embedded code lives in static storage, no copy is made
+                if (!isSpirv(object.codeView.data(), object.codeView.size_bytes())) {
+                    throw std::runtime_error(CALL_INFO + ": 'codeView' is not spir-v");
+                }
+
+                if (!object.createInfo.has_value()) {
+                    object.createInfo = VULKAN_HPP_NAMESPACE::ShaderModuleCreateInfo();
+                }
+
+                object.code.clear();
+                object.createInfo.value().codeSize = object.codeView.size_bytes();
+                object.createInfo.value().pCode = object.codeView.data();
+
+                object.target = device.createShaderModule(object.createInfo.value());
+
+                return object;
+            }
+
+            if (object.mapFile) {
+                std::string filePath = object.file.value();
+                FileMapping mapping(filePath);
+
+                // page aligned mapping satisfies the word alignment of 'pCode', no copy is made
+                if (!isSpirv(mapping.data, mapping.size)) {
+                    throw std::runtime_error(CALL_INFO + ": not a spir-v file " + filePath);
+                }
+
+                if (!object.createInfo.has_value()) {
+                    object.createInfo = VULKAN_HPP_NAMESPACE::ShaderModuleCreateInfo();
+                }
+
+                object.code.clear();
+                object.createInfo.value().codeSize = mapping.size;
+                object.createInfo.value().pCode = static_cast<const uint32_t*>(mapping.data);
+
+                object.target = device.createShaderModule(object.createInfo.value());
+
+                // the driver keeps its own copy, the mapping goes away with this scope
+                object.createInfo.value().pCode = nullptr;
+
+                return object;
+            }
+
             if (object.readFile) {
                 std::string filePath = object.file.value();
                 std::ifstream fileStream(filePath, std::ios::ate | std::ios::binary);
@@ -0,0 +1,638 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <span>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "exqudens/vulkan/export.hpp"
+#include "exqudens/vulkan/Spirv.hpp"
+
+namespace exqudens::vulkan {
+
+    struct EXQUDENS_VULKAN_EXPORT ShaderObject {
+
+        class Builder;
+
+        struct Stage {
+            VULKAN_HPP_NAMESPACE::ShaderStageFlagBits stage = VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eVertex;
+            VULKAN_HPP_NAMESPACE::ShaderStageFlags nextStage = {};
+            std::vector<uint32_t> code = {};
+            std::string name = "main";
+        };
+
+        // features the device was created with, they decide which stages and states a draw has to provide
+        struct Features {
+            bool tessellationShader = false;
+            bool geometryShader = false;
+            bool depthClamp = false;
+            bool alphaToOne = false;
+            bool logicOp = false;
+            bool taskShader = false;
+            bool meshShader = false;
+        };
+
+        // shader objects have no baked state, everything a draw needs is set from here
+        struct State {
+            std::vector<VULKAN_HPP_NAMESPACE::Viewport> viewports = {};
+            std::vector<VULKAN_HPP_NAMESPACE::Rect2D> scissors = {};
+            std::vector<VULKAN_HPP_NAMESPACE::VertexInputBindingDescription2EXT> vertexBindings = {};
+            std::vector<VULKAN_HPP_NAMESPACE::VertexInputAttributeDescription2EXT> vertexAttributes = {};
+            VULKAN_HPP_NAMESPACE::PrimitiveTopology primitiveTopology = VULKAN_HPP_NAMESPACE::PrimitiveTopology::eTriangleList;
+            bool primitiveRestartEnable = false;
+            // zero when no tessellation stages are bound
+            uint32_t patchControlPoints = 0;
+            VULKAN_HPP_NAMESPACE::TessellationDomainOrigin tessellationDomainOrigin = VULKAN_HPP_NAMESPACE::TessellationDomainOrigin::eUpperLeft;
+            bool rasterizerDiscardEnable = false;
+            bool depthClampEnable = false;
+            VULKAN_HPP_NAMESPACE::PolygonMode polygonMode = VULKAN_HPP_NAMESPACE::PolygonMode::eFill;
+            VULKAN_HPP_NAMESPACE::CullModeFlags cullMode = VULKAN_HPP_NAMESPACE::CullModeFlagBits::eNone;
+            VULKAN_HPP_NAMESPACE::FrontFace frontFace = VULKAN_HPP_NAMESPACE::FrontFace::eCounterClockwise;
+            bool depthBiasEnable = false;
+            float depthBiasConstantFactor = 0.0f;
+            float depthBiasClamp = 0.0f;
+            float depthBiasSlopeFactor = 0.0f;
+            float lineWidth = 1.0f;
+            VULKAN_HPP_NAMESPACE::SampleCountFlagBits rasterizationSamples = VULKAN_HPP_NAMESPACE::SampleCountFlagBits::e1;
+            VULKAN_HPP_NAMESPACE::SampleMask sampleMask = 0xFFFFFFFF;
+            bool alphaToCoverageEnable = false;
+            bool alphaToOneEnable = false;
+            bool depthTestEnable = false;
+            bool depthWriteEnable = false;
+            VULKAN_HPP_NAMESPACE::CompareOp depthCompareOp = VULKAN_HPP_NAMESPACE::CompareOp::eLess;
+            bool depthBoundsTestEnable = false;
+            float minDepthBounds = 0.0f;
+            float maxDepthBounds = 1.0f;
+            bool stencilTestEnable = false;
+            VULKAN_HPP_NAMESPACE::StencilOpState stencilFront = {};
+            VULKAN_HPP_NAMESPACE::StencilOpState stencilBack = {};
+            bool logicOpEnable = false;
+            VULKAN_HPP_NAMESPACE::LogicOp logicOp = VULKAN_HPP_NAMESPACE::LogicOp::eCopy;
+            // per attachment vectors are either empty, which means blending off and every component written, or this size
+            uint32_t colorAttachmentCount = 0;
+            std::vector<VULKAN_HPP_NAMESPACE::Bool32> colorBlendEnables = {};
+            std::vector<VULKAN_HPP_NAMESPACE::ColorBlendEquationEXT> colorBlendEquations = {};
+            std::vector<VULKAN_HPP_NAMESPACE::ColorComponentFlags> colorWriteMasks = {};
+        };
+
+        std::vector<Stage> stages = {};
+        std::vector<VULKAN_HPP_NAMESPACE::DescriptorSetLayout> setLayouts = {};
+        std::vector<VULKAN_HPP_NAMESPACE::PushConstantRange> pushConstantRanges = {};
+        bool link = true;
+        Features features = {};
+        std::vector<VULKAN_HPP_NAMESPACE::ShaderCreateInfoEXT> createInfos = {};
+        std::vector<VULKAN_HPP_NAMESPACE::raii::ShaderEXT> targets = {};
+
+        static bool isSupported(VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice);
+
+        // states 'record' sets, in order, so the list can be checked without a device
+        static std::vector<VULKAN_HPP_NAMESPACE::DynamicState> states(const State& state, const Features& features);
+
+        static void record(
+            VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer,
+            const State& state,
+            const Features& features
+        );
+
+        static Builder builder(ShaderObject& object);
+
+        // stages bound by 'bind', unused graphics stages the features allow are bound to null
+        std::vector<VULKAN_HPP_NAMESPACE::ShaderStageFlagBits> bindStages() const;
+
+        void bind(VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer) const;
+
+        void clear();
+
+        void clearAndRelease();
+
+    };
+
+    class EXQUDENS_VULKAN_EXPORT ShaderObject::Builder {
+
+        private:
+
+            ShaderObject& object;
+
+        public:
+
+            explicit Builder(ShaderObject& object);
+
+            Builder& addStage(
+                const VULKAN_HPP_NAMESPACE::ShaderStageFlagBits& stage,
+                std::span<const uint32_t> code,
+                const std::string& name = "main"
+            );
+
+            Builder& addSpirv(
+                const VULKAN_HPP_NAMESPACE::ShaderStageFlagBits& stage,
+                const Spirv& value,
+                const std::string& name = "main"
+            );
+
+            Builder& setSetLayouts(const std::vector<VULKAN_HPP_NAMESPACE::DescriptorSetLayout>& value);
+
+            Builder& setPushConstantRanges(const std::vector<VULKAN_HPP_NAMESPACE::PushConstantRange>& value);
+
+            Builder& setLink(bool value);
+
+            Builder& setFeatures(const Features& value);
+
+            ShaderObject& build(
+                VULKAN_HPP_NAMESPACE::raii::Device& device
+            );
+
+    };
+
+}
+
+// implementation ---
+
+#include <cstring>
+#include <array>
+#include <algorithm>
+#include <utility>
+#include <filesystem>
+#include <stdexcept>
+
+#define CALL_INFO std::string(__FUNCTION__) + " (" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::vulkan {
+
+    EXQUDENS_VULKAN_INLINE bool ShaderObject::isSupported(VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice) {
+        try {
+            std::vector<VULKAN_HPP_NAMESPACE::ExtensionProperties> properties = physicalDevice.enumerateDeviceExtensionProperties();
+            bool extension = std::any_of(properties.begin(), properties.end(), [](const VULKAN_HPP_NAMESPACE::ExtensionProperties& value) {
+                return std::strcmp(value.extensionName, VK_EXT_SHADER_OBJECT_EXTENSION_NAME) == 0;
+            });
+
+            if (!extension) {
+                return false;
+            }
+
+            auto chain = physicalDevice.getFeatures2<
+                VULKAN_HPP_NAMESPACE::PhysicalDeviceFeatures2,
+                VULKAN_HPP_NAMESPACE::PhysicalDeviceShaderObjectFeaturesEXT
+            >();
+
+            return chain.get<VULKAN_HPP_NAMESPACE::PhysicalDeviceShaderObjectFeaturesEXT>().shaderObject;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE std::vector<VULKAN_HPP_NAMESPACE::DynamicState> ShaderObject::states(const State& state, const Features& features) {
+        try {
+            std::vector<VULKAN_HPP_NAMESPACE::DynamicState> result = {
+                VULKAN_HPP_NAMESPACE::DynamicState::eViewportWithCount,
+                VULKAN_HPP_NAMESPACE::DynamicState::eScissorWithCount,
+                VULKAN_HPP_NAMESPACE::DynamicState::eVertexInputEXT,
+                VULKAN_HPP_NAMESPACE::DynamicState::ePrimitiveTopology,
+                VULKAN_HPP_NAMESPACE::DynamicState::ePrimitiveRestartEnable
+            };
+
+            if (features.tessellationShader && state.patchControlPoints != 0) {
+                result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::ePatchControlPointsEXT);
+                result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eTessellationDomainOriginEXT);
+            }
+
+            result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eRasterizerDiscardEnable);
+
+            // the remaining state is only consumed when fragments are produced
+            if (state.rasterizerDiscardEnable) {
+                return result;
+            }
+
+            result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::ePolygonModeEXT);
+
+            if (features.depthClamp) {
+                result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eDepthClampEnableEXT);
+            }
+
+            result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eCullMode);
+            result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eFrontFace);
+            result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eDepthBiasEnable);
+
+            if (state.depthBiasEnable) {
+                result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eDepthBias);
+            }
+
+            result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eLineWidth);
+            result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eRasterizationSamplesEXT);
+            result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eSampleMaskEXT);
+            result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eAlphaToCoverageEnableEXT);
+
+            if (features.alphaToOne) {
+                result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eAlphaToOneEnableEXT);
+            }
+
+            result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eDepthTestEnable);
+            result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eDepthWriteEnable);
+            result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eDepthCompareOp);
+            result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eDepthBoundsTestEnable);
+
+            if (state.depthBoundsTestEnable) {
+                result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eDepthBounds);
+            }
+
+            result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eStencilTestEnable);
+
+            if (state.stencilTestEnable) {
+                result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eStencilOp);
+                result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eStencilCompareMask);
+                result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eStencilWriteMask);
+                result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eStencilReference);
+            }
+
+            if (features.logicOp) {
+                result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eLogicOpEnableEXT);
+
+                if (state.logicOpEnable) {
+                    result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eLogicOpEXT);
+                }
+            }
+
+            if (state.colorAttachmentCount == 0) {
+                return result;
+            }
+
+            auto checkSize = [&state](size_t size, const std::string& name) {
+                if (size != 0 && size != state.colorAttachmentCount) {
+                    throw std::runtime_error(CALL_INFO + ": '" + name + "' size does not match 'colorAttachmentCount'");
+                }
+            };
+            checkSize(state.colorBlendEnables.size(), "colorBlendEnables");
+            checkSize(state.colorBlendEquations.size(), "colorBlendEquations");
+            checkSize(state.colorWriteMasks.size(), "colorWriteMasks");
+
+            result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eColorBlendEnableEXT);
+            result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eColorBlendEquationEXT);
+            result.emplace_back(VULKAN_HPP_NAMESPACE::DynamicState::eColorWriteMaskEXT);
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void ShaderObject::record(
+        VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer,
+        const State& state,
+        const Features& features
+    ) {
+        try {
+            const std::array<std::pair<VULKAN_HPP_NAMESPACE::StencilFaceFlags, VULKAN_HPP_NAMESPACE::StencilOpState>, 2> faces = {
+                std::make_pair(VULKAN_HPP_NAMESPACE::StencilFaceFlags(VULKAN_HPP_NAMESPACE::StencilFaceFlagBits::eFront), state.stencilFront),
+                std::make_pair(VULKAN_HPP_NAMESPACE::StencilFaceFlags(VULKAN_HPP_NAMESPACE::StencilFaceFlagBits::eBack), state.stencilBack)
+            };
+
+            // every color attachment needs all three, so empty vectors fall back to defaults
+            std::vector<VULKAN_HPP_NAMESPACE::Bool32> colorBlendEnables = state.colorBlendEnables;
+            std::vector<VULKAN_HPP_NAMESPACE::ColorBlendEquationEXT> colorBlendEquations = state.colorBlendEquations;
+            std::vector<VULKAN_HPP_NAMESPACE::ColorComponentFlags> colorWriteMasks = state.colorWriteMasks;
+
+            if (colorBlendEnables.empty()) {
+                colorBlendEnables.resize(state.colorAttachmentCount, false);
+            }
+
+            if (colorBlendEquations.empty()) {
+                colorBlendEquations.resize(
+                    state.colorAttachmentCount,
+                    VULKAN_HPP_NAMESPACE::ColorBlendEquationEXT()
+                    .setSrcColorBlendFactor(VULKAN_HPP_NAMESPACE::BlendFactor::eOne)
+                    .setDstColorBlendFactor(VULKAN_HPP_NAMESPACE::BlendFactor::eZero)
+                    .setSrcAlphaBlendFactor(VULKAN_HPP_NAMESPACE::BlendFactor::eOne)
+                    .setDstAlphaBlendFactor(VULKAN_HPP_NAMESPACE::BlendFactor::eZero)
+                );
+            }
+
+            if (colorWriteMasks.empty()) {
+                colorWriteMasks.resize(
+                    state.colorAttachmentCount,
+                    VULKAN_HPP_NAMESPACE::ColorComponentFlagBits::eR
+                    | VULKAN_HPP_NAMESPACE::ColorComponentFlagBits::eG
+                    | VULKAN_HPP_NAMESPACE::ColorComponentFlagBits::eB
+                    | VULKAN_HPP_NAMESPACE::ColorComponentFlagBits::eA
+                );
+            }
+
+            for (VULKAN_HPP_NAMESPACE::DynamicState value : states(state, features)) {
+                switch (value) {
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eViewportWithCount:
+                        commandBuffer.setViewportWithCountEXT(state.viewports);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eScissorWithCount:
+                        commandBuffer.setScissorWithCountEXT(state.scissors);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eVertexInputEXT:
+                        commandBuffer.setVertexInputEXT(state.vertexBindings, state.vertexAttributes);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::ePrimitiveTopology:
+                        commandBuffer.setPrimitiveTopologyEXT(state.primitiveTopology);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::ePrimitiveRestartEnable:
+                        commandBuffer.setPrimitiveRestartEnableEXT(state.primitiveRestartEnable);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::ePatchControlPointsEXT:
+                        commandBuffer.setPatchControlPointsEXT(state.patchControlPoints);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eTessellationDomainOriginEXT:
+                        commandBuffer.setTessellationDomainOriginEXT(state.tessellationDomainOrigin);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eRasterizerDiscardEnable:
+                        commandBuffer.setRasterizerDiscardEnableEXT(state.rasterizerDiscardEnable);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::ePolygonModeEXT:
+                        commandBuffer.setPolygonModeEXT(state.polygonMode);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eDepthClampEnableEXT:
+                        commandBuffer.setDepthClampEnableEXT(state.depthClampEnable);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eCullMode:
+                        commandBuffer.setCullModeEXT(state.cullMode);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eFrontFace:
+                        commandBuffer.setFrontFaceEXT(state.frontFace);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eDepthBiasEnable:
+                        commandBuffer.setDepthBiasEnableEXT(state.depthBiasEnable);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eDepthBias:
+                        commandBuffer.setDepthBias(state.depthBiasConstantFactor, state.depthBiasClamp, state.depthBiasSlopeFactor);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eLineWidth:
+                        commandBuffer.setLineWidth(state.lineWidth);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eRasterizationSamplesEXT:
+                        commandBuffer.setRasterizationSamplesEXT(state.rasterizationSamples);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eSampleMaskEXT:
+                        commandBuffer.setSampleMaskEXT(state.rasterizationSamples, state.sampleMask);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eAlphaToCoverageEnableEXT:
+                        commandBuffer.setAlphaToCoverageEnableEXT(state.alphaToCoverageEnable);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eAlphaToOneEnableEXT:
+                        commandBuffer.setAlphaToOneEnableEXT(state.alphaToOneEnable);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eDepthTestEnable:
+                        commandBuffer.setDepthTestEnableEXT(state.depthTestEnable);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eDepthWriteEnable:
+                        commandBuffer.setDepthWriteEnableEXT(state.depthWriteEnable);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eDepthCompareOp:
+                        commandBuffer.setDepthCompareOpEXT(state.depthCompareOp);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eDepthBoundsTestEnable:
+                        commandBuffer.setDepthBoundsTestEnableEXT(state.depthBoundsTestEnable);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eDepthBounds:
+                        commandBuffer.setDepthBounds(state.minDepthBounds, state.maxDepthBounds);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eStencilTestEnable:
+                        commandBuffer.setStencilTestEnableEXT(state.stencilTestEnable);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eStencilOp:
+                        for (const auto& [face, op] : faces) {
+                            commandBuffer.setStencilOpEXT(face, op.failOp, op.passOp, op.depthFailOp, op.compareOp);
+                        }
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eStencilCompareMask:
+                        for (const auto& [face, op] : faces) {
+                            commandBuffer.setStencilCompareMask(face, op.compareMask);
+                        }
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eStencilWriteMask:
+                        for (const auto& [face, op] : faces) {
+                            commandBuffer.setStencilWriteMask(face, op.writeMask);
+                        }
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eStencilReference:
+                        for (const auto& [face, op] : faces) {
+                            commandBuffer.setStencilReference(face, op.reference);
+                        }
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eLogicOpEnableEXT:
+                        commandBuffer.setLogicOpEnableEXT(state.logicOpEnable);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eLogicOpEXT:
+                        commandBuffer.setLogicOpEXT(state.logicOp);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eColorBlendEnableEXT:
+                        commandBuffer.setColorBlendEnableEXT(0, colorBlendEnables);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eColorBlendEquationEXT:
+                        commandBuffer.setColorBlendEquationEXT(0, colorBlendEquations);
+                        break;
+                    case VULKAN_HPP_NAMESPACE::DynamicState::eColorWriteMaskEXT:
+                        commandBuffer.setColorWriteMaskEXT(0, colorWriteMasks);
+                        break;
+                    default:
+                        throw std::runtime_error(CALL_INFO + ": unsupported state: '" + VULKAN_HPP_NAMESPACE::to_string(value) + "'");
+                }
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE ShaderObject::Builder ShaderObject::builder(ShaderObject& object) {
+        return Builder(object);
+    }
+
+    EXQUDENS_VULKAN_INLINE std::vector<VULKAN_HPP_NAMESPACE::ShaderStageFlagBits> ShaderObject::bindStages() const {
+        try {
+            std::vector<VULKAN_HPP_NAMESPACE::ShaderStageFlagBits> result = {};
+
+            for (const Stage& stage : stages) {
+                result.emplace_back(stage.stage);
+            }
+
+            // every graphics stage the device supports has to be bound before a draw, the unused ones to null
+            bool graphics = std::any_of(stages.begin(), stages.end(), [](const Stage& value) {
+                return value.stage == VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eVertex
+                    || value.stage == VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eMeshEXT;
+            });
+
+            if (!graphics) {
+                return result;
+            }
+
+            std::vector<VULKAN_HPP_NAMESPACE::ShaderStageFlagBits> values = {VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eVertex};
+
+            if (features.tessellationShader) {
+                values.emplace_back(VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eTessellationControl);
+                values.emplace_back(VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eTessellationEvaluation);
+            }
+
+            if (features.geometryShader) {
+                values.emplace_back(VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eGeometry);
+            }
+
+            values.emplace_back(VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eFragment);
+
+            if (features.taskShader) {
+                values.emplace_back(VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eTaskEXT);
+            }
+
+            if (features.meshShader) {
+                values.emplace_back(VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eMeshEXT);
+            }
+
+            for (VULKAN_HPP_NAMESPACE::ShaderStageFlagBits value : values) {
+                if (std::find(result.begin(), result.end(), value) == result.end()) {
+                    result.emplace_back(value);
+                }
+            }
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void ShaderObject::bind(VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer) const {
+        try {
+            if (targets.size() != stages.size()) {
+                throw std::runtime_error(CALL_INFO + ": 'targets' size does not match 'stages'");
+            }
+
+            // own stages come first, followed by the null ones
+            std::vector<VULKAN_HPP_NAMESPACE::ShaderStageFlagBits> stageBits = bindStages();
+            std::vector<VULKAN_HPP_NAMESPACE::ShaderEXT> shaders(stageBits.size(), nullptr);
+
+            for (size_t i = 0; i < targets.size(); i++) {
+                shaders.at(i) = *targets.at(i);
+            }
+
+            commandBuffer.bindShadersEXT(stageBits, shaders);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void ShaderObject::clear() {
+        try {
+            stages.clear();
+            setLayouts.clear();
+            pushConstantRanges.clear();
+            link = true;
+            features = {};
+            createInfos.clear();
+            targets.clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void ShaderObject::clearAndRelease() {
+        try {
+            for (VULKAN_HPP_NAMESPACE::raii::ShaderEXT& target : targets) {
+                target.release();
+            }
+            clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE ShaderObject::Builder::Builder(ShaderObject& object): object(object) {
+    }
+
+    EXQUDENS_VULKAN_INLINE ShaderObject::Builder& ShaderObject::Builder::addStage(
+        const VULKAN_HPP_NAMESPACE::ShaderStageFlagBits& stage,
+        std::span<const uint32_t> code,
+        const std::string& name
+    ) {
+        Stage value = {};
+        value.stage = stage;
+        value.code.assign(code.begin(), code.end());
+        value.name = name;
+        object.stages.emplace_back(std::move(value));
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE ShaderObject::Builder& ShaderObject::Builder::addSpirv(
+        const VULKAN_HPP_NAMESPACE::ShaderStageFlagBits& stage,
+        const Spirv& value,
+        const std::string& name
+    ) {
+        return addStage(stage, value.code, name);
+    }
+
+    EXQUDENS_VULKAN_INLINE ShaderObject::Builder& ShaderObject::Builder::setSetLayouts(const std::vector<VULKAN_HPP_NAMESPACE::DescriptorSetLayout>& value) {
+        object.setLayouts = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE ShaderObject::Builder& ShaderObject::Builder::setPushConstantRanges(const std::vector<VULKAN_HPP_NAMESPACE::PushConstantRange>& value) {
+        object.pushConstantRanges = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE ShaderObject::Builder& ShaderObject::Builder::setLink(bool value) {
+        object.link = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE ShaderObject::Builder& ShaderObject::Builder::setFeatures(const Features& value) {
+        object.features = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE ShaderObject& ShaderObject::Builder::build(
+        VULKAN_HPP_NAMESPACE::raii::Device& device
+    ) {
+        try {
+            if (object.stages.empty()) {
+                throw std::runtime_error(CALL_INFO + ": 'stages' is empty");
+            }
+
+            // linking only applies to more than one stage, each stage then names the one after it
+            bool link = object.link && object.stages.size() > 1;
+
+            object.createInfos.clear();
+            object.targets.clear();
+
+            for (size_t i = 0; i < object.stages.size(); i++) {
+                Stage& stage = object.stages.at(i);
+
+                if (stage.code.empty()) {
+                    throw std::runtime_error(CALL_INFO + ": 'code' is empty");
+                }
+
+                if (!stage.nextStage && i + 1 < object.stages.size()) {
+                    stage.nextStage = object.stages.at(i + 1).stage;
+                }
+
+                object.createInfos.emplace_back(
+                    VULKAN_HPP_NAMESPACE::ShaderCreateInfoEXT()
+                    .setFlags(link ? VULKAN_HPP_NAMESPACE::ShaderCreateFlagBitsEXT::eLinkStage : VULKAN_HPP_NAMESPACE::ShaderCreateFlagsEXT())
+                    .setStage(stage.stage)
+                    .setNextStage(stage.nextStage)
+                    .setCodeType(VULKAN_HPP_NAMESPACE::ShaderCodeTypeEXT::eSpirv)
+                    .setCodeSize(stage.code.size() * sizeof(uint32_t))
+                    .setPCode(stage.code.data())
+                    .setPName(stage.name.c_str())
+                    .setSetLayouts(object.setLayouts)
+                    .setPushConstantRanges(object.pushConstantRanges)
+                );
+            }
+
+            VULKAN_HPP_NAMESPACE::raii::ShadersEXT shaders(device, object.createInfos);
+
+            for (VULKAN_HPP_NAMESPACE::raii::ShaderEXT& shader : shaders) {
+                object.targets.emplace_back(std::move(shader));
+            }
+
+            return object;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
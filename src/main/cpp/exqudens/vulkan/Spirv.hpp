@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "exqudens/vulkan/export.hpp"
+
+namespace exqudens::vulkan {
+
+    struct EXQUDENS_VULKAN_EXPORT Spirv {
+
+        std::string_view name = {};
+        std::span<const uint32_t> code = {};
+
+        static const Spirv& find(std::span<const Spirv> registry, std::string_view name);
+
+    };
+
+}
+
+// implementation ---
+
+#include <string>
+#include <filesystem>
+#include <stdexcept>
+
+#define CALL_INFO std::string(__FUNCTION__) + " (" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::vulkan {
+
+    EXQUDENS_VULKAN_INLINE const Spirv& Spirv::find(std::span<const Spirv> registry, std::string_view name) {
+        try {
+            for (const Spirv& value : registry) {
+                if (value.name == name) {
+                    return value;
+                }
+            }
+
+            throw std::runtime_error(CALL_INFO + ": not found '" + std::string(name) + "'");
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
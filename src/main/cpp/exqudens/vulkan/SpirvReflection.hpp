@@ -0,0 +1,609 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <span>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "exqudens/vulkan/export.hpp"
+#include "exqudens/vulkan/Spirv.hpp"
+#include "exqudens/vulkan/ShaderModule.hpp"
+#include "exqudens/vulkan/DescriptorSetLayout.hpp"
+#include "exqudens/vulkan/PipelineLayout.hpp"
+#include "exqudens/vulkan/Pipeline.hpp"
+
+namespace exqudens::vulkan {
+
+    struct EXQUDENS_VULKAN_EXPORT SpirvReflection {
+
+        class Builder;
+
+        std::vector<std::vector<uint32_t>> codes = {};
+        std::optional<uint32_t> runtimeArrayDescriptorCount = {};
+        std::vector<std::vector<VULKAN_HPP_NAMESPACE::DescriptorSetLayoutBinding>> setBindings = {};
+        // per set, the lowest set with identical bindings, so one layout can be created and shared
+        std::vector<uint32_t> setLayoutIndices = {};
+        std::vector<VULKAN_HPP_NAMESPACE::PushConstantRange> pushConstantRanges = {};
+        std::vector<VULKAN_HPP_NAMESPACE::VertexInputBindingDescription> vertexBindings = {};
+        std::vector<VULKAN_HPP_NAMESPACE::VertexInputAttributeDescription> vertexAttributes = {};
+
+        static Builder builder(SpirvReflection& object);
+
+        static VULKAN_HPP_NAMESPACE::Format formatFrom(bool floatingPoint, bool signedness, uint32_t width, uint32_t componentCount);
+
+        void reflect(std::span<const uint32_t> code);
+
+        DescriptorSetLayout::Builder& fill(uint32_t set, DescriptorSetLayout::Builder& builder);
+
+        PipelineLayout::Builder& fill(PipelineLayout::Builder& builder);
+
+        Pipeline::Builder& fill(Pipeline::Builder& builder);
+
+        void clear();
+
+        void clearAndRelease();
+
+    };
+
+    class EXQUDENS_VULKAN_EXPORT SpirvReflection::Builder {
+
+        private:
+
+            SpirvReflection& object;
+
+        public:
+
+            explicit Builder(SpirvReflection& object);
+
+            Builder& addCode(std::span<const uint32_t> value);
+
+            Builder& addSpirv(const Spirv& value);
+
+            Builder& addShaderModule(const ShaderModule& value);
+
+            Builder& setRuntimeArrayDescriptorCount(uint32_t value);
+
+            SpirvReflection& build();
+
+    };
+
+}
+
+// implementation ---
+
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <string>
+#include <filesystem>
+#include <stdexcept>
+
+#define CALL_INFO std::string(__FUNCTION__) + " (" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::vulkan {
+
+    EXQUDENS_VULKAN_INLINE SpirvReflection::Builder SpirvReflection::builder(SpirvReflection& object) {
+        return Builder(object);
+    }
+
+    EXQUDENS_VULKAN_INLINE VULKAN_HPP_NAMESPACE::Format SpirvReflection::formatFrom(bool floatingPoint, bool signedness, uint32_t width, uint32_t componentCount) {
+        try {
+            using Format = VULKAN_HPP_NAMESPACE::Format;
+
+            if (componentCount < 1 || componentCount > 4) {
+                throw std::runtime_error(CALL_INFO + ": unsupported component count " + std::to_string(componentCount));
+            }
+
+            size_t index = componentCount - 1;
+
+            if (width == 16) {
+                static const Format sfloat[] = {Format::eR16Sfloat, Format::eR16G16Sfloat, Format::eR16G16B16Sfloat, Format::eR16G16B16A16Sfloat};
+                static const Format sint[] = {Format::eR16Sint, Format::eR16G16Sint, Format::eR16G16B16Sint, Format::eR16G16B16A16Sint};
+                static const Format uint[] = {Format::eR16Uint, Format::eR16G16Uint, Format::eR16G16B16Uint, Format::eR16G16B16A16Uint};
+                return floatingPoint ? sfloat[index] : (signedness ? sint[index] : uint[index]);
+            } else if (width == 32) {
+                static const Format sfloat[] = {Format::eR32Sfloat, Format::eR32G32Sfloat, Format::eR32G32B32Sfloat, Format::eR32G32B32A32Sfloat};
+                static const Format sint[] = {Format::eR32Sint, Format::eR32G32Sint, Format::eR32G32B32Sint, Format::eR32G32B32A32Sint};
+                static const Format uint[] = {Format::eR32Uint, Format::eR32G32Uint, Format::eR32G32B32Uint, Format::eR32G32B32A32Uint};
+                return floatingPoint ? sfloat[index] : (signedness ? sint[index] : uint[index]);
+            } else if (width == 64) {
+                static const Format sfloat[] = {Format::eR64Sfloat, Format::eR64G64Sfloat, Format::eR64G64B64Sfloat, Format::eR64G64B64A64Sfloat};
+                static const Format sint[] = {Format::eR64Sint, Format::eR64G64Sint, Format::eR64G64B64Sint, Format::eR64G64B64A64Sint};
+                static const Format uint[] = {Format::eR64Uint, Format::eR64G64Uint, Format::eR64G64B64Uint, Format::eR64G64B64A64Uint};
+                return floatingPoint ? sfloat[index] : (signedness ? sint[index] : uint[index]);
+            }
+
+            throw std::runtime_error(CALL_INFO + ": unsupported component width " + std::to_string(width));
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void SpirvReflection::reflect(std::span<const uint32_t> code) {
+        try {
+            // opcodes, decorations, storage classes and execution models from the spir-v specification
+            enum : uint32_t {
+                OP_ENTRY_POINT = 15,
+                OP_TYPE_BOOL = 20,
+                OP_TYPE_INT = 21,
+                OP_TYPE_FLOAT = 22,
+                OP_TYPE_VECTOR = 23,
+                OP_TYPE_MATRIX = 24,
+                OP_TYPE_IMAGE = 25,
+                OP_TYPE_SAMPLER = 26,
+                OP_TYPE_SAMPLED_IMAGE = 27,
+                OP_TYPE_ARRAY = 28,
+                OP_TYPE_RUNTIME_ARRAY = 29,
+                OP_TYPE_STRUCT = 30,
+                OP_TYPE_POINTER = 32,
+                OP_CONSTANT = 43,
+                OP_SPEC_CONSTANT = 50,
+                OP_VARIABLE = 59,
+                OP_DECORATE = 71,
+                OP_MEMBER_DECORATE = 72,
+                OP_TYPE_ACCELERATION_STRUCTURE = 5341,
+
+                DECORATION_BLOCK = 2,
+                DECORATION_BUFFER_BLOCK = 3,
+                DECORATION_ARRAY_STRIDE = 6,
+                DECORATION_BUILT_IN = 11,
+                DECORATION_LOCATION = 30,
+                DECORATION_BINDING = 33,
+                DECORATION_DESCRIPTOR_SET = 34,
+                DECORATION_OFFSET = 35,
+
+                STORAGE_UNIFORM_CONSTANT = 0,
+                STORAGE_INPUT = 1,
+                STORAGE_UNIFORM = 2,
+                STORAGE_PUSH_CONSTANT = 9,
+                STORAGE_STORAGE_BUFFER = 12,
+
+                DIM_BUFFER = 5,
+                DIM_SUBPASS_DATA = 6
+            };
+
+            struct Decoration {
+                std::optional<uint32_t> set = {};
+                std::optional<uint32_t> binding = {};
+                std::optional<uint32_t> location = {};
+                std::optional<uint32_t> arrayStride = {};
+                bool builtIn = false;
+                bool block = false;
+                bool bufferBlock = false;
+                std::unordered_map<uint32_t, uint32_t> memberOffsets = {};
+            };
+
+            struct Variable {
+                uint32_t id = 0;
+                uint32_t type = 0;
+                uint32_t storage = 0;
+            };
+
+            if (!ShaderModule::isSpirv(code.data(), code.size_bytes())) {
+                throw std::runtime_error(CALL_INFO + ": 'code' is not spir-v");
+            }
+
+            VULKAN_HPP_NAMESPACE::ShaderStageFlags stages = {};
+            std::unordered_set<uint32_t> vertexInterface = {};
+            std::unordered_map<uint32_t, std::vector<uint32_t>> types = {};
+            std::unordered_map<uint32_t, uint32_t> constants = {};
+            std::unordered_map<uint32_t, Decoration> decorations = {};
+            std::vector<Variable> variables = {};
+
+            for (size_t i = 5; i < code.size();) {
+                const uint32_t* words = code.data() + i;
+                uint32_t wordCount = words[0] >> 16;
+                uint32_t opcode = words[0] & 0xffff;
+
+                if (wordCount == 0 || i + wordCount > code.size()) {
+                    throw std::runtime_error(CALL_INFO + ": malformed instruction at word " + std::to_string(i));
+                }
+
+                switch (opcode) {
+                    case OP_ENTRY_POINT: {
+                        VULKAN_HPP_NAMESPACE::ShaderStageFlagBits stage = {};
+                        switch (words[1]) {
+                            case 0: stage = VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eVertex; break;
+                            case 1: stage = VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eTessellationControl; break;
+                            case 2: stage = VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eTessellationEvaluation; break;
+                            case 3: stage = VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eGeometry; break;
+                            case 4: stage = VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eFragment; break;
+                            case 5: stage = VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eCompute; break;
+                            case 5364: stage = VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eTaskEXT; break;
+                            case 5365: stage = VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eMeshEXT; break;
+                            default: throw std::runtime_error(CALL_INFO + ": unsupported execution model " + std::to_string(words[1]));
+                        }
+                        stages |= stage;
+
+                        // skip the null terminated name, the rest is the interface
+                        uint32_t index = 3;
+                        while (index < wordCount) {
+                            uint32_t word = words[index++];
+                            if ((word & 0xff) == 0 || (word & 0xff00) == 0 || (word & 0xff0000) == 0 || (word & 0xff000000) == 0) {
+                                break;
+                            }
+                        }
+                        if (stage == VULKAN_HPP_NAMESPACE::ShaderStageFlagBits::eVertex) {
+                            vertexInterface.insert(words + index, words + wordCount);
+                        }
+                        break;
+                    }
+                    case OP_DECORATE: {
+                        Decoration& decoration = decorations[words[1]];
+                        switch (words[2]) {
+                            case DECORATION_BLOCK: decoration.block = true; break;
+                            case DECORATION_BUFFER_BLOCK: decoration.bufferBlock = true; break;
+                            case DECORATION_BUILT_IN: decoration.builtIn = true; break;
+                            case DECORATION_ARRAY_STRIDE: decoration.arrayStride = words[3]; break;
+                            case DECORATION_LOCATION: decoration.location = words[3]; break;
+                            case DECORATION_BINDING: decoration.binding = words[3]; break;
+                            case DECORATION_DESCRIPTOR_SET: decoration.set = words[3]; break;
+                            default: break;
+                        }
+                        break;
+                    }
+                    case OP_MEMBER_DECORATE: {
+                        Decoration& decoration = decorations[words[1]];
+                        if (words[3] == DECORATION_OFFSET) {
+                            decoration.memberOffsets[words[2]] = words[4];
+                        } else if (words[3] == DECORATION_BUILT_IN) {
+                            decoration.builtIn = true;
+                        }
+                        break;
+                    }
+                    case OP_TYPE_BOOL:
+                    case OP_TYPE_INT:
+                    case OP_TYPE_FLOAT:
+                    case OP_TYPE_VECTOR:
+                    case OP_TYPE_MATRIX:
+                    case OP_TYPE_IMAGE:
+                    case OP_TYPE_SAMPLER:
+                    case OP_TYPE_SAMPLED_IMAGE:
+                    case OP_TYPE_ARRAY:
+                    case OP_TYPE_RUNTIME_ARRAY:
+                    case OP_TYPE_STRUCT:
+                    case OP_TYPE_POINTER:
+                    case OP_TYPE_ACCELERATION_STRUCTURE: {
+                        // opcode first, then the operands after the result id
+                        std::vector<uint32_t> type = {opcode};
+                        type.insert(type.end(), words + 2, words + wordCount);
+                        types[words[1]] = std::move(type);
+                        break;
+                    }
+                    case OP_CONSTANT:
+                    case OP_SPEC_CONSTANT: {
+                        constants[words[2]] = wordCount > 3 ? words[3] : 0;
+                        break;
+                    }
+                    case OP_VARIABLE: {
+                        variables.emplace_back(Variable {words[2], words[1], words[3]});
+                        break;
+                    }
+                    default:
+                        break;
+                }
+
+                i += wordCount;
+            }
+
+            auto typeOf = [&types](uint32_t id) -> const std::vector<uint32_t>& {
+                auto it = types.find(id);
+                if (it == types.end()) {
+                    throw std::runtime_error(CALL_INFO + ": unknown type id " + std::to_string(id));
+                }
+                return it->second;
+            };
+
+            std::function<uint32_t(uint32_t)> sizeOf = [&](uint32_t id) -> uint32_t {
+                const std::vector<uint32_t>& type = typeOf(id);
+                switch (type.at(0)) {
+                    case OP_TYPE_BOOL:
+                        return 4;
+                    case OP_TYPE_INT:
+                    case OP_TYPE_FLOAT:
+                        return type.at(1) / 8;
+                    case OP_TYPE_VECTOR:
+                    case OP_TYPE_MATRIX:
+                        return sizeOf(type.at(1)) * type.at(2);
+                    case OP_TYPE_ARRAY: {
+                        auto decoration = decorations.find(id);
+                        uint32_t stride = decoration != decorations.end() && decoration->second.arrayStride.has_value() ? decoration->second.arrayStride.value() : sizeOf(type.at(1));
+                        return stride * constants.at(type.at(2));
+                    }
+                    case OP_TYPE_STRUCT: {
+                        uint32_t result = 0;
+                        auto decoration = decorations.find(id);
+                        for (size_t member = 1; member < type.size(); member++) {
+                            uint32_t offset = 0;
+                            if (decoration != decorations.end() && decoration->second.memberOffsets.contains(static_cast<uint32_t>(member - 1))) {
+                                offset = decoration->second.memberOffsets.at(static_cast<uint32_t>(member - 1));
+                            }
+                            result = std::max(result, offset + sizeOf(type.at(member)));
+                        }
+                        return result;
+                    }
+                    case OP_TYPE_POINTER:
+                        return 8;
+                    default:
+                        throw std::runtime_error(CALL_INFO + ": type id " + std::to_string(id) + " has no size");
+                }
+            };
+
+            std::vector<VULKAN_HPP_NAMESPACE::VertexInputAttributeDescription> attributes = {};
+
+            for (const Variable& variable : variables) {
+                const Decoration& decoration = decorations[variable.id];
+                uint32_t typeId = typeOf(variable.type).at(2);
+
+                if (variable.storage == STORAGE_UNIFORM_CONSTANT || variable.storage == STORAGE_UNIFORM || variable.storage == STORAGE_STORAGE_BUFFER) {
+                    if (!decoration.set.has_value() || !decoration.binding.has_value()) {
+                        continue;
+                    }
+
+                    uint32_t count = 1;
+                    if (typeOf(typeId).at(0) == OP_TYPE_ARRAY) {
+                        count = constants.at(typeOf(typeId).at(2));
+                        typeId = typeOf(typeId).at(1);
+                    } else if (typeOf(typeId).at(0) == OP_TYPE_RUNTIME_ARRAY) {
+                        count = runtimeArrayDescriptorCount.value_or(1);
+                        typeId = typeOf(typeId).at(1);
+                    }
+
+                    const std::vector<uint32_t>& type = typeOf(typeId);
+                    VULKAN_HPP_NAMESPACE::DescriptorType descriptorType = {};
+
+                    if (type.at(0) == OP_TYPE_SAMPLER) {
+                        descriptorType = VULKAN_HPP_NAMESPACE::DescriptorType::eSampler;
+                    } else if (type.at(0) == OP_TYPE_SAMPLED_IMAGE) {
+                        bool buffer = typeOf(type.at(1)).at(2) == DIM_BUFFER;
+                        descriptorType = buffer ? VULKAN_HPP_NAMESPACE::DescriptorType::eUniformTexelBuffer : VULKAN_HPP_NAMESPACE::DescriptorType::eCombinedImageSampler;
+                    } else if (type.at(0) == OP_TYPE_IMAGE) {
+                        // operands: sampled type, dim, depth, arrayed, ms, sampled, format
+                        bool storage = type.at(6) == 2;
+                        if (type.at(2) == DIM_BUFFER) {
+                            descriptorType = storage ? VULKAN_HPP_NAMESPACE::DescriptorType::eStorageTexelBuffer : VULKAN_HPP_NAMESPACE::DescriptorType::eUniformTexelBuffer;
+                        } else if (type.at(2) == DIM_SUBPASS_DATA) {
+                            descriptorType = VULKAN_HPP_NAMESPACE::DescriptorType::eInputAttachment;
+                        } else {
+                            descriptorType = storage ? VULKAN_HPP_NAMESPACE::DescriptorType::eStorageImage : VULKAN_HPP_NAMESPACE::DescriptorType::eSampledImage;
+                        }
+                    } else if (type.at(0) == OP_TYPE_ACCELERATION_STRUCTURE) {
+                        descriptorType = VULKAN_HPP_NAMESPACE::DescriptorType::eAccelerationStructureKHR;
+                    } else if (type.at(0) == OP_TYPE_STRUCT) {
+                        bool bufferBlock = decorations[typeId].bufferBlock;
+                        descriptorType = variable.storage == STORAGE_STORAGE_BUFFER || bufferBlock ? VULKAN_HPP_NAMESPACE::DescriptorType::eStorageBuffer : VULKAN_HPP_NAMESPACE::DescriptorType::eUniformBuffer;
+                    } else {
+                        throw std::runtime_error(CALL_INFO + ": unsupported descriptor type of variable " + std::to_string(variable.id));
+                    }
+
+                    if (setBindings.size() <= decoration.set.value()) {
+                        setBindings.resize(decoration.set.value() + 1);
+                    }
+
+                    // the same binding seen from another stage only widens the stage flags
+                    std::vector<VULKAN_HPP_NAMESPACE::DescriptorSetLayoutBinding>& bindings = setBindings.at(decoration.set.value());
+                    auto it = std::find_if(bindings.begin(), bindings.end(), [&decoration](const VULKAN_HPP_NAMESPACE::DescriptorSetLayoutBinding& value) {
+                        return value.binding == decoration.binding.value();
+                    });
+
+                    if (it == bindings.end()) {
+                        bindings.emplace_back(
+                            VULKAN_HPP_NAMESPACE::DescriptorSetLayoutBinding()
+                            .setBinding(decoration.binding.value())
+                            .setDescriptorType(descriptorType)
+                            .setDescriptorCount(count)
+                            .setStageFlags(stages)
+                        );
+                        std::sort(bindings.begin(), bindings.end(), [](const VULKAN_HPP_NAMESPACE::DescriptorSetLayoutBinding& a, const VULKAN_HPP_NAMESPACE::DescriptorSetLayoutBinding& b) {
+                            return a.binding < b.binding;
+                        });
+                    } else if (it->descriptorType != descriptorType || it->descriptorCount != count) {
+                        throw std::runtime_error(CALL_INFO + ": conflicting declarations of set " + std::to_string(decoration.set.value()) + " binding " + std::to_string(decoration.binding.value()));
+                    } else {
+                        it->stageFlags |= stages;
+                    }
+                } else if (variable.storage == STORAGE_PUSH_CONSTANT) {
+                    const Decoration& block = decorations[typeId];
+                    uint32_t offset = UINT32_MAX;
+                    for (const auto& [member, memberOffset] : block.memberOffsets) {
+                        offset = std::min(offset, memberOffset);
+                    }
+                    if (offset == UINT32_MAX) {
+                        offset = 0;
+                    }
+                    uint32_t size = sizeOf(typeId) - offset;
+
+                    auto it = std::find_if(pushConstantRanges.begin(), pushConstantRanges.end(), [offset, size](const VULKAN_HPP_NAMESPACE::PushConstantRange& value) {
+                        return value.offset == offset && value.size == size;
+                    });
+
+                    if (it == pushConstantRanges.end()) {
+                        pushConstantRanges.emplace_back(stages, offset, size);
+                    } else {
+                        it->stageFlags |= stages;
+                    }
+                } else if (variable.storage == STORAGE_INPUT && vertexInterface.contains(variable.id)) {
+                    if (decoration.builtIn || decorations[typeId].builtIn || !decoration.location.has_value()) {
+                        continue;
+                    }
+
+                    // a matrix input takes one location per column, a 64 bit column of three or four components takes two
+                    const std::vector<uint32_t>& type = typeOf(typeId);
+                    uint32_t columnCount = type.at(0) == OP_TYPE_MATRIX ? type.at(2) : 1;
+                    uint32_t columnTypeId = type.at(0) == OP_TYPE_MATRIX ? type.at(1) : typeId;
+                    const std::vector<uint32_t>& columnType = typeOf(columnTypeId);
+                    uint32_t componentCount = columnType.at(0) == OP_TYPE_VECTOR ? columnType.at(2) : 1;
+                    const std::vector<uint32_t>& componentType = columnType.at(0) == OP_TYPE_VECTOR ? typeOf(columnType.at(1)) : columnType;
+                    bool floatingPoint = componentType.at(0) == OP_TYPE_FLOAT;
+                    bool signedness = componentType.at(0) == OP_TYPE_INT && componentType.at(2) == 1;
+                    uint32_t columnLocationCount = componentType.at(1) == 64 && componentCount > 2 ? 2 : 1;
+
+                    for (uint32_t column = 0; column < columnCount; column++) {
+                        attributes.emplace_back(
+                            VULKAN_HPP_NAMESPACE::VertexInputAttributeDescription()
+                            .setLocation(decoration.location.value() + column * columnLocationCount)
+                            .setBinding(0)
+                            .setFormat(formatFrom(floatingPoint, signedness, componentType.at(1), componentCount))
+                            .setOffset(sizeOf(columnTypeId))
+                        );
+                    }
+                }
+            }
+
+            if (!vertexInterface.empty()) {
+                // inputs are assumed interleaved in one buffer, packed in location order
+                std::sort(attributes.begin(), attributes.end(), [](const VULKAN_HPP_NAMESPACE::VertexInputAttributeDescription& a, const VULKAN_HPP_NAMESPACE::VertexInputAttributeDescription& b) {
+                    return a.location < b.location;
+                });
+
+                uint32_t stride = 0;
+                for (VULKAN_HPP_NAMESPACE::VertexInputAttributeDescription& attribute : attributes) {
+                    uint32_t size = attribute.offset;
+                    attribute.offset = stride;
+                    stride += size;
+                }
+
+                vertexAttributes = attributes;
+                vertexBindings.clear();
+                if (!attributes.empty()) {
+                    vertexBindings.emplace_back(0, stride, VULKAN_HPP_NAMESPACE::VertexInputRate::eVertex);
+                }
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE DescriptorSetLayout::Builder& SpirvReflection::fill(uint32_t set, DescriptorSetLayout::Builder& builder) {
+        try {
+            if (set >= setBindings.size()) {
+                return builder.setBindings({});
+            }
+
+            return builder.setBindings(setBindings.at(set));
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE PipelineLayout::Builder& SpirvReflection::fill(PipelineLayout::Builder& builder) {
+        try {
+            return builder.setPushConstantRanges(pushConstantRanges);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE Pipeline::Builder& SpirvReflection::fill(Pipeline::Builder& builder) {
+        try {
+            return builder
+            .setVertexInputStateCreateInfoBindings(vertexBindings)
+            .setVertexInputStateCreateInfoAttributes(vertexAttributes)
+            .setVertexInputStateCreateInfo(VULKAN_HPP_NAMESPACE::PipelineVertexInputStateCreateInfo());
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void SpirvReflection::clear() {
+        try {
+            codes.clear();
+            runtimeArrayDescriptorCount.reset();
+            setBindings.clear();
+            setLayoutIndices.clear();
+            pushConstantRanges.clear();
+            vertexBindings.clear();
+            vertexAttributes.clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void SpirvReflection::clearAndRelease() {
+        try {
+            clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE SpirvReflection::Builder::Builder(SpirvReflection& object): object(object) {
+    }
+
+    EXQUDENS_VULKAN_INLINE SpirvReflection::Builder& SpirvReflection::Builder::addCode(std::span<const uint32_t> value) {
+        object.codes.emplace_back(value.begin(), value.end());
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE SpirvReflection::Builder& SpirvReflection::Builder::addSpirv(const Spirv& value) {
+        return addCode(value.code);
+    }
+
+    EXQUDENS_VULKAN_INLINE SpirvReflection::Builder& SpirvReflection::Builder::addShaderModule(const ShaderModule& value) {
+        try {
+            if (!value.codeView.empty()) {
+                return addCode(value.codeView);
+            }
+
+            // a mapped module keeps no code, its file is mapped again and read in place
+            if (value.mapFile && value.file.has_value()) {
+                ShaderModule::FileMapping mapping(value.file.value());
+
+                if (!ShaderModule::isSpirv(mapping.data, mapping.size)) {
+                    throw std::runtime_error(CALL_INFO + ": not a spir-v file " + std::string(value.file.value()));
+                }
+
+                return addCode(std::span<const uint32_t>(static_cast<const uint32_t*>(mapping.data), mapping.size / sizeof(uint32_t)));
+            }
+
+            if (value.code.empty()) {
+                throw std::runtime_error(CALL_INFO + ": shader module keeps no code");
+            }
+
+            // 'code' is a char vector without word alignment, so it is copied
+            std::vector<uint32_t> words((value.code.size() + sizeof(uint32_t) - 1) / sizeof(uint32_t), 0);
+            std::memcpy(words.data(), value.code.data(), value.code.size());
+            object.codes.emplace_back(std::move(words));
+
+            return *this;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE SpirvReflection::Builder& SpirvReflection::Builder::setRuntimeArrayDescriptorCount(uint32_t value) {
+        object.runtimeArrayDescriptorCount = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE SpirvReflection& SpirvReflection::Builder::build() {
+        try {
+            object.setBindings.clear();
+            object.setLayoutIndices.clear();
+            object.pushConstantRanges.clear();
+            object.vertexBindings.clear();
+            object.vertexAttributes.clear();
+
+            for (const std::vector<uint32_t>& code : object.codes) {
+                object.reflect(code);
+            }
+
+            for (size_t i = 0; i < object.setBindings.size(); i++) {
+                auto it = std::find(object.setBindings.begin(), object.setBindings.begin() + static_cast<std::ptrdiff_t>(i), object.setBindings.at(i));
+                object.setLayoutIndices.emplace_back(static_cast<uint32_t>(it - object.setBindings.begin()));
+            }
+
+            return object;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
@@ -7,6 +7,7 @@
 #include <vulkan/vulkan_raii.hpp>
 
 #include "exqudens/vulkan/export.hpp"
+#include "exqudens/vulkan/DeferredRelease.hpp"
 
 namespace exqudens::vulkan {
 
@@ -47,6 +48,11 @@ namespace exqudens::vulkan {
 
             Builder& setCreateInfo(const VULKAN_HPP_NAMESPACE::SwapchainCreateInfoKHR& value);
 
+            Swapchain& build(
+                VULKAN_HPP_NAMESPACE::raii::Device& device,
+                DeferredRelease& deferredRelease
+            );
+
             Swapchain& build(
                 VULKAN_HPP_NAMESPACE::raii::Device& device
             );
@@ -57,6 +63,7 @@ namespace exqudens::vulkan {
 // implementation ---
 
 #include <string>
+#include <utility>
 #include <algorithm>
 #include <filesystem>
 #include <stdexcept>
@@ -212,6 +219,34 @@ namespace exqudens::vulkan {
         return *this;
     }
 
+    EXQUDENS_VULKAN_INLINE Swapchain& Swapchain::Builder::build(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        DeferredRelease& deferredRelease
+    ) {
+        try {
+            // the old swapchain keeps presenting until the new one takes over and is destroyed once its frames retire
+            VULKAN_HPP_NAMESPACE::raii::SwapchainKHR oldTarget = std::move(object.target);
+
+            if (!object.createInfo.has_value()) {
+                object.createInfo = VULKAN_HPP_NAMESPACE::SwapchainCreateInfoKHR();
+            }
+
+            object.createInfo.value().oldSwapchain = *oldTarget;
+
+            build(device);
+
+            object.createInfo.value().oldSwapchain = nullptr;
+
+            if (*oldTarget) {
+                deferredRelease.hold(std::move(oldTarget));
+            }
+
+            return object;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
     EXQUDENS_VULKAN_INLINE Swapchain& Swapchain::Builder::build(
         VULKAN_HPP_NAMESPACE::raii::Device& device
     ) {
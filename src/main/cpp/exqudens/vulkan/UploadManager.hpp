@@ -0,0 +1,630 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "exqudens/vulkan/export.hpp"
+#include "exqudens/vulkan/Buffer.hpp"
+#include "exqudens/vulkan/DeviceMemory.hpp"
+#include "exqudens/vulkan/Image.hpp"
+#include "exqudens/vulkan/CommandPool.hpp"
+#include "exqudens/vulkan/Semaphore.hpp"
+
+namespace exqudens::vulkan {
+
+    struct EXQUDENS_VULKAN_EXPORT UploadManager {
+
+        class Builder;
+
+        struct Ticket {
+            VULKAN_HPP_NAMESPACE::Semaphore semaphore = nullptr;
+            uint64_t value = 0;
+            // acquire halves of queue family ownership transfers, recorded by the consumer through 'acquire'
+            std::vector<VULKAN_HPP_NAMESPACE::BufferMemoryBarrier> bufferBarriers = {};
+            std::vector<VULKAN_HPP_NAMESPACE::ImageMemoryBarrier> imageBarriers = {};
+        };
+
+        struct Chunk {
+            Buffer buffer = {};
+            DeviceMemory memory = {};
+            VULKAN_HPP_NAMESPACE::DeviceSize head = 0;
+            uint64_t value = 0;
+        };
+
+        struct Submission {
+            uint64_t value = 0;
+            VULKAN_HPP_NAMESPACE::raii::CommandBuffer commandBuffer = nullptr;
+        };
+
+        std::optional<uint32_t> queueFamilyIndex = {};
+        std::optional<VULKAN_HPP_NAMESPACE::DeviceSize> chunkSize = {};
+        std::optional<VULKAN_HPP_NAMESPACE::DeviceSize> alignment = {};
+        std::optional<VULKAN_HPP_NAMESPACE::PhysicalDeviceMemoryProperties> memoryProperties = {};
+        std::optional<VULKAN_HPP_NAMESPACE::SemaphoreTypeCreateInfo> semaphoreTypeCreateInfo = {};
+        CommandPool commandPool = {};
+        Semaphore semaphore = {};
+        uint64_t value = 0;
+        std::vector<Chunk> chunks = {};
+        std::vector<Submission> submissions = {};
+        std::optional<size_t> recordingIndex = {};
+        std::vector<VULKAN_HPP_NAMESPACE::BufferMemoryBarrier> bufferBarriers = {};
+        std::vector<VULKAN_HPP_NAMESPACE::ImageMemoryBarrier> imageBarriers = {};
+
+        static Builder builder(UploadManager& object);
+
+        // the consumer waits on the ticket semaphore at 'dstStageMask' and records this before the first use
+        static void acquire(
+            VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer,
+            const Ticket& ticket,
+            const VULKAN_HPP_NAMESPACE::PipelineStageFlags& dstStageMask
+        );
+
+        Ticket uploadBuffer(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            const void* data,
+            const VULKAN_HPP_NAMESPACE::DeviceSize& size,
+            const VULKAN_HPP_NAMESPACE::Buffer& dstBuffer,
+            const VULKAN_HPP_NAMESPACE::DeviceSize& dstOffset = 0,
+            const std::optional<uint32_t>& dstQueueFamilyIndex = {}
+        );
+
+        Ticket uploadImage(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            const void* data,
+            const VULKAN_HPP_NAMESPACE::DeviceSize& size,
+            Image& dstImage,
+            const VULKAN_HPP_NAMESPACE::ImageLayout& finalLayout = VULKAN_HPP_NAMESPACE::ImageLayout::eShaderReadOnlyOptimal,
+            const std::optional<uint32_t>& dstQueueFamilyIndex = {}
+        );
+
+        Ticket submit(VULKAN_HPP_NAMESPACE::raii::Queue& queue);
+
+        uint64_t completedValue();
+
+        bool isComplete(const Ticket& ticket);
+
+        void wait(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            const Ticket& ticket,
+            uint64_t timeout = UINT64_MAX
+        );
+
+        void collect();
+
+        void clear();
+
+        void clearAndRelease();
+
+        Chunk& stage(
+            VULKAN_HPP_NAMESPACE::raii::Device& device,
+            const void* data,
+            const VULKAN_HPP_NAMESPACE::DeviceSize& size,
+            VULKAN_HPP_NAMESPACE::DeviceSize& offset
+        );
+
+        VULKAN_HPP_NAMESPACE::raii::CommandBuffer& recording(
+            VULKAN_HPP_NAMESPACE::raii::Device& device
+        );
+
+    };
+
+    class EXQUDENS_VULKAN_EXPORT UploadManager::Builder {
+
+        private:
+
+            UploadManager& object;
+
+        public:
+
+            explicit Builder(UploadManager& object);
+
+            Builder& setQueueFamilyIndex(uint32_t value);
+
+            Builder& setChunkSize(const VULKAN_HPP_NAMESPACE::DeviceSize& value);
+
+            Builder& setAlignment(const VULKAN_HPP_NAMESPACE::DeviceSize& value);
+
+            UploadManager& build(
+                VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice,
+                VULKAN_HPP_NAMESPACE::raii::Device& device
+            );
+
+    };
+
+}
+
+// implementation ---
+
+#include <cstring>
+#include <algorithm>
+#include <utility>
+#include <string>
+#include <filesystem>
+#include <stdexcept>
+
+#define CALL_INFO std::string(__FUNCTION__) + " (" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::vulkan {
+
+    EXQUDENS_VULKAN_INLINE UploadManager::Builder UploadManager::builder(UploadManager& object) {
+        return Builder(object);
+    }
+
+    EXQUDENS_VULKAN_INLINE void UploadManager::acquire(
+        VULKAN_HPP_NAMESPACE::raii::CommandBuffer& commandBuffer,
+        const Ticket& ticket,
+        const VULKAN_HPP_NAMESPACE::PipelineStageFlags& dstStageMask
+    ) {
+        try {
+            if (ticket.bufferBarriers.empty() && ticket.imageBarriers.empty()) {
+                return;
+            }
+
+            // the source scope matches the semaphore wait stage, so the acquire runs after the release
+            commandBuffer.pipelineBarrier(
+                dstStageMask,
+                dstStageMask,
+                {},
+                nullptr,
+                ticket.bufferBarriers,
+                ticket.imageBarriers
+            );
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE UploadManager::Ticket UploadManager::uploadBuffer(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        const void* data,
+        const VULKAN_HPP_NAMESPACE::DeviceSize& size,
+        const VULKAN_HPP_NAMESPACE::Buffer& dstBuffer,
+        const VULKAN_HPP_NAMESPACE::DeviceSize& dstOffset,
+        const std::optional<uint32_t>& dstQueueFamilyIndex
+    ) {
+        try {
+            VULKAN_HPP_NAMESPACE::DeviceSize offset = 0;
+            Chunk& chunk = stage(device, data, size, offset);
+
+            recording(device).copyBuffer(
+                *chunk.buffer.target,
+                dstBuffer,
+                VULKAN_HPP_NAMESPACE::BufferCopy()
+                .setSrcOffset(offset)
+                .setDstOffset(dstOffset)
+                .setSize(size)
+            );
+
+            Ticket result;
+            result.semaphore = *semaphore.target;
+            result.value = value + 1;
+
+            // exclusive buffers read on another family need a release here and an acquire there
+            if (dstQueueFamilyIndex.has_value() && dstQueueFamilyIndex.value() != queueFamilyIndex.value()) {
+                VULKAN_HPP_NAMESPACE::BufferMemoryBarrier barrier = VULKAN_HPP_NAMESPACE::BufferMemoryBarrier()
+                .setSrcAccessMask(VULKAN_HPP_NAMESPACE::AccessFlagBits::eTransferWrite)
+                .setDstAccessMask({})
+                .setSrcQueueFamilyIndex(queueFamilyIndex.value())
+                .setDstQueueFamilyIndex(dstQueueFamilyIndex.value())
+                .setBuffer(dstBuffer)
+                .setOffset(dstOffset)
+                .setSize(size);
+
+                recording(device).pipelineBarrier(
+                    VULKAN_HPP_NAMESPACE::PipelineStageFlagBits::eTransfer,
+                    VULKAN_HPP_NAMESPACE::PipelineStageFlagBits::eBottomOfPipe,
+                    {},
+                    nullptr,
+                    barrier,
+                    nullptr
+                );
+
+                barrier.setSrcAccessMask({}).setDstAccessMask(VULKAN_HPP_NAMESPACE::AccessFlagBits::eMemoryRead);
+                result.bufferBarriers.emplace_back(barrier);
+                bufferBarriers.emplace_back(barrier);
+            }
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE UploadManager::Ticket UploadManager::uploadImage(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        const void* data,
+        const VULKAN_HPP_NAMESPACE::DeviceSize& size,
+        Image& dstImage,
+        const VULKAN_HPP_NAMESPACE::ImageLayout& finalLayout,
+        const std::optional<uint32_t>& dstQueueFamilyIndex
+    ) {
+        try {
+            // mip generation blits, and blits need a graphics queue
+            if (dstImage.createInfo.value().mipLevels > 1) {
+                throw std::runtime_error(CALL_INFO + ": 'dstImage' has more than one mip level, use 'Image::upload' on a graphics queue");
+            }
+
+            VULKAN_HPP_NAMESPACE::DeviceSize offset = 0;
+            Chunk& chunk = stage(device, data, size, offset);
+
+            bool transfer = dstQueueFamilyIndex.has_value() && dstQueueFamilyIndex.value() != queueFamilyIndex.value();
+
+            // a transfer queue cannot name graphics stages, the consumer waits on the ticket and acquires instead
+            dstImage.upload(
+                recording(device),
+                *chunk.buffer.target,
+                offset,
+                finalLayout,
+                VULKAN_HPP_NAMESPACE::PipelineStageFlagBits::eBottomOfPipe,
+                {},
+                transfer ? queueFamilyIndex.value() : VK_QUEUE_FAMILY_IGNORED,
+                transfer ? dstQueueFamilyIndex.value() : VK_QUEUE_FAMILY_IGNORED
+            );
+
+            Ticket result;
+            result.semaphore = *semaphore.target;
+            result.value = value + 1;
+
+            if (transfer) {
+                // the acquire repeats the release layout transition exactly
+                VULKAN_HPP_NAMESPACE::ImageMemoryBarrier barrier = VULKAN_HPP_NAMESPACE::ImageMemoryBarrier()
+                .setSrcAccessMask({})
+                .setDstAccessMask(VULKAN_HPP_NAMESPACE::AccessFlagBits::eMemoryRead)
+                .setOldLayout(VULKAN_HPP_NAMESPACE::ImageLayout::eTransferDstOptimal)
+                .setNewLayout(finalLayout)
+                .setSrcQueueFamilyIndex(queueFamilyIndex.value())
+                .setDstQueueFamilyIndex(dstQueueFamilyIndex.value())
+                .setImage(*dstImage.target)
+                .setSubresourceRange(dstImage.subresourceRange());
+                result.imageBarriers.emplace_back(barrier);
+                imageBarriers.emplace_back(barrier);
+            }
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE UploadManager::Ticket UploadManager::submit(VULKAN_HPP_NAMESPACE::raii::Queue& queue) {
+        try {
+            Ticket result;
+            result.semaphore = *semaphore.target;
+
+            if (!recordingIndex.has_value()) {
+                result.value = value;
+                return result;
+            }
+
+            // the batch ticket carries every acquire of the batch
+            result.bufferBarriers = std::move(bufferBarriers);
+            result.imageBarriers = std::move(imageBarriers);
+            bufferBarriers.clear();
+            imageBarriers.clear();
+
+            Submission& submission = submissions.at(recordingIndex.value());
+            submission.commandBuffer.end();
+            submission.value = value + 1;
+
+            VULKAN_HPP_NAMESPACE::TimelineSemaphoreSubmitInfo timelineSemaphoreSubmitInfo = VULKAN_HPP_NAMESPACE::TimelineSemaphoreSubmitInfo()
+            .setSignalSemaphoreValueCount(1)
+            .setPSignalSemaphoreValues(&submission.value);
+
+            VULKAN_HPP_NAMESPACE::SubmitInfo submitInfo = VULKAN_HPP_NAMESPACE::SubmitInfo()
+            .setPNext(&timelineSemaphoreSubmitInfo)
+            .setCommandBufferCount(1)
+            .setPCommandBuffers(&(*submission.commandBuffer))
+            .setSignalSemaphoreCount(1)
+            .setPSignalSemaphores(&(*semaphore.target));
+
+            queue.submit(submitInfo);
+
+            value = submission.value;
+            recordingIndex.reset();
+
+            result.value = value;
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE uint64_t UploadManager::completedValue() {
+        try {
+            return semaphore.target.getCounterValue();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE bool UploadManager::isComplete(const Ticket& ticket) {
+        try {
+            return ticket.value <= completedValue();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void UploadManager::wait(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        const Ticket& ticket,
+        uint64_t timeout
+    ) {
+        try {
+            if (ticket.value > value) {
+                throw std::runtime_error(CALL_INFO + ": ticket " + std::to_string(ticket.value) + " is not submitted yet");
+            }
+
+            VULKAN_HPP_NAMESPACE::Result result = device.waitSemaphores(
+                VULKAN_HPP_NAMESPACE::SemaphoreWaitInfo()
+                .setSemaphoreCount(1)
+                .setPSemaphores(&ticket.semaphore)
+                .setPValues(&ticket.value),
+                timeout
+            );
+
+            if (result != VULKAN_HPP_NAMESPACE::Result::eSuccess) {
+                throw std::runtime_error(CALL_INFO + ": failed to wait for upload ticket!");
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void UploadManager::collect() {
+        try {
+            uint64_t completed = completedValue();
+
+            for (Chunk& chunk : chunks) {
+                if (chunk.value != 0 && chunk.value <= completed) {
+                    chunk.head = 0;
+                    chunk.value = 0;
+                }
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void UploadManager::clear() {
+        try {
+            queueFamilyIndex.reset();
+            chunkSize.reset();
+            alignment.reset();
+            memoryProperties.reset();
+            semaphoreTypeCreateInfo.reset();
+            recordingIndex.reset();
+            bufferBarriers.clear();
+            imageBarriers.clear();
+            submissions.clear();
+            for (Chunk& chunk : chunks) {
+                chunk.buffer.clear();
+                chunk.memory.clear();
+            }
+            chunks.clear();
+            value = 0;
+            semaphore.clear();
+            commandPool.clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE void UploadManager::clearAndRelease() {
+        try {
+            submissions.clear();
+            for (Chunk& chunk : chunks) {
+                chunk.buffer.clearAndRelease();
+                chunk.memory.clearAndRelease();
+            }
+            semaphore.clearAndRelease();
+            commandPool.clearAndRelease();
+            clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE UploadManager::Chunk& UploadManager::stage(
+        VULKAN_HPP_NAMESPACE::raii::Device& device,
+        const void* data,
+        const VULKAN_HPP_NAMESPACE::DeviceSize& size,
+        VULKAN_HPP_NAMESPACE::DeviceSize& offset
+    ) {
+        try {
+            uint64_t pending = value + 1;
+            std::optional<size_t> index = {};
+
+            // prefer the chunks already owned by the batch being recorded, then any retired chunk
+            for (size_t i = 0; i < chunks.size() && !index.has_value(); i++) {
+                Chunk& chunk = chunks.at(i);
+                VULKAN_HPP_NAMESPACE::DeviceSize begin = ((chunk.head + alignment.value() - 1) / alignment.value()) * alignment.value();
+                if (chunk.value == pending && begin + size <= chunk.buffer.createInfo.value().size) {
+                    index = i;
+                }
+            }
+
+            if (!index.has_value()) {
+                collect();
+            }
+
+            for (size_t i = 0; i < chunks.size() && !index.has_value(); i++) {
+                Chunk& chunk = chunks.at(i);
+                if (chunk.value == 0 && size <= chunk.buffer.createInfo.value().size) {
+                    index = i;
+                }
+            }
+
+            if (!index.has_value()) {
+                Chunk chunk;
+
+                Buffer::builder(chunk.buffer)
+                .setCreateInfo(
+                    VULKAN_HPP_NAMESPACE::BufferCreateInfo()
+                    .setSize(std::max(chunkSize.value(), size))
+                    .setUsage(VULKAN_HPP_NAMESPACE::BufferUsageFlagBits::eTransferSrc)
+                    .setSharingMode(VULKAN_HPP_NAMESPACE::SharingMode::eExclusive)
+                )
+                .build(device);
+
+                VULKAN_HPP_NAMESPACE::MemoryRequirements memoryRequirements = chunk.buffer.target.getMemoryRequirements();
+                std::optional<uint32_t> memoryTypeIndex = DeviceMemory::memoryTypeIndexFrom(
+                    memoryProperties.value(),
+                    memoryRequirements.memoryTypeBits,
+                    VULKAN_HPP_NAMESPACE::MemoryPropertyFlagBits::eHostVisible | VULKAN_HPP_NAMESPACE::MemoryPropertyFlagBits::eHostCoherent,
+                    {},
+                    VULKAN_HPP_NAMESPACE::MemoryPropertyFlagBits::eHostCached | VULKAN_HPP_NAMESPACE::MemoryPropertyFlagBits::eDeviceLocal
+                );
+
+                if (!memoryTypeIndex.has_value()) {
+                    throw std::runtime_error(CALL_INFO + ": failed to find suitable memory type!");
+                }
+
+                DeviceMemory::builder(chunk.memory)
+                .setAllocateInfo(
+                    VULKAN_HPP_NAMESPACE::MemoryAllocateInfo()
+                    .setAllocationSize(memoryRequirements.size)
+                    .setMemoryTypeIndex(memoryTypeIndex.value())
+                )
+                .setPropertyFlags(memoryProperties.value().memoryTypes.at(memoryTypeIndex.value()).propertyFlags)
+                .setPersistentMap(true)
+                .build(device);
+
+                chunk.buffer.target.bindMemory(*chunk.memory.target, 0);
+
+                index = chunks.size();
+                chunks.emplace_back(std::move(chunk));
+            }
+
+            Chunk& chunk = chunks.at(index.value());
+            offset = ((chunk.head + alignment.value() - 1) / alignment.value()) * alignment.value();
+            std::memcpy(static_cast<char*>(chunk.memory.mappedData) + offset, data, size);
+            chunk.head = offset + size;
+            chunk.value = pending;
+
+            return chunk;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE VULKAN_HPP_NAMESPACE::raii::CommandBuffer& UploadManager::recording(
+        VULKAN_HPP_NAMESPACE::raii::Device& device
+    ) {
+        try {
+            if (recordingIndex.has_value()) {
+                return submissions.at(recordingIndex.value()).commandBuffer;
+            }
+
+            uint64_t completed = completedValue();
+
+            for (size_t i = 0; i < submissions.size() && !recordingIndex.has_value(); i++) {
+                if (submissions.at(i).value <= completed) {
+                    recordingIndex = i;
+                }
+            }
+
+            if (!recordingIndex.has_value()) {
+                VULKAN_HPP_NAMESPACE::raii::CommandBuffers commandBuffers(
+                    device,
+                    VULKAN_HPP_NAMESPACE::CommandBufferAllocateInfo()
+                    .setCommandPool(*commandPool.target)
+                    .setLevel(VULKAN_HPP_NAMESPACE::CommandBufferLevel::ePrimary)
+                    .setCommandBufferCount(1)
+                );
+
+                Submission submission;
+                submission.commandBuffer = std::move(commandBuffers.front());
+
+                recordingIndex = submissions.size();
+                submissions.emplace_back(std::move(submission));
+            }
+
+            Submission& submission = submissions.at(recordingIndex.value());
+            submission.value = value + 1;
+            submission.commandBuffer.reset();
+            submission.commandBuffer.begin(
+                VULKAN_HPP_NAMESPACE::CommandBufferBeginInfo()
+                .setFlags(VULKAN_HPP_NAMESPACE::CommandBufferUsageFlagBits::eOneTimeSubmit)
+            );
+
+            return submission.commandBuffer;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    EXQUDENS_VULKAN_INLINE UploadManager::Builder::Builder(UploadManager& object): object(object) {
+    }
+
+    EXQUDENS_VULKAN_INLINE UploadManager::Builder& UploadManager::Builder::setQueueFamilyIndex(uint32_t value) {
+        object.queueFamilyIndex = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE UploadManager::Builder& UploadManager::Builder::setChunkSize(const VULKAN_HPP_NAMESPACE::DeviceSize& value) {
+        object.chunkSize = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE UploadManager::Builder& UploadManager::Builder::setAlignment(const VULKAN_HPP_NAMESPACE::DeviceSize& value) {
+        object.alignment = value;
+        return *this;
+    }
+
+    EXQUDENS_VULKAN_INLINE UploadManager& UploadManager::Builder::build(
+        VULKAN_HPP_NAMESPACE::raii::PhysicalDevice& physicalDevice,
+        VULKAN_HPP_NAMESPACE::raii::Device& device
+    ) {
+        try {
+            if (!object.queueFamilyIndex.has_value()) {
+                throw std::runtime_error(CALL_INFO + ": queue family index not set");
+            }
+
+            if (!object.chunkSize.has_value()) {
+                object.chunkSize = 16777216; // 16 mb
+            }
+
+            if (!object.alignment.has_value()) {
+                // covers the texel block size of every uncompressed and block-compressed format
+                object.alignment = std::max<VULKAN_HPP_NAMESPACE::DeviceSize>(16, physicalDevice.getProperties().limits.optimalBufferCopyOffsetAlignment);
+            }
+
+            if (!object.memoryProperties.has_value()) {
+                object.memoryProperties = DeviceMemory::memoryPropertiesFrom(physicalDevice);
+            }
+
+            CommandPool::builder(object.commandPool)
+            .setCreateInfo(
+                VULKAN_HPP_NAMESPACE::CommandPoolCreateInfo()
+                .setFlags(VULKAN_HPP_NAMESPACE::CommandPoolCreateFlagBits::eResetCommandBuffer | VULKAN_HPP_NAMESPACE::CommandPoolCreateFlagBits::eTransient)
+                .setQueueFamilyIndex(object.queueFamilyIndex.value())
+            )
+            .build(device);
+
+            object.semaphoreTypeCreateInfo = VULKAN_HPP_NAMESPACE::SemaphoreTypeCreateInfo()
+            .setSemaphoreType(VULKAN_HPP_NAMESPACE::SemaphoreType::eTimeline)
+            .setInitialValue(0);
+
+            Semaphore::builder(object.semaphore)
+            .setCreateInfo(
+                VULKAN_HPP_NAMESPACE::SemaphoreCreateInfo()
+                .setPNext(&object.semaphoreTypeCreateInfo.value())
+            )
+            .build(device);
+
+            object.value = 0;
+
+            return object;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
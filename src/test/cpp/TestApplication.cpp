@@ -18,6 +18,19 @@
 #include "unit/OtherUnitTests.hpp"
 //#include "unit/GlmUnitTests.hpp"
 #include "unit/StringVectorUnitTests.hpp"
+#include "unit/DeviceMemoryUnitTests.hpp"
+#include "unit/PipelineStateKeyUnitTests.hpp"
+#include "unit/SpirvReflectionUnitTests.hpp"
+#include "unit/PipelineRecorderUnitTests.hpp"
+#include "unit/DescriptorUpdateTemplateUnitTests.hpp"
+#include "unit/LayoutCacheUnitTests.hpp"
+#include "unit/DescriptorHeapUnitTests.hpp"
+#include "unit/DescriptorBufferUnitTests.hpp"
+#include "unit/ShaderObjectUnitTests.hpp"
+#include "unit/PipelineLibraryUnitTests.hpp"
+#include "unit/DescriptorSetCacheUnitTests.hpp"
+#include "unit/MemoryArenaUnitTests.hpp"
+#include "unit/DescriptorAllocatorUnitTests.hpp"
 #include "gui/vulkan-tutorial-com/VulkanTutorialCom1GuiTests.hpp"
 #include "gui/vulkan-tutorial-com/VulkanTutorialCom2GuiTests.hpp"
 #include "gui/vulkan-tutorial-com/VulkanTutorialCom3GuiTests.hpp"
@@ -42,6 +55,19 @@ int TestApplication::run(int argc, char** argv) {
             OtherUnitTests::LOGGER_ID,
             //GlmUnitTests::LOGGER_ID,
             StringVectorUnitTests::LOGGER_ID,
+            DeviceMemoryUnitTests::LOGGER_ID,
+            PipelineStateKeyUnitTests::LOGGER_ID,
+            SpirvReflectionUnitTests::LOGGER_ID,
+            PipelineRecorderUnitTests::LOGGER_ID,
+            DescriptorUpdateTemplateUnitTests::LOGGER_ID,
+            LayoutCacheUnitTests::LOGGER_ID,
+            DescriptorHeapUnitTests::LOGGER_ID,
+            DescriptorBufferUnitTests::LOGGER_ID,
+            ShaderObjectUnitTests::LOGGER_ID,
+            PipelineLibraryUnitTests::LOGGER_ID,
+            DescriptorSetCacheUnitTests::LOGGER_ID,
+            MemoryArenaUnitTests::LOGGER_ID,
+            DescriptorAllocatorUnitTests::LOGGER_ID,
             VulkanTutorialCom1GuiTests::LOGGER_ID,
             VulkanTutorialCom2GuiTests::LOGGER_ID,
             VulkanTutorialCom3GuiTests::LOGGER_ID,
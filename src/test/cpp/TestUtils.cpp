@@ -393,6 +393,53 @@ std::string TestUtils::toString(const std::vector<std::any>& value) {
     }
 }
 
+void TestUtils::fillPipeline(exqudens::vulkan::Pipeline& pipeline) {
+    try {
+        // starts from an empty description, so a refill never keeps state from an earlier case
+        pipeline.clear();
+        pipeline.shaderStageCreateInfos = {
+            vk::PipelineShaderStageCreateInfo()
+            .setStage(vk::ShaderStageFlagBits::eVertex)
+            .setModule(vk::ShaderModule(reinterpret_cast<VkShaderModule>(uintptr_t(1))))
+            .setPName("main"),
+            vk::PipelineShaderStageCreateInfo()
+            .setStage(vk::ShaderStageFlagBits::eFragment)
+            .setModule(vk::ShaderModule(reinterpret_cast<VkShaderModule>(uintptr_t(2))))
+            .setPName("main")
+        };
+        pipeline.vertexInputStateCreateInfoBindings = {
+            vk::VertexInputBindingDescription(0, 32, vk::VertexInputRate::eVertex)
+        };
+        pipeline.vertexInputStateCreateInfoAttributes = {
+            vk::VertexInputAttributeDescription(0, 0, vk::Format::eR32G32B32Sfloat, 0),
+            vk::VertexInputAttributeDescription(1, 0, vk::Format::eR32G32Sfloat, 12)
+        };
+        pipeline.vertexInputStateCreateInfo = vk::PipelineVertexInputStateCreateInfo();
+        pipeline.inputAssemblyStateCreateInfo = vk::PipelineInputAssemblyStateCreateInfo()
+        .setTopology(vk::PrimitiveTopology::eTriangleList);
+        pipeline.viewportStateCreateInfo = vk::PipelineViewportStateCreateInfo()
+        .setViewportCount(1)
+        .setScissorCount(1);
+        pipeline.rasterizationStateCreateInfo = vk::PipelineRasterizationStateCreateInfo()
+        .setPolygonMode(vk::PolygonMode::eFill)
+        .setCullMode(vk::CullModeFlagBits::eBack)
+        .setFrontFace(vk::FrontFace::eCounterClockwise)
+        .setLineWidth(1.0f);
+        pipeline.multisampleStateCreateInfo = vk::PipelineMultisampleStateCreateInfo()
+        .setRasterizationSamples(vk::SampleCountFlagBits::e1);
+        pipeline.colorBlendAttachmentStates = {
+            vk::PipelineColorBlendAttachmentState()
+            .setColorWriteMask(vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG | vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA)
+        };
+        pipeline.colorBlendStateCreateInfo = vk::PipelineColorBlendStateCreateInfo();
+        pipeline.dynamicStates = {vk::DynamicState::eViewport, vk::DynamicState::eScissor};
+        pipeline.graphicsCreateInfo = vk::GraphicsPipelineCreateInfo()
+        .setLayout(vk::PipelineLayout(reinterpret_cast<VkPipelineLayout>(uintptr_t(3))));
+    } catch (...) {
+        std::throw_with_nested(std::runtime_error(CALL_INFO));
+    }
+}
+
 /*glm::mat4 TestUtils::lookAt(glm::vec3 eye_pos, glm::vec3 scene_center, glm::vec3 up_vec) {
     try {
         // Create transform matrix in reverse order.
@@ -10,6 +10,7 @@
 //#include <glm/glm.hpp>
 
 #include "test_lib_export.hpp"
+#include "exqudens/vulkan/Pipeline.hpp"
 
 class TEST_LIB_EXPORT TestUtils {
 
@@ -75,6 +76,9 @@ class TEST_LIB_EXPORT TestUtils {
 
         static std::string toString(const std::vector<std::any>& value);
 
+        // graphics description with fake handles (modules 1 and 2, layout 3), only for tests that never dereference them
+        static void fillPipeline(exqudens::vulkan::Pipeline& pipeline);
+
         //static glm::mat4 lookAt(glm::vec3 eye_pos, glm::vec3 scene_center, glm::vec3 up_vec);
 
 };
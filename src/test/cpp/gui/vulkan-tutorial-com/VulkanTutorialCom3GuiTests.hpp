@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <cstring>
+#include <algorithm>
 #include <string>
 #include <optional>
 #include <array>
@@ -24,6 +25,7 @@
 #include <vulkan/vulkan_raii.hpp>
 
 #include "TestUtils.hpp"
+#include "VulkanTutorialCom3Spirv.hpp"
 #include "exqudens/vulkan.hpp"
 #include "exqudens/vulkan/ShaderModule.hpp"
 
@@ -130,6 +132,7 @@ class VulkanTutorialCom3GuiTests: public testing::Test {
                 GLFWwindow* window = nullptr;
 
                 vk::PhysicalDeviceFeatures deviceFeatures;
+                vk::PhysicalDeviceVulkan12Features deviceVulkan12Features;
 
                 vk::raii::Context context;
                 exqudens::vulkan::Instance instance = {};
@@ -145,24 +148,19 @@ class VulkanTutorialCom3GuiTests: public testing::Test {
                 exqudens::vulkan::PipelineCache pipelineCache = {};
                 exqudens::vulkan::ShaderModule vertShaderModule = {};
                 exqudens::vulkan::ShaderModule fragShaderModule = {};
-                exqudens::vulkan::Buffer vertexStagingBuffer = {};
-                exqudens::vulkan::DeviceMemory vertexStagingBufferMemory = {};
                 exqudens::vulkan::Buffer vertexBuffer = {};
                 exqudens::vulkan::DeviceMemory vertexBufferMemory = {};
-                exqudens::vulkan::Buffer indexStagingBuffer = {};
-                exqudens::vulkan::DeviceMemory indexStagingBufferMemory = {};
                 exqudens::vulkan::Buffer indexBuffer = {};
                 exqudens::vulkan::DeviceMemory indexBufferMemory = {};
-                exqudens::vulkan::CommandPool transferCommandPool = {};
-                exqudens::vulkan::CommandBuffers transferCommandBuffers = {};
+                exqudens::vulkan::UploadManager uploadManager = {};
+                exqudens::vulkan::UploadManager::Ticket uploadTicket = {};
                 exqudens::vulkan::CommandPool graphicsCommandPool = {};
 
+                exqudens::vulkan::DeferredRelease deferredRelease = {};
                 exqudens::vulkan::Swapchain swapchain = {};
                 exqudens::vulkan::DescriptorPool descriptorPool = {};
                 exqudens::vulkan::DescriptorSets descriptorSets = {};
-                std::vector<exqudens::vulkan::Buffer> uniformBuffers = {};
-                std::vector<exqudens::vulkan::DeviceMemory> uniformBufferMemories = {};
-                std::vector<void*> uniformBufferMappedMemories = {};
+                exqudens::vulkan::RingBuffer uniformRingBuffer = {};
                 std::vector<exqudens::vulkan::ImageView> imageViews = {};
                 exqudens::vulkan::RenderPass renderPass = {};
                 exqudens::vulkan::Pipeline pipeline = {};
@@ -174,6 +172,7 @@ class VulkanTutorialCom3GuiTests: public testing::Test {
 
                 bool framebufferResized = false;
                 uint32_t currentFrame = 0;
+                exqudens::vulkan::RingBuffer::Allocation uniformAllocation = {};
 
             public:
 
@@ -225,6 +224,8 @@ class VulkanTutorialCom3GuiTests: public testing::Test {
                         }
 
                         device.target.waitIdle();
+                        deferredRelease.flush();
+                        pipelineCache.save();
                     } catch (...) {
                         std::throw_with_nested(std::runtime_error(CALL_INFO));
                     }
@@ -259,6 +260,7 @@ class VulkanTutorialCom3GuiTests: public testing::Test {
                         }
 
                         //deviceFeatures = vk::PhysicalDeviceFeatures().setSamplerAnisotropy(true).setSampleRateShading(true);
+                        deviceVulkan12Features = vk::PhysicalDeviceVulkan12Features().setTimelineSemaphore(true);
 
                         int framebufferWidth = 0;
                         int framebufferHeight = 0;
@@ -383,6 +385,7 @@ class VulkanTutorialCom3GuiTests: public testing::Test {
                             .setEnabledExtensionCount(static_cast<uint32_t>(physicalDevice.requiredExtensions.size()))
                             .setPpEnabledExtensionNames(physicalDevice.requiredExtensions.data())
                             .setPEnabledFeatures(&deviceFeatures)
+                            .setPNext(&deviceVulkan12Features)
                         )
                         .build(physicalDevice.target);
 
@@ -402,7 +405,7 @@ class VulkanTutorialCom3GuiTests: public testing::Test {
                         .addBinding(
                             vk::DescriptorSetLayoutBinding()
                             .setBinding(0)
-                            .setDescriptorType(vk::DescriptorType::eUniformBuffer)
+                            .setDescriptorType(vk::DescriptorType::eUniformBufferDynamic)
                             .setDescriptorCount(1)
                             .setStageFlags(vk::ShaderStageFlagBits::eVertex)
                             .setPImmutableSamplers(nullptr)
@@ -419,49 +422,22 @@ class VulkanTutorialCom3GuiTests: public testing::Test {
                         .build(device.target);
 
                         exqudens::vulkan::PipelineCache::builder(pipelineCache)
-                        .build(device.target);
-
-                        exqudens::vulkan::ShaderModule::builder(vertShaderModule)
-                        .setFile(
-                            std::filesystem::path(testOutputDir.value())
-                            .append("vert.spv")
-                            .generic_string()
-                            .c_str()
-                        )
-                        .setReadFile(true)
-                        .build(device.target);
-
-                        exqudens::vulkan::ShaderModule::builder(fragShaderModule)
                         .setFile(
                             std::filesystem::path(testOutputDir.value())
-                            .append("frag.spv")
+                            .append("pipeline-cache.bin")
                             .generic_string()
-                            .c_str()
                         )
                         .setReadFile(true)
-                        .build(device.target);
+                        .build(physicalDevice.target, device.target);
 
-                        exqudens::vulkan::Buffer::builder(vertexStagingBuffer)
-                        .setCreateInfo(
-                            vk::BufferCreateInfo()
-                            .setSize(sizeof(vertices.at(0)) * vertices.size())
-                            .setUsage(vk::BufferUsageFlagBits::eTransferSrc)
-                            .setSharingMode(vk::SharingMode::eExclusive)
-                        )
+                        exqudens::vulkan::ShaderModule::builder(vertShaderModule)
+                        .setSpirv(exqudens::vulkan::Spirv::find(spirv::vulkan_tutorial_com3::REGISTRY, "vert"))
                         .build(device.target);
 
-                        exqudens::vulkan::DeviceMemory::builder(vertexStagingBufferMemory)
-                        .setAllocateInfo(
-                            exqudens::vulkan::DeviceMemory::allocateInfoFrom(
-                                physicalDevice.target,
-                                vertexStagingBuffer.target,
-                                vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
-                            )
-                        )
+                        exqudens::vulkan::ShaderModule::builder(fragShaderModule)
+                        .setSpirv(exqudens::vulkan::Spirv::find(spirv::vulkan_tutorial_com3::REGISTRY, "frag"))
                         .build(device.target);
 
-                        vertexStagingBuffer.target.bindMemory(*vertexStagingBufferMemory.target, 0);
-
                         exqudens::vulkan::Buffer::builder(vertexBuffer)
                         .setCreateInfo(
                             vk::BufferCreateInfo()
@@ -483,27 +459,6 @@ class VulkanTutorialCom3GuiTests: public testing::Test {
 
                         vertexBuffer.target.bindMemory(*vertexBufferMemory.target, 0);
 
-                        exqudens::vulkan::Buffer::builder(indexStagingBuffer)
-                        .setCreateInfo(
-                            vk::BufferCreateInfo()
-                            .setSize(sizeof(indices.at(0)) * indices.size())
-                            .setUsage(vk::BufferUsageFlagBits::eTransferSrc)
-                            .setSharingMode(vk::SharingMode::eExclusive)
-                        )
-                        .build(device.target);
-
-                        exqudens::vulkan::DeviceMemory::builder(indexStagingBufferMemory)
-                        .setAllocateInfo(
-                            exqudens::vulkan::DeviceMemory::allocateInfoFrom(
-                                physicalDevice.target,
-                                indexStagingBuffer.target,
-                                vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
-                            )
-                        )
-                        .build(device.target);
-
-                        indexStagingBuffer.target.bindMemory(*indexStagingBufferMemory.target, 0);
-
                         exqudens::vulkan::Buffer::builder(indexBuffer)
                         .setCreateInfo(
                             vk::BufferCreateInfo()
@@ -525,23 +480,6 @@ class VulkanTutorialCom3GuiTests: public testing::Test {
 
                         indexBuffer.target.bindMemory(*indexBufferMemory.target, 0);
 
-                        exqudens::vulkan::CommandPool::builder(transferCommandPool)
-                        .setCreateInfo(
-                            vk::CommandPoolCreateInfo()
-                            .setFlags(vk::CommandPoolCreateFlagBits::eResetCommandBuffer)
-                            .setQueueFamilyIndex(transferQueue.familyIndex.value())
-                        )
-                        .build(device.target);
-
-                        exqudens::vulkan::CommandBuffers::builder(transferCommandBuffers)
-                        .setAllocateInfo(
-                            vk::CommandBufferAllocateInfo()
-                            .setCommandPool(*transferCommandPool.target)
-                            .setLevel(vk::CommandBufferLevel::ePrimary)
-                            .setCommandBufferCount(1)
-                        )
-                        .build(device.target);
-
                         exqudens::vulkan::CommandPool::builder(graphicsCommandPool)
                         .setCreateInfo(
                             vk::CommandPoolCreateInfo()
@@ -550,33 +488,14 @@ class VulkanTutorialCom3GuiTests: public testing::Test {
                         )
                         .build(device.target);
 
-                        vertexStagingBufferMemory.fill(vertices.data());
-                        indexStagingBufferMemory.fill(indices.data());
-
-                        transferCommandBuffers.targets.at(0).begin({});
-                        transferCommandBuffers.targets.at(0).copyBuffer(
-                            *vertexStagingBuffer.target,
-                            *vertexBuffer.target,
-                            {vk::BufferCopy().setSize(vertexBuffer.createInfo.value().size)}
-                        );
-                        transferCommandBuffers.targets.at(0).copyBuffer(
-                            *indexStagingBuffer.target,
-                            *indexBuffer.target,
-                            {vk::BufferCopy().setSize(indexBuffer.createInfo.value().size)}
-                        );
-                        transferCommandBuffers.targets.at(0).end();
-                        transferQueue.target.submit(
-                            vk::SubmitInfo()
-                            .setCommandBufferCount(1)
-                            .setPCommandBuffers(&(*transferCommandBuffers.targets.at(0)))
-                        );
-                        transferQueue.target.waitIdle();
-
-                        vertexStagingBuffer.clearAndRelease();
-                        vertexStagingBufferMemory.clearAndRelease();
+                        exqudens::vulkan::UploadManager::builder(uploadManager)
+                        .setQueueFamilyIndex(transferQueue.familyIndex.value())
+                        .build(physicalDevice.target, device.target);
 
-                        indexStagingBuffer.clearAndRelease();
-                        indexStagingBufferMemory.clearAndRelease();
+                        // both buffers are exclusive, ownership moves from the transfer to the graphics family
+                        uploadManager.uploadBuffer(device.target, vertices.data(), vertexBuffer.createInfo.value().size, *vertexBuffer.target, 0, graphicsQueue.familyIndex.value());
+                        uploadManager.uploadBuffer(device.target, indices.data(), indexBuffer.createInfo.value().size, *indexBuffer.target, 0, graphicsQueue.familyIndex.value());
+                        uploadTicket = uploadManager.submit(transferQueue.target);
 
                         initVulkanSwapchain(framebufferWidth, framebufferHeight);
 
@@ -608,12 +527,16 @@ class VulkanTutorialCom3GuiTests: public testing::Test {
                             graphicsQueue.familyIndex.value(),
                             presentQueue.familyIndex.value()
                         })
-                        .build(device.target);
+                        .build(device.target, deferredRelease);
+
+                        exqudens::vulkan::DeferredRelease::builder(deferredRelease)
+                        .setFrameCount(static_cast<uint32_t>(swapchain.target.getImages().size()))
+                        .build();
 
                         exqudens::vulkan::DescriptorPool::builder(descriptorPool)
                         .addSize(
                             vk::DescriptorPoolSize()
-                            .setType(vk::DescriptorType::eUniformBuffer)
+                            .setType(vk::DescriptorType::eUniformBufferDynamic)
                             .setDescriptorCount(static_cast<uint32_t>(swapchain.target.getImages().size()))
                         )
                         .setCreateInfo(
@@ -631,34 +554,14 @@ class VulkanTutorialCom3GuiTests: public testing::Test {
                         )
                         .build(device.target);
 
-                        uniformBuffers.resize(swapchain.target.getImages().size());
-                        uniformBufferMemories.resize(swapchain.target.getImages().size());
-                        uniformBufferMappedMemories.resize(swapchain.target.getImages().size());
+                        exqudens::vulkan::RingBuffer::builder(uniformRingBuffer)
+                        .setFrameCount(static_cast<uint32_t>(swapchain.target.getImages().size()))
+                        .setFrameSize(sizeof(UniformBufferObject))
+                        .setUsage(vk::BufferUsageFlagBits::eUniformBuffer)
+                        .build(physicalDevice.target, device.target);
+
                         imageViews.resize(swapchain.target.getImages().size());
                         for (size_t i = 0; i < swapchain.target.getImages().size(); i++) {
-                            exqudens::vulkan::Buffer::builder(uniformBuffers.at(i))
-                            .setCreateInfo(
-                                vk::BufferCreateInfo()
-                                .setSize(sizeof(UniformBufferObject))
-                                .setUsage(vk::BufferUsageFlagBits::eUniformBuffer)
-                                .setSharingMode(vk::SharingMode::eExclusive)
-                            )
-                            .build(device.target);
-
-                            exqudens::vulkan::DeviceMemory::builder(uniformBufferMemories.at(i))
-                            .setAllocateInfo(
-                                exqudens::vulkan::DeviceMemory::allocateInfoFrom(
-                                    physicalDevice.target,
-                                    uniformBuffers.at(i).target,
-                                    vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
-                                )
-                            )
-                            .build(device.target);
-
-                            uniformBuffers.at(i).target.bindMemory(*uniformBufferMemories.at(i).target, 0);
-
-                            uniformBufferMappedMemories.at(i) = uniformBufferMemories.at(i).target.mapMemory(0, uniformBufferMemories.at(i).allocateInfo->allocationSize);
-
                             exqudens::vulkan::ImageView::builder(imageViews.at(i))
                             .setCreateInfo(
                                 vk::ImageViewCreateInfo()
@@ -684,7 +587,7 @@ class VulkanTutorialCom3GuiTests: public testing::Test {
                             .build(device.target);
 
                             vk::DescriptorBufferInfo descriptorBufferInfo = vk::DescriptorBufferInfo()
-                            .setBuffer(*uniformBuffers.at(i).target)
+                            .setBuffer(*uniformRingBuffer.buffer.target)
                             .setOffset(0)
                             .setRange(sizeof(UniformBufferObject));
 
@@ -692,7 +595,7 @@ class VulkanTutorialCom3GuiTests: public testing::Test {
                             .setDstSet(*descriptorSets.targets.at(i))
                             .setDstBinding(0)
                             .setDstArrayElement(0)
-                            .setDescriptorType(vk::DescriptorType::eUniformBuffer)
+                            .setDescriptorType(vk::DescriptorType::eUniformBufferDynamic)
                             .setDescriptorCount(1)
                             .setPBufferInfo(&descriptorBufferInfo);
 
@@ -842,12 +745,21 @@ class VulkanTutorialCom3GuiTests: public testing::Test {
 
                         imageAvailableSemaphores.resize(swapchain.target.getImages().size());
                         renderFinishedSemaphores.resize(swapchain.target.getImages().size());
-                        inFlightFences.resize(swapchain.target.getImages().size());
                         for (size_t i = 0; i < swapchain.target.getImages().size(); i++) {
                             exqudens::vulkan::Semaphore::builder(imageAvailableSemaphores.at(i)).build(device.target);
                             exqudens::vulkan::Semaphore::builder(renderFinishedSemaphores.at(i)).build(device.target);
+                        }
+
+                        // fences outlive a recreation, frames submitted before it still signal them and 'deferredRelease' relies on that
+                        for (size_t i = swapchain.target.getImages().size(); i < inFlightFences.size(); i++) {
+                            (void) device.target.waitForFences({*inFlightFences.at(i).target}, true, UINT64_MAX);
+                        }
+                        size_t fenceCount = std::min(inFlightFences.size(), swapchain.target.getImages().size());
+                        inFlightFences.resize(swapchain.target.getImages().size());
+                        for (size_t i = fenceCount; i < inFlightFences.size(); i++) {
                             exqudens::vulkan::Fence::builder(inFlightFences.at(i)).setCreateInfo(vk::FenceCreateInfo().setFlags(vk::FenceCreateFlagBits::eSignaled)).build(device.target);
                         }
+                        currentFrame %= static_cast<uint32_t>(inFlightFences.size());
 
                         EXQUDENS_LOG_INFO(LOGGER_ID) << "end";
                     } catch (...) {
@@ -864,46 +776,37 @@ class VulkanTutorialCom3GuiTests: public testing::Test {
                             glfwWaitEvents();
                         }
 
-                        device.target.waitIdle();
-
-                        for (size_t i = 0; i < inFlightFences.size(); i++) {
-                            inFlightFences.at(i).clearAndRelease();
-                        }
-
+                        // frames in flight may still use these, they are destroyed once those frames retire,
+                        // the in-flight fences are kept so waiting on them still covers work submitted before the resize
                         for (size_t i = 0; i < renderFinishedSemaphores.size(); i++) {
-                            renderFinishedSemaphores.at(i).clearAndRelease();
+                            deferredRelease.push(renderFinishedSemaphores.at(i));
                         }
 
                         for (size_t i = 0; i < imageAvailableSemaphores.size(); i++) {
-                            imageAvailableSemaphores.at(i).clearAndRelease();
+                            deferredRelease.push(imageAvailableSemaphores.at(i));
                         }
 
-                        graphicsCommandBuffers.clearAndRelease();
+                        deferredRelease.push(graphicsCommandBuffers);
 
                         for (size_t i = 0; i < framebuffers.size(); i++) {
-                            framebuffers.at(i).clearAndRelease();
+                            deferredRelease.push(framebuffers.at(i));
                         }
 
-                        pipeline.clearAndRelease();
-                        renderPass.clearAndRelease();
+                        deferredRelease.push(pipeline);
+                        deferredRelease.push(renderPass);
 
                         for (size_t i = 0; i < imageViews.size(); i++) {
-                            imageViews.at(i).clearAndRelease();
-                        }
-
-                        for (size_t i = 0; i < uniformBuffers.size(); i++) {
-                            uniformBuffers.at(i).clearAndRelease();
-                        }
-
-                        for (size_t i = 0; i < uniformBufferMemories.size(); i++) {
-                            uniformBufferMemories.at(i).clearAndRelease();
+                            deferredRelease.push(imageViews.at(i));
                         }
 
-                        descriptorSets.clearAndRelease();
-                        descriptorPool.clearAndRelease();
+                        deferredRelease.push(uniformRingBuffer.buffer);
+                        deferredRelease.push(uniformRingBuffer.memory);
+                        uniformRingBuffer.clear();
 
-                        swapchain.clearAndRelease();
+                        deferredRelease.push(descriptorSets);
+                        deferredRelease.push(descriptorPool);
 
+                        // the swapchain itself is handed off through 'oldSwapchain' in initVulkanSwapchain
                         initVulkanSwapchain(framebufferWidth, framebufferHeight);
                     } catch (...) {
                         std::throw_with_nested(std::runtime_error(CALL_INFO));
@@ -914,6 +817,11 @@ class VulkanTutorialCom3GuiTests: public testing::Test {
                     try {
                         commandBuffer.begin(vk::CommandBufferBeginInfo());
 
+                        // the first frame acquires the uploaded buffers, it waits on the ticket at the same stage
+                        if (uploadTicket.value > 0) {
+                            exqudens::vulkan::UploadManager::acquire(commandBuffer, uploadTicket, vk::PipelineStageFlagBits::eVertexInput);
+                        }
+
                         vk::ClearValue clearValue = vk::ClearValue().setColor({0.0f, 0.0f, 0.0f, 1.0f});
                         commandBuffer.beginRenderPass(
                             vk::RenderPassBeginInfo()
@@ -954,7 +862,7 @@ class VulkanTutorialCom3GuiTests: public testing::Test {
                         commandBuffer.bindVertexBuffers(0, {*vertexBuffer.target}, {0});
                         commandBuffer.bindIndexBuffer(*indexBuffer.target, 0, vk::IndexType::eUint16);
 
-                        commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipelineLayout.target, 0, {*descriptorSets.targets.at(currentFrame)}, nullptr);
+                        commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipelineLayout.target, 0, {*descriptorSets.targets.at(currentFrame)}, {static_cast<uint32_t>(uniformAllocation.offset)});
                         commandBuffer.drawIndexed(static_cast<uint32_t>(indices.size()), 1, 0, 0, 0);
 
                         commandBuffer.endRenderPass();
@@ -1009,12 +917,14 @@ class VulkanTutorialCom3GuiTests: public testing::Test {
                     );
                     ubo.proj[1][1] *= -1;
 
-                    std::memcpy(uniformBufferMappedMemories.at(currentFrame), &ubo, sizeof(ubo));
+                    uniformAllocation = uniformRingBuffer.push(ubo);
+                    uniformRingBuffer.flush();
                 }
 
                 void drawFrame() {
                     try {
                         (void) device.target.waitForFences({*inFlightFences.at(currentFrame).target}, true, UINT64_MAX);
+                        deferredRelease.nextFrame();
 
                         vk::ResultValue<uint32_t> acquireNextImageValue = swapchain.target.acquireNextImage(UINT64_MAX, *imageAvailableSemaphores.at(currentFrame).target, nullptr);
                         uint32_t imageIndex = acquireNextImageValue.value;
@@ -1026,6 +936,7 @@ class VulkanTutorialCom3GuiTests: public testing::Test {
                             throw std::runtime_error(CALL_INFO + ": failed to acquire swap chain image!");
                         }
 
+                        uniformRingBuffer.beginFrame(device.target, currentFrame, *inFlightFences.at(currentFrame).target);
                         updateUniformBuffer(currentFrame, swapchain.createInfo.value().imageExtent.width, swapchain.createInfo.value().imageExtent.height);
 
                         // Only reset the fence if we are submitting work
@@ -1047,9 +958,23 @@ class VulkanTutorialCom3GuiTests: public testing::Test {
                             *renderFinishedSemaphores.at(currentFrame).target
                         };
 
+                        // the first frame waits on the gpu for the vertex and index uploads instead of blocking the cpu
+                        std::vector<uint64_t> waitValues = {0};
+                        std::vector<uint64_t> signalValues = {0};
+                        if (uploadTicket.value > 0) {
+                            waitSemaphores.emplace_back(uploadTicket.semaphore);
+                            waitStages.emplace_back(vk::PipelineStageFlagBits::eVertexInput);
+                            waitValues.emplace_back(uploadTicket.value);
+                            uploadTicket = {};
+                        }
+                        vk::TimelineSemaphoreSubmitInfo timelineSemaphoreSubmitInfo = vk::TimelineSemaphoreSubmitInfo()
+                        .setWaitSemaphoreValues(waitValues)
+                        .setSignalSemaphoreValues(signalValues);
+
                         graphicsQueue.target.submit(
                             {
                                 vk::SubmitInfo()
+                                .setPNext(&timelineSemaphoreSubmitInfo)
                                 .setWaitSemaphores(waitSemaphores)
                                 .setWaitDstStageMask(waitStages)
                                 .setCommandBuffers(waitCommandBuffers)
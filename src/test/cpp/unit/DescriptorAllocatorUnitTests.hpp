@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+#include <exqudens/log/api/Logging.hpp>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/vulkan/DescriptorAllocator.hpp"
+
+class DescriptorAllocatorUnitTests : public testing::Test {
+
+    public:
+
+        inline static const char* LOGGER_ID = "DescriptorAllocatorUnitTests";
+
+};
+
+TEST_F(DescriptorAllocatorUnitTests, test1) {
+    try {
+        std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+        std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "bgn";
+
+        std::vector<vk::DescriptorPoolSize> sizes = {
+            vk::DescriptorPoolSize(vk::DescriptorType::eUniformBuffer, 2),
+            vk::DescriptorPoolSize(vk::DescriptorType::eCombinedImageSampler, 4)
+        };
+
+        // case-1: pools double up to the limit, also past the uint32 range
+        ASSERT_EQ(512, exqudens::vulkan::DescriptorAllocator::nextMaxSetsFrom(256, 4096));
+        ASSERT_EQ(4096, exqudens::vulkan::DescriptorAllocator::nextMaxSetsFrom(4096, 4096));
+        ASSERT_EQ(UINT32_MAX, exqudens::vulkan::DescriptorAllocator::nextMaxSetsFrom(UINT32_MAX / 2 + 1, UINT32_MAX));
+
+        // case-2: pool size is shrunk so every scaled descriptor count fits into uint32
+        ASSERT_EQ(256, exqudens::vulkan::DescriptorAllocator::poolMaxSetsFrom(sizes, 256));
+        ASSERT_EQ(UINT32_MAX / 4, exqudens::vulkan::DescriptorAllocator::poolMaxSetsFrom(sizes, UINT32_MAX));
+        ASSERT_EQ(1, exqudens::vulkan::DescriptorAllocator::poolMaxSetsFrom(sizes, 0));
+
+        // case-3: build needs sizes and opens no pool
+        exqudens::vulkan::DescriptorAllocator allocator = {};
+
+        ASSERT_THROW(exqudens::vulkan::DescriptorAllocator::builder(allocator).build(), std::exception);
+
+        exqudens::vulkan::DescriptorAllocator::builder(allocator)
+        .setSizes(sizes)
+        .setMaxSets(8)
+        .build();
+
+        ASSERT_EQ(8, allocator.nextMaxSets);
+        ASSERT_EQ(0, allocator.size());
+
+        // case-4: reset moves every used pool to the ready ones
+        allocator.usedPools.emplace_back(std::make_unique<exqudens::vulkan::DescriptorPool>());
+        allocator.usedPools.emplace_back(std::make_unique<exqudens::vulkan::DescriptorPool>());
+        allocator.reset();
+
+        ASSERT_TRUE(allocator.usedPools.empty());
+        ASSERT_EQ(2, allocator.readyPools.size());
+        ASSERT_EQ(2, allocator.size());
+
+        // case-5: clear drops pools and settings
+        allocator.clear();
+
+        ASSERT_EQ(0, allocator.size());
+        ASSERT_TRUE(allocator.sizes.empty());
+        ASSERT_FALSE(allocator.maxSets.has_value());
+
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "end";
+    } catch (const std::exception& e) {
+        std::string errorMessage = TestUtils::toString(e);
+        std::cout << LOGGER_ID << " ERROR: " << errorMessage << std::endl;
+        FAIL() << errorMessage;
+    }
+}
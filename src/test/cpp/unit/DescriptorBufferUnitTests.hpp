@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+#include <exqudens/log/api/Logging.hpp>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/vulkan/DescriptorBuffer.hpp"
+
+class DescriptorBufferUnitTests : public testing::Test {
+
+    public:
+
+        inline static const char* LOGGER_ID = "DescriptorBufferUnitTests";
+
+};
+
+TEST_F(DescriptorBufferUnitTests, test1) {
+    try {
+        std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+        std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "bgn";
+
+        // case-1: every frame gets its own aligned region per layout
+        vk::DeviceSize size = 0;
+        std::vector<vk::DeviceSize> offsets = exqudens::vulkan::DescriptorBuffer::offsetsFrom({40, 8}, 64, 2, &size);
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "size: '" << size << "'";
+
+        ASSERT_EQ(std::vector<vk::DeviceSize>({0, 64, 128, 192}), offsets);
+        ASSERT_EQ(200, size);
+
+        // case-2: robust buffer access switches buffer descriptors to their robust size
+        exqudens::vulkan::DescriptorBuffer buffer = {};
+        buffer.properties = vk::PhysicalDeviceDescriptorBufferPropertiesEXT()
+        .setUniformBufferDescriptorSize(16)
+        .setRobustUniformBufferDescriptorSize(32)
+        .setSampledImageDescriptorSize(8);
+
+        ASSERT_EQ(16, buffer.descriptorSizeFrom(vk::DescriptorType::eUniformBuffer));
+
+        buffer.robustBufferAccess = true;
+
+        ASSERT_EQ(32, buffer.descriptorSizeFrom(vk::DescriptorType::eUniformBuffer));
+        ASSERT_EQ(8, buffer.descriptorSizeFrom(vk::DescriptorType::eSampledImage));
+
+        // case-3: writes go to the region of the current frame and wrap after 'frameCount' frames
+        buffer.layouts = {vk::DescriptorSetLayout(), vk::DescriptorSetLayout()};
+        buffer.bindingOffsets = {{{0, 0}, {1, 16}}, {{0, 0}}};
+        buffer.frameCount = 2;
+        buffer.offsets = offsets;
+
+        ASSERT_EQ(16 + 8 * 3, buffer.offsetFrom(0, 1, 3, vk::DescriptorType::eSampledImage));
+        ASSERT_EQ(64, buffer.offsetFrom(1, 0, 0, vk::DescriptorType::eSampledImage));
+
+        buffer.nextFrame();
+
+        ASSERT_EQ(128 + 16, buffer.offsetFrom(0, 1, 0, vk::DescriptorType::eSampledImage));
+
+        buffer.nextFrame();
+
+        ASSERT_EQ(16, buffer.offsetFrom(0, 1, 0, vk::DescriptorType::eSampledImage));
+        ASSERT_THROW(buffer.offsetFrom(1, 1, 0, vk::DescriptorType::eSampledImage), std::runtime_error);
+
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "end";
+    } catch (const std::exception& e) {
+        std::string errorMessage = TestUtils::toString(e);
+        std::cout << LOGGER_ID << " ERROR: " << errorMessage << std::endl;
+        FAIL() << errorMessage;
+    }
+}
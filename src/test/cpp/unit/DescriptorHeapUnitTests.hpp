@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <iostream>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+#include <exqudens/log/api/Logging.hpp>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/vulkan/DescriptorHeap.hpp"
+
+class DescriptorHeapUnitTests : public testing::Test {
+
+    public:
+
+        inline static const char* LOGGER_ID = "DescriptorHeapUnitTests";
+
+};
+
+TEST_F(DescriptorHeapUnitTests, test1) {
+    try {
+        std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+        std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "bgn";
+
+        // the slot bookkeeping is cpu only, so the heap is filled through its builder but not built
+        exqudens::vulkan::DescriptorHeap heap = {};
+        exqudens::vulkan::DescriptorHeap::builder(heap)
+        .addArray(vk::DescriptorType::eSampledImage, 2)
+        .setFrameCount(2);
+
+        uint32_t index1 = heap.allocate(0);
+        uint32_t index2 = heap.allocate(0);
+
+        ASSERT_EQ(0, index1);
+        ASSERT_EQ(1, index2);
+        ASSERT_THROW(heap.allocate(0), std::runtime_error);
+
+        // case-1: a slot is freed once
+        heap.free(0, index1);
+
+        ASSERT_THROW(heap.free(0, index1), std::runtime_error);
+        ASSERT_THROW(heap.free(0, 5), std::runtime_error);
+
+        // case-2: a freed slot comes back only after 'frameCount' frames
+        heap.nextFrame();
+
+        ASSERT_THROW(heap.allocate(0), std::runtime_error);
+
+        heap.nextFrame();
+
+        ASSERT_EQ(index1, heap.allocate(0));
+
+        // case-3: writes past the binding capacity are rejected before the device is touched
+        vk::raii::Device device = nullptr;
+
+        ASSERT_THROW(heap.write(device, 0, 2, vk::DescriptorImageInfo()), std::runtime_error);
+        ASSERT_THROW(heap.write(device, 0, 2, vk::DescriptorBufferInfo()), std::runtime_error);
+
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "end";
+    } catch (const std::exception& e) {
+        std::string errorMessage = TestUtils::toString(e);
+        std::cout << LOGGER_ID << " ERROR: " << errorMessage << std::endl;
+        FAIL() << errorMessage;
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+#include <exqudens/log/api/Logging.hpp>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/vulkan/DescriptorSetCache.hpp"
+
+class DescriptorSetCacheUnitTests : public testing::Test {
+
+    public:
+
+        inline static const char* LOGGER_ID = "DescriptorSetCacheUnitTests";
+
+};
+
+TEST_F(DescriptorSetCacheUnitTests, test1) {
+    try {
+        std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+        std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "bgn";
+
+        // handles are only read into the key, never dereferenced
+        vk::DescriptorSetLayout layout = vk::DescriptorSetLayout(reinterpret_cast<VkDescriptorSetLayout>(uintptr_t(1)));
+        vk::DescriptorBufferInfo bufferInfo = vk::DescriptorBufferInfo(vk::Buffer(reinterpret_cast<VkBuffer>(uintptr_t(2))), 0, 64);
+        vk::DescriptorImageInfo imageInfo = vk::DescriptorImageInfo(
+            vk::Sampler(reinterpret_cast<VkSampler>(uintptr_t(3))),
+            vk::ImageView(reinterpret_cast<VkImageView>(uintptr_t(4))),
+            vk::ImageLayout::eShaderReadOnlyOptimal
+        );
+        std::vector<vk::WriteDescriptorSet> writes1 = {
+            vk::WriteDescriptorSet().setDstBinding(0).setDescriptorType(vk::DescriptorType::eUniformBuffer).setBufferInfo(bufferInfo),
+            vk::WriteDescriptorSet().setDstBinding(1).setDescriptorType(vk::DescriptorType::eCombinedImageSampler).setImageInfo(imageInfo)
+        };
+        std::vector<vk::WriteDescriptorSet> writes2 = writes1;
+
+        // case-1: identical writes produce equal keys
+        exqudens::vulkan::DescriptorSetCache::Key key1 = exqudens::vulkan::DescriptorSetCache::keyFrom(layout, writes1);
+        exqudens::vulkan::DescriptorSetCache::Key key2 = exqudens::vulkan::DescriptorSetCache::keyFrom(layout, writes2);
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "key1.size: '" << key1.size() << "'";
+
+        ASSERT_EQ(1 + 4 + 3 + 4 + 3, key1.size());
+        ASSERT_EQ(key1, key2);
+        ASSERT_EQ(exqudens::vulkan::DescriptorSetCache::KeyHash()(key1), exqudens::vulkan::DescriptorSetCache::KeyHash()(key2));
+
+        // case-2: a stale array the type does not use is ignored
+        vk::BufferView texelBufferView = vk::BufferView(reinterpret_cast<VkBufferView>(uintptr_t(5)));
+        writes2.at(0).setPTexelBufferView(&texelBufferView);
+        writes2.at(1).setPBufferInfo(&bufferInfo);
+        key2 = exqudens::vulkan::DescriptorSetCache::keyFrom(layout, writes2);
+
+        ASSERT_EQ(key1, key2);
+
+        // case-3: a different resource or range produces a different key
+        vk::DescriptorBufferInfo otherBufferInfo = bufferInfo;
+        otherBufferInfo.setRange(128);
+        writes2 = writes1;
+        writes2.at(0).setBufferInfo(otherBufferInfo);
+        key2 = exqudens::vulkan::DescriptorSetCache::keyFrom(layout, writes2);
+
+        ASSERT_NE(key1, key2);
+
+        // case-4: the layout takes part in the key
+        key2 = exqudens::vulkan::DescriptorSetCache::keyFrom(vk::DescriptorSetLayout(reinterpret_cast<VkDescriptorSetLayout>(uintptr_t(6))), writes1);
+
+        ASSERT_NE(key1, key2);
+
+        // case-5: a missing array for the type and an unsupported type are rejected
+        writes2 = writes1;
+        writes2.at(0).setPBufferInfo(nullptr);
+
+        ASSERT_THROW(exqudens::vulkan::DescriptorSetCache::keyFrom(layout, writes2), std::exception);
+
+        writes2 = writes1;
+        writes2.at(0).setDescriptorType(vk::DescriptorType::eInlineUniformBlock);
+
+        ASSERT_THROW(exqudens::vulkan::DescriptorSetCache::keyFrom(layout, writes2), std::exception);
+
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "end";
+    } catch (const std::exception& e) {
+        std::string errorMessage = TestUtils::toString(e);
+        std::cout << LOGGER_ID << " ERROR: " << errorMessage << std::endl;
+        FAIL() << errorMessage;
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+#include <exqudens/log/api/Logging.hpp>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/vulkan/DescriptorUpdateTemplate.hpp"
+
+class DescriptorUpdateTemplateUnitTests : public testing::Test {
+
+    public:
+
+        inline static const char* LOGGER_ID = "DescriptorUpdateTemplateUnitTests";
+
+    protected:
+
+        // what a caller pushes for 'ubo' + 'textures[2]' + 'texel'
+        struct Data {
+            vk::DescriptorBufferInfo ubo;
+            vk::DescriptorImageInfo textures[2];
+            vk::BufferView texel;
+        };
+
+};
+
+TEST_F(DescriptorUpdateTemplateUnitTests, test1) {
+    try {
+        std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+        std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "bgn";
+
+        std::vector<vk::DescriptorSetLayoutBinding> bindings = {
+            vk::DescriptorSetLayoutBinding(0, vk::DescriptorType::eUniformBuffer, 1, vk::ShaderStageFlagBits::eVertex),
+            vk::DescriptorSetLayoutBinding(1, vk::DescriptorType::eCombinedImageSampler, 2, vk::ShaderStageFlagBits::eFragment),
+            vk::DescriptorSetLayoutBinding(2, vk::DescriptorType::eSampler, 0, vk::ShaderStageFlagBits::eFragment),
+            vk::DescriptorSetLayoutBinding(3, vk::DescriptorType::eUniformTexelBuffer, 1, vk::ShaderStageFlagBits::eFragment)
+        };
+
+        size_t dataSize = 0;
+        std::vector<vk::DescriptorUpdateTemplateEntry> entries = exqudens::vulkan::DescriptorUpdateTemplate::entriesFrom(bindings, &dataSize);
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "dataSize: '" << dataSize << "'";
+
+        // case-1: empty bindings are skipped
+        ASSERT_EQ(3, entries.size());
+        ASSERT_EQ(3, entries.at(2).dstBinding);
+
+        // case-2: generated offsets match the plain struct layout
+        ASSERT_EQ(offsetof(Data, ubo), entries.at(0).offset);
+        ASSERT_EQ(offsetof(Data, textures), entries.at(1).offset);
+        ASSERT_EQ(sizeof(vk::DescriptorImageInfo), entries.at(1).stride);
+        ASSERT_EQ(2, entries.at(1).descriptorCount);
+        ASSERT_EQ(offsetof(Data, texel), entries.at(2).offset);
+        ASSERT_EQ(sizeof(Data), dataSize);
+
+        // case-3: inline uniform blocks have no info struct
+        bindings.emplace_back(4, vk::DescriptorType::eInlineUniformBlock, 16, vk::ShaderStageFlagBits::eFragment);
+
+        ASSERT_THROW(exqudens::vulkan::DescriptorUpdateTemplate::entriesFrom(bindings), std::runtime_error);
+
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "end";
+    } catch (const std::exception& e) {
+        std::string errorMessage = TestUtils::toString(e);
+        std::cout << LOGGER_ID << " ERROR: " << errorMessage << std::endl;
+        FAIL() << errorMessage;
+    }
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <iostream>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+#include <exqudens/log/api/Logging.hpp>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/vulkan/DeviceMemory.hpp"
+
+class DeviceMemoryUnitTests : public testing::Test {
+
+    public:
+
+        inline static const char* LOGGER_ID = "DeviceMemoryUnitTests";
+
+    protected:
+
+        // typical discrete gpu with a resizable bar heap
+        static vk::PhysicalDeviceMemoryProperties memoryProperties() {
+            vk::PhysicalDeviceMemoryProperties result = {};
+            result.memoryTypeCount = 4;
+            result.memoryTypes.at(0).propertyFlags = vk::MemoryPropertyFlagBits::eDeviceLocal;
+            result.memoryTypes.at(1).propertyFlags = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
+            result.memoryTypes.at(2).propertyFlags = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent | vk::MemoryPropertyFlagBits::eHostCached;
+            result.memoryTypes.at(3).propertyFlags = vk::MemoryPropertyFlagBits::eDeviceLocal | vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
+            return result;
+        }
+
+};
+
+TEST_F(DeviceMemoryUnitTests, test1) {
+    try {
+        std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+        std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "bgn";
+
+        vk::PhysicalDeviceMemoryProperties properties = memoryProperties();
+        std::optional<uint32_t> expected = {};
+        std::optional<uint32_t> actual = {};
+
+        // case-1: required flags only picks the plainest matching type
+        expected = 1;
+        actual = exqudens::vulkan::DeviceMemory::memoryTypeIndexFrom(
+            properties,
+            0b1111,
+            vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+        );
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "expected: '" << expected.value() << "'";
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "actual: '" << actual.value_or(UINT32_MAX) << "'";
+
+        ASSERT_EQ(expected, actual);
+
+        // case-2: preferred device local picks rebar memory
+        expected = 3;
+        actual = exqudens::vulkan::DeviceMemory::memoryTypeIndexFrom(
+            properties,
+            0b1111,
+            vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+            vk::MemoryPropertyFlagBits::eDeviceLocal
+        );
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "expected: '" << expected.value() << "'";
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "actual: '" << actual.value_or(UINT32_MAX) << "'";
+
+        ASSERT_EQ(expected, actual);
+
+        // case-3: avoided flags outweigh preferred ones
+        expected = 1;
+        actual = exqudens::vulkan::DeviceMemory::memoryTypeIndexFrom(
+            properties,
+            0b0110,
+            vk::MemoryPropertyFlagBits::eHostVisible,
+            vk::MemoryPropertyFlagBits::eHostCached,
+            vk::MemoryPropertyFlagBits::eHostCached
+        );
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "expected: '" << expected.value() << "'";
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "actual: '" << actual.value_or(UINT32_MAX) << "'";
+
+        ASSERT_EQ(expected, actual);
+
+        // case-4: memory type bits exclude every matching type
+        actual = exqudens::vulkan::DeviceMemory::memoryTypeIndexFrom(
+            properties,
+            0b0001,
+            vk::MemoryPropertyFlagBits::eHostVisible
+        );
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "actual.has_value: '" << actual.has_value() << "'";
+
+        ASSERT_FALSE(actual.has_value());
+
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "end";
+    } catch (const std::exception& e) {
+        std::string errorMessage = TestUtils::toString(e);
+        std::cout << LOGGER_ID << " ERROR: " << errorMessage << std::endl;
+        FAIL() << errorMessage;
+    }
+}
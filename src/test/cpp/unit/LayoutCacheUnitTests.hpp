@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <iostream>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+#include <exqudens/log/api/Logging.hpp>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/vulkan/LayoutCache.hpp"
+
+class LayoutCacheUnitTests : public testing::Test {
+
+    public:
+
+        inline static const char* LOGGER_ID = "LayoutCacheUnitTests";
+
+};
+
+TEST_F(LayoutCacheUnitTests, test1) {
+    try {
+        std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+        std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "bgn";
+
+        exqudens::vulkan::DescriptorSetLayout setLayout1 = {};
+        exqudens::vulkan::DescriptorSetLayout setLayout2 = {};
+        exqudens::vulkan::DescriptorSetLayout::builder(setLayout1)
+        .addBinding(vk::DescriptorSetLayoutBinding(0, vk::DescriptorType::eUniformBuffer, 1, vk::ShaderStageFlagBits::eVertex))
+        .addBinding(vk::DescriptorSetLayoutBinding(1, vk::DescriptorType::eCombinedImageSampler, 1, vk::ShaderStageFlagBits::eFragment));
+        exqudens::vulkan::DescriptorSetLayout::builder(setLayout2)
+        .addBinding(vk::DescriptorSetLayoutBinding(1, vk::DescriptorType::eCombinedImageSampler, 1, vk::ShaderStageFlagBits::eFragment))
+        .addBinding(vk::DescriptorSetLayoutBinding(0, vk::DescriptorType::eUniformBuffer, 1, vk::ShaderStageFlagBits::eVertex));
+
+        // case-1: binding order does not change the key
+        exqudens::vulkan::LayoutCache::Key key1 = exqudens::vulkan::LayoutCache::keyFrom(setLayout1);
+        exqudens::vulkan::LayoutCache::Key key2 = exqudens::vulkan::LayoutCache::keyFrom(setLayout2);
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "key1.size: '" << key1.size() << "'";
+
+        ASSERT_EQ(key1, key2);
+        ASSERT_EQ(exqudens::vulkan::LayoutCache::KeyHash()(key1), exqudens::vulkan::LayoutCache::KeyHash()(key2));
+
+        // case-2: stage flags and binding flags take part in the key
+        setLayout2.bindings.at(1).setStageFlags(vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment);
+        key2 = exqudens::vulkan::LayoutCache::keyFrom(setLayout2);
+
+        ASSERT_NE(key1, key2);
+
+        setLayout2.bindings.at(1).setStageFlags(vk::ShaderStageFlagBits::eVertex);
+        exqudens::vulkan::DescriptorSetLayout::builder(setLayout2)
+        .addBindingFlags(vk::DescriptorBindingFlagBits::ePartiallyBound)
+        .addBindingFlags({});
+        key2 = exqudens::vulkan::LayoutCache::keyFrom(setLayout2);
+
+        ASSERT_NE(key1, key2);
+
+        // case-3: push constant range order does not change the key
+        vk::DescriptorSetLayout handle = vk::DescriptorSetLayout(reinterpret_cast<VkDescriptorSetLayout>(uintptr_t(1)));
+        exqudens::vulkan::PipelineLayout pipelineLayout1 = {};
+        exqudens::vulkan::PipelineLayout pipelineLayout2 = {};
+        exqudens::vulkan::PipelineLayout::builder(pipelineLayout1)
+        .addSetLayout(handle)
+        .addPushConstantRange(vk::PushConstantRange(vk::ShaderStageFlagBits::eVertex, 0, 64))
+        .addPushConstantRange(vk::PushConstantRange(vk::ShaderStageFlagBits::eFragment, 64, 16));
+        exqudens::vulkan::PipelineLayout::builder(pipelineLayout2)
+        .addSetLayout(handle)
+        .addPushConstantRange(vk::PushConstantRange(vk::ShaderStageFlagBits::eFragment, 64, 16))
+        .addPushConstantRange(vk::PushConstantRange(vk::ShaderStageFlagBits::eVertex, 0, 64));
+
+        ASSERT_EQ(exqudens::vulkan::LayoutCache::keyFrom(pipelineLayout1), exqudens::vulkan::LayoutCache::keyFrom(pipelineLayout2));
+
+        pipelineLayout2.pushConstantRanges.at(0).setSize(32);
+
+        ASSERT_NE(exqudens::vulkan::LayoutCache::keyFrom(pipelineLayout1), exqudens::vulkan::LayoutCache::keyFrom(pipelineLayout2));
+
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "end";
+    } catch (const std::exception& e) {
+        std::string errorMessage = TestUtils::toString(e);
+        std::cout << LOGGER_ID << " ERROR: " << errorMessage << std::endl;
+        FAIL() << errorMessage;
+    }
+}
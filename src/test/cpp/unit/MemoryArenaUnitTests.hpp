@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <iostream>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+#include <exqudens/log/api/Logging.hpp>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/vulkan/MemoryArena.hpp"
+
+class MemoryArenaUnitTests : public testing::Test {
+
+    public:
+
+        inline static const char* LOGGER_ID = "MemoryArenaUnitTests";
+
+    protected:
+
+        static vk::PhysicalDeviceMemoryProperties memoryProperties() {
+            vk::PhysicalDeviceMemoryProperties result = {};
+            result.memoryTypeCount = 1;
+            result.memoryTypes.at(0).propertyFlags = vk::MemoryPropertyFlagBits::eDeviceLocal;
+            return result;
+        }
+
+        static vk::MemoryRequirements requirements(vk::DeviceSize size) {
+            return vk::MemoryRequirements(size, 1, 0b1);
+        }
+
+};
+
+TEST_F(MemoryArenaUnitTests, test1) {
+    try {
+        std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+        std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "bgn";
+
+        // both handles stay null, the cases below never need a new block
+        vk::raii::PhysicalDevice physicalDevice = nullptr;
+        vk::raii::Device device = nullptr;
+
+        exqudens::vulkan::MemoryArena arena = {};
+        exqudens::vulkan::MemoryArena::builder(arena)
+        .setBlockSize(1024)
+        .setMinAllocationSize(256)
+        .setBufferImageGranularity(1)
+        .setMemoryProperties(memoryProperties())
+        .build(physicalDevice);
+
+        // one free block of order 2 (4 x 256)
+        exqudens::vulkan::MemoryArena::Block block = {};
+        block.memoryTypeIndex = 0;
+        block.order = 2;
+        block.freeOffsets.resize(3);
+        block.freeOffsets.at(2).insert(0);
+        arena.blocks.emplace_back(std::move(block));
+
+        // case-1: allocations split the block and take the lowest free offsets
+        exqudens::vulkan::MemoryArena::Allocation a = arena.allocate(device, requirements(200), vk::MemoryPropertyFlagBits::eDeviceLocal);
+        exqudens::vulkan::MemoryArena::Allocation b = arena.allocate(device, requirements(256), vk::MemoryPropertyFlagBits::eDeviceLocal);
+        exqudens::vulkan::MemoryArena::Allocation c = arena.allocate(device, requirements(300), vk::MemoryPropertyFlagBits::eDeviceLocal);
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "offsets: '" << a.offset << ", " << b.offset << ", " << c.offset << "'";
+
+        ASSERT_EQ(0, a.offset);
+        ASSERT_EQ(256, a.size);
+        ASSERT_EQ(256, b.offset);
+        ASSERT_EQ(512, c.offset);
+        ASSERT_EQ(512, c.size);
+        ASSERT_EQ(1, c.order);
+        ASSERT_TRUE(arena.blocks.at(0).freeOffsets.at(0).empty());
+        ASSERT_TRUE(arena.blocks.at(0).freeOffsets.at(1).empty());
+        ASSERT_TRUE(arena.blocks.at(0).freeOffsets.at(2).empty());
+
+        // case-2: freeing both halves merges them into one order 1 block
+        arena.free(a);
+
+        ASSERT_EQ(1, arena.blocks.at(0).freeOffsets.at(0).count(0));
+
+        arena.free(b);
+
+        ASSERT_TRUE(arena.blocks.at(0).freeOffsets.at(0).empty());
+        ASSERT_EQ(1, arena.blocks.at(0).freeOffsets.at(1).count(0));
+
+        // case-3: double free is rejected, also when the range was merged
+        ASSERT_THROW(arena.free(a), std::exception);
+        ASSERT_THROW(arena.free(b), std::exception);
+
+        // case-4: the last free releases the block
+        arena.free(c);
+
+        ASSERT_EQ(1, arena.blocks.size());
+        ASSERT_TRUE(arena.blocks.at(0).freeOffsets.empty());
+        ASSERT_THROW(arena.free(c), std::exception);
+
+        // case-5: oversized requests and unbuilt arenas are rejected
+        ASSERT_THROW(arena.allocate(device, requirements(2048), vk::MemoryPropertyFlagBits::eDeviceLocal), std::exception);
+
+        exqudens::vulkan::MemoryArena other = {};
+
+        ASSERT_THROW(other.allocate(device, requirements(256), vk::MemoryPropertyFlagBits::eDeviceLocal), std::exception);
+
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "end";
+    } catch (const std::exception& e) {
+        std::string errorMessage = TestUtils::toString(e);
+        std::cout << LOGGER_ID << " ERROR: " << errorMessage << std::endl;
+        FAIL() << errorMessage;
+    }
+}
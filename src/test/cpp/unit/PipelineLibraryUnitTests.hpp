@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+#include <exqudens/log/api/Logging.hpp>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/vulkan/Pipeline.hpp"
+#include "exqudens/vulkan/PipelineStateKey.hpp"
+#include "exqudens/vulkan/PipelineLibrary.hpp"
+
+class PipelineLibraryUnitTests : public testing::Test {
+
+    public:
+
+        inline static const char* LOGGER_ID = "PipelineLibraryUnitTests";
+
+    protected:
+
+        // true for every part whose key differs between the two pipelines, in link order
+        static std::vector<bool> changedParts(const exqudens::vulkan::Pipeline& pipeline1, const exqudens::vulkan::Pipeline& pipeline2) {
+            exqudens::vulkan::PipelineStateKey key1 = exqudens::vulkan::PipelineStateKey::from(pipeline1);
+            exqudens::vulkan::PipelineStateKey key2 = exqudens::vulkan::PipelineStateKey::from(pipeline2);
+            std::vector<bool> result = {};
+            for (vk::GraphicsPipelineLibraryFlagBitsEXT flag : {
+                vk::GraphicsPipelineLibraryFlagBitsEXT::eVertexInputInterface,
+                vk::GraphicsPipelineLibraryFlagBitsEXT::ePreRasterizationShaders,
+                vk::GraphicsPipelineLibraryFlagBitsEXT::eFragmentShader,
+                vk::GraphicsPipelineLibraryFlagBitsEXT::eFragmentOutputInterface
+            }) {
+                result.emplace_back(key1.part(flag) != key2.part(flag));
+            }
+            return result;
+        }
+
+};
+
+TEST_F(PipelineLibraryUnitTests, test1) {
+    try {
+        std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+        std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "bgn";
+
+        exqudens::vulkan::Pipeline pipeline1 = {};
+        exqudens::vulkan::Pipeline pipeline2 = {};
+        TestUtils::fillPipeline(pipeline1);
+        exqudens::vulkan::Pipeline::builder(pipeline1).prepare();
+
+        // case-1: equal descriptions share every part, and parts of one description never collide
+        TestUtils::fillPipeline(pipeline2);
+        exqudens::vulkan::Pipeline::builder(pipeline2).prepare();
+        exqudens::vulkan::PipelineStateKey key = exqudens::vulkan::PipelineStateKey::from(pipeline1);
+
+        ASSERT_EQ(std::vector<bool>({false, false, false, false}), changedParts(pipeline1, pipeline2));
+        ASSERT_TRUE(key.part(vk::GraphicsPipelineLibraryFlagBitsEXT::eVertexInputInterface) != key.part(vk::GraphicsPipelineLibraryFlagBitsEXT::eFragmentOutputInterface));
+        ASSERT_TRUE(key.part(vk::GraphicsPipelineLibraryFlagBitsEXT::ePreRasterizationShaders) != key.part(vk::GraphicsPipelineLibraryFlagBitsEXT::eFragmentShader));
+
+        // case-2: the topology only reaches the vertex input part
+        TestUtils::fillPipeline(pipeline2);
+        pipeline2.inputAssemblyStateCreateInfo.value().setTopology(vk::PrimitiveTopology::eLineList);
+        exqudens::vulkan::Pipeline::builder(pipeline2).prepare();
+
+        ASSERT_EQ(std::vector<bool>({true, false, false, false}), changedParts(pipeline1, pipeline2));
+
+        // case-3: the layout reaches both shader parts
+        TestUtils::fillPipeline(pipeline2);
+        pipeline2.graphicsCreateInfo.value().setLayout(vk::PipelineLayout(reinterpret_cast<VkPipelineLayout>(uintptr_t(5))));
+        exqudens::vulkan::Pipeline::builder(pipeline2).prepare();
+
+        ASSERT_EQ(std::vector<bool>({false, true, true, false}), changedParts(pipeline1, pipeline2));
+
+        // case-4: the blend state only reaches the fragment output part
+        TestUtils::fillPipeline(pipeline2);
+        pipeline2.colorBlendAttachmentStates.front().setColorWriteMask(vk::ColorComponentFlagBits::eR);
+        exqudens::vulkan::Pipeline::builder(pipeline2).prepare();
+
+        ASSERT_EQ(std::vector<bool>({false, false, false, true}), changedParts(pipeline1, pipeline2));
+
+        // case-5: the fragment shader part is built with the whole multisample state
+        TestUtils::fillPipeline(pipeline2);
+        pipeline2.multisampleStateCreateInfo.value().setAlphaToCoverageEnable(true);
+        exqudens::vulkan::Pipeline::builder(pipeline2).prepare();
+
+        ASSERT_EQ(std::vector<bool>({false, false, true, true}), changedParts(pipeline1, pipeline2));
+
+        // case-6: specialization reaches the shader parts only
+        TestUtils::fillPipeline(pipeline2);
+        exqudens::vulkan::Pipeline::builder(pipeline2).addSpecialization(0, 16u).prepare();
+
+        ASSERT_EQ(std::vector<bool>({false, true, true, false}), changedParts(pipeline1, pipeline2));
+
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "end";
+    } catch (const std::exception& e) {
+        std::string errorMessage = TestUtils::toString(e);
+        std::cout << LOGGER_ID << " ERROR: " << errorMessage << std::endl;
+        FAIL() << errorMessage;
+    }
+}
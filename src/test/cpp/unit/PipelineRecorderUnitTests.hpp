@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <filesystem>
+#include <iostream>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+#include <exqudens/log/api/Logging.hpp>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/vulkan/Pipeline.hpp"
+#include "exqudens/vulkan/PipelineStateKey.hpp"
+#include "exqudens/vulkan/PipelineRecorder.hpp"
+
+class PipelineRecorderUnitTests : public testing::Test {
+
+    public:
+
+        inline static const char* LOGGER_ID = "PipelineRecorderUnitTests";
+
+    protected:
+
+        // static viewports, a render pass and shared specialization on top of the common description
+        static void fill(exqudens::vulkan::Pipeline& pipeline) {
+            TestUtils::fillPipeline(pipeline);
+            pipeline.viewportStateCreateInfo.reset();
+            pipeline.viewports = {vk::Viewport(0.0f, 0.0f, 800.0f, 600.0f, 0.0f, 1.0f)};
+            pipeline.scissors = {vk::Rect2D(vk::Offset2D(0, 0), vk::Extent2D(800, 600))};
+            pipeline.dynamicStates.clear();
+            pipeline.graphicsCreateInfo.value()
+            .setRenderPass(vk::RenderPass(reinterpret_cast<VkRenderPass>(uintptr_t(4))));
+            exqudens::vulkan::Pipeline::builder(pipeline).addSpecialization(0, 16u);
+        }
+
+        static void registerHandles(exqudens::vulkan::PipelineRecorder& recorder) {
+            recorder.registerHandle("vert", vk::ShaderModule(reinterpret_cast<VkShaderModule>(uintptr_t(1))));
+            recorder.registerHandle("frag", vk::ShaderModule(reinterpret_cast<VkShaderModule>(uintptr_t(2))));
+            recorder.registerHandle("layout", vk::PipelineLayout(reinterpret_cast<VkPipelineLayout>(uintptr_t(3))));
+            recorder.registerHandle("renderPass", vk::RenderPass(reinterpret_cast<VkRenderPass>(uintptr_t(4))));
+        }
+
+};
+
+TEST_F(PipelineRecorderUnitTests, test1) {
+    try {
+        std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+        std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "bgn";
+
+        std::string file = (std::filesystem::path(TestUtils::getTestOutputDir(testGroup, testCase)) / "pipelines.bin").generic_string();
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "file: '" << file << "'";
+
+        exqudens::vulkan::Pipeline pipeline = {};
+        fill(pipeline);
+        exqudens::vulkan::Pipeline::builder(pipeline).prepare();
+
+        // case-1: unregistered handles are not recorded
+        exqudens::vulkan::PipelineRecorder recorder1 = {};
+        exqudens::vulkan::PipelineRecorder::builder(recorder1).setFile(file).build();
+
+        ASSERT_FALSE(recorder1.record(pipeline));
+        ASSERT_EQ(0, recorder1.size());
+
+        // case-2: the same description is recorded once
+        registerHandles(recorder1);
+
+        ASSERT_TRUE(recorder1.record(pipeline));
+        ASSERT_FALSE(recorder1.record(pipeline));
+        ASSERT_EQ(1, recorder1.size());
+
+        recorder1.save();
+
+        // case-3: the manifest replays into the same description on the next launch
+        exqudens::vulkan::PipelineRecorder recorder2 = {};
+        exqudens::vulkan::PipelineRecorder::builder(recorder2).setFile(file).setReadFile(true).build();
+        registerHandles(recorder2);
+
+        ASSERT_EQ(1, recorder2.size());
+
+        exqudens::vulkan::PipelineRecorder::Replay replay = {};
+        replay.record = recorder2.records.front();
+
+        ASSERT_TRUE(recorder2.resolve(replay));
+
+        exqudens::vulkan::Pipeline::builder(replay.pipeline).prepare();
+        exqudens::vulkan::PipelineStateKey key1 = exqudens::vulkan::PipelineStateKey::from(pipeline);
+        exqudens::vulkan::PipelineStateKey key2 = exqudens::vulkan::PipelineStateKey::from(replay.pipeline);
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "key1.hash: '" << key1.hash() << "'";
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "key2.hash: '" << key2.hash() << "'";
+
+        ASSERT_TRUE(key1 == key2);
+        ASSERT_EQ(pipeline.viewports.front(), replay.pipeline.viewports.front());
+
+        // case-4: a short or foreign manifest is ignored
+        recorder2.records.clear();
+        recorder2.keys.clear();
+        std::filesystem::resize_file(file, sizeof(uint32_t) * 2);
+
+        ASSERT_FALSE(recorder2.load());
+        ASSERT_EQ(0, recorder2.size());
+
+        // case-5: a manifest cut inside a record is ignored, not thrown
+        recorder1.save();
+        std::filesystem::resize_file(file, std::filesystem::file_size(file) - 1);
+
+        ASSERT_FALSE(recorder2.load());
+        ASSERT_EQ(0, recorder2.size());
+
+        // case-6: a sample mask only reaches the key as a hash, so it is not recorded
+        exqudens::vulkan::Pipeline masked = {};
+        fill(masked);
+        VkSampleMask sampleMask = 0x1;
+        masked.multisampleStateCreateInfo.value().setPSampleMask(&sampleMask);
+        exqudens::vulkan::Pipeline::builder(masked).prepare();
+        exqudens::vulkan::PipelineRecorder recorder3 = {};
+        exqudens::vulkan::PipelineRecorder::builder(recorder3).build();
+        registerHandles(recorder3);
+
+        ASSERT_FALSE(recorder3.record(masked));
+        ASSERT_EQ(0, recorder3.size());
+
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "end";
+    } catch (const std::exception& e) {
+        std::string errorMessage = TestUtils::toString(e);
+        std::cout << LOGGER_ID << " ERROR: " << errorMessage << std::endl;
+        FAIL() << errorMessage;
+    }
+}
@@ -0,0 +1,259 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <iostream>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+#include <exqudens/log/api/Logging.hpp>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/vulkan/Pipeline.hpp"
+#include "exqudens/vulkan/PipelineStateKey.hpp"
+#include "exqudens/vulkan/ExtendedDynamicState.hpp"
+
+class PipelineStateKeyUnitTests : public testing::Test {
+
+    public:
+
+        inline static const char* LOGGER_ID = "PipelineStateKeyUnitTests";
+
+};
+
+TEST_F(PipelineStateKeyUnitTests, test1) {
+    try {
+        std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+        std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "bgn";
+
+        exqudens::vulkan::Pipeline pipeline1 = {};
+        exqudens::vulkan::Pipeline pipeline2 = {};
+        TestUtils::fillPipeline(pipeline1);
+        TestUtils::fillPipeline(pipeline2);
+
+        // case-1: identical descriptions produce equal keys
+        exqudens::vulkan::PipelineStateKey key1 = exqudens::vulkan::PipelineStateKey::from(pipeline1);
+        exqudens::vulkan::PipelineStateKey key2 = exqudens::vulkan::PipelineStateKey::from(pipeline2);
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "key1.hash: '" << key1.hash() << "'";
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "key2.hash: '" << key2.hash() << "'";
+
+        ASSERT_TRUE(key1 == key2);
+        ASSERT_EQ(key1.hash(), key2.hash());
+
+        // case-2: wiring pointers does not change the key
+        exqudens::vulkan::Pipeline::builder(pipeline2).prepare();
+        key2 = exqudens::vulkan::PipelineStateKey::from(pipeline2);
+
+        ASSERT_TRUE(key1 == key2);
+
+        // case-3: a different raster state produces a different key
+        pipeline2.rasterizationStateCreateInfo.value().setCullMode(vk::CullModeFlagBits::eNone);
+        key2 = exqudens::vulkan::PipelineStateKey::from(pipeline2);
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "key2.hash: '" << key2.hash() << "'";
+
+        ASSERT_TRUE(key1 != key2);
+        ASSERT_NE(key1.hash(), key2.hash());
+
+        // case-4: a different shader module produces a different key
+        TestUtils::fillPipeline(pipeline2);
+        pipeline2.shaderStageCreateInfos.at(1).setModule(vk::ShaderModule(reinterpret_cast<VkShaderModule>(uintptr_t(4))));
+        key2 = exqudens::vulkan::PipelineStateKey::from(pipeline2);
+
+        ASSERT_TRUE(key1 != key2);
+
+        // case-5: a different rendering format produces a different key
+        TestUtils::fillPipeline(pipeline2);
+        vk::Format format = vk::Format::eB8G8R8A8Srgb;
+        pipeline2.renderingCreateInfo = vk::PipelineRenderingCreateInfo().setColorAttachmentFormats(format);
+        key2 = exqudens::vulkan::PipelineStateKey::from(pipeline2);
+
+        ASSERT_TRUE(key1 != key2);
+
+        // case-6: typed specialization constants take part in the key
+        TestUtils::fillPipeline(pipeline1);
+        TestUtils::fillPipeline(pipeline2);
+        exqudens::vulkan::Pipeline::builder(pipeline1).setSpecialization<0, 1>(std::make_tuple(16u, true));
+        exqudens::vulkan::Pipeline::builder(pipeline2).setSpecialization<0, 1>(std::make_tuple(16u, true));
+        key1 = exqudens::vulkan::PipelineStateKey::from(pipeline1);
+        key2 = exqudens::vulkan::PipelineStateKey::from(pipeline2);
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "specializationData.size: '" << pipeline1.specializationData.size() << "'";
+
+        ASSERT_EQ(8, pipeline1.specializationData.size());
+        ASSERT_EQ(2, pipeline1.specializationMapEntries.size());
+        ASSERT_TRUE(key1 == key2);
+
+        exqudens::vulkan::Pipeline::builder(pipeline2).addSpecialization(0, 32u);
+        key2 = exqudens::vulkan::PipelineStateKey::from(pipeline2);
+
+        ASSERT_TRUE(key1 != key2);
+
+        // case-7: dynamic state declaration order does not change the key
+        TestUtils::fillPipeline(pipeline1);
+        TestUtils::fillPipeline(pipeline2);
+        pipeline2.dynamicStates = {vk::DynamicState::eScissor, vk::DynamicState::eViewport};
+        key1 = exqudens::vulkan::PipelineStateKey::from(pipeline1);
+        key2 = exqudens::vulkan::PipelineStateKey::from(pipeline2);
+
+        ASSERT_TRUE(key1 == key2);
+
+        // case-8: the sample mask words take part in the key
+        vk::SampleMask sampleMask = 0x1;
+        TestUtils::fillPipeline(pipeline2);
+        pipeline2.multisampleStateCreateInfo.value().setPSampleMask(&sampleMask);
+        key2 = exqudens::vulkan::PipelineStateKey::from(pipeline2);
+
+        ASSERT_TRUE(key1 != key2);
+
+        // case-9: extension structs the key can not represent are rejected
+        vk::PipelineRasterizationLineStateCreateInfoEXT lineState = vk::PipelineRasterizationLineStateCreateInfoEXT();
+        TestUtils::fillPipeline(pipeline2);
+        pipeline2.rasterizationStateCreateInfo.value().setPNext(&lineState);
+
+        ASSERT_THROW(exqudens::vulkan::PipelineStateKey::from(pipeline2), std::runtime_error);
+
+        // case-10: a stage without its own info is keyed with the shared one before and after 'prepare()'
+        TestUtils::fillPipeline(pipeline1);
+        exqudens::vulkan::Pipeline::builder(pipeline1).addSpecialization(0, 16u);
+        key1 = exqudens::vulkan::PipelineStateKey::from(pipeline1);
+
+        ASSERT_FALSE(pipeline1.usesSharedSpecialization(pipeline1.shaderStageCreateInfos.at(0)));
+
+        exqudens::vulkan::Pipeline::builder(pipeline1).prepare();
+        key2 = exqudens::vulkan::PipelineStateKey::from(pipeline1);
+
+        ASSERT_TRUE(pipeline1.usesSharedSpecialization(pipeline1.shaderStageCreateInfos.at(0)));
+        ASSERT_TRUE(key1 == key2);
+
+        // case-11: stages of another object are never taken for shared ones
+        TestUtils::fillPipeline(pipeline2);
+        exqudens::vulkan::Pipeline::builder(pipeline2).addSpecialization(0, 16u).prepare();
+
+        ASSERT_FALSE(pipeline1.usesSharedSpecialization(pipeline2.shaderStageCreateInfos.at(0)));
+
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "end";
+    } catch (const std::exception& e) {
+        std::string errorMessage = TestUtils::toString(e);
+        std::cout << LOGGER_ID << " ERROR: " << errorMessage << std::endl;
+        FAIL() << errorMessage;
+    }
+}
+
+TEST_F(PipelineStateKeyUnitTests, test2) {
+    try {
+        std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+        std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "bgn";
+
+        exqudens::vulkan::Pipeline pipeline1 = {};
+        exqudens::vulkan::Pipeline pipeline2 = {};
+        exqudens::vulkan::ExtendedDynamicState::State state1 = {};
+        exqudens::vulkan::ExtendedDynamicState::State state2 = {};
+        state1.cullMode = vk::CullModeFlagBits::eBack;
+        state1.primitiveTopology = vk::PrimitiveTopology::eTriangleList;
+        state2.cullMode = vk::CullModeFlagBits::eNone;
+        state2.primitiveTopology = vk::PrimitiveTopology::eTriangleStrip;
+
+        // case-1: without the extensions every state is baked into its own permutation
+        exqudens::vulkan::ExtendedDynamicState baked = {};
+        TestUtils::fillPipeline(pipeline1);
+        TestUtils::fillPipeline(pipeline2);
+        baked.apply(pipeline1, state1);
+        baked.apply(pipeline2, state2);
+        exqudens::vulkan::PipelineStateKey key1 = exqudens::vulkan::PipelineStateKey::from(pipeline1);
+        exqudens::vulkan::PipelineStateKey key2 = exqudens::vulkan::PipelineStateKey::from(pipeline2);
+
+        ASSERT_EQ(vk::CullModeFlags(vk::CullModeFlagBits::eNone), pipeline2.rasterizationStateCreateInfo.value().cullMode);
+        ASSERT_TRUE(key1 != key2);
+
+        // case-2: with the extensions the permutations share one key
+        exqudens::vulkan::ExtendedDynamicState dynamic = {};
+        dynamic.extendedDynamicState = true;
+        TestUtils::fillPipeline(pipeline1);
+        TestUtils::fillPipeline(pipeline2);
+        dynamic.apply(pipeline1, state1);
+        dynamic.apply(pipeline2, state2);
+        pipeline2.rasterizationStateCreateInfo.value().setCullMode(vk::CullModeFlagBits::eFront);
+        key1 = exqudens::vulkan::PipelineStateKey::from(pipeline1);
+        key2 = exqudens::vulkan::PipelineStateKey::from(pipeline2);
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "dynamicStates.size: '" << pipeline1.dynamicStates.size() << "'";
+
+        ASSERT_EQ(10, pipeline1.dynamicStates.size());
+        ASSERT_TRUE(key1 == key2);
+
+        // case-3: dynamic topology keeps its class in the key
+        pipeline2.inputAssemblyStateCreateInfo.value().setTopology(vk::PrimitiveTopology::eLineList);
+        key2 = exqudens::vulkan::PipelineStateKey::from(pipeline2);
+
+        ASSERT_TRUE(key1 != key2);
+
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "end";
+    } catch (const std::exception& e) {
+        std::string errorMessage = TestUtils::toString(e);
+        std::cout << LOGGER_ID << " ERROR: " << errorMessage << std::endl;
+        FAIL() << errorMessage;
+    }
+}
+
+TEST_F(PipelineStateKeyUnitTests, test3) {
+    try {
+        std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+        std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "bgn";
+
+        exqudens::vulkan::Pipeline pipeline1 = {};
+        exqudens::vulkan::Pipeline pipeline2 = {};
+        for (exqudens::vulkan::Pipeline* pipeline : {&pipeline1, &pipeline2}) {
+            pipeline->shaderStageCreateInfos = {
+                vk::PipelineShaderStageCreateInfo()
+                .setStage(vk::ShaderStageFlagBits::eCompute)
+                .setModule(vk::ShaderModule(reinterpret_cast<VkShaderModule>(uintptr_t(1))))
+                .setPName("main")
+            };
+            pipeline->computeCreateInfo = vk::ComputePipelineCreateInfo()
+            .setLayout(vk::PipelineLayout(reinterpret_cast<VkPipelineLayout>(uintptr_t(3))));
+        }
+
+        // case-1: prepare wires the single stage into the compute create info
+        exqudens::vulkan::Pipeline::builder(pipeline1).addSpecialization(0, 16u).prepare();
+
+        ASSERT_EQ(vk::ShaderStageFlagBits::eCompute, pipeline1.computeCreateInfo.value().stage.stage);
+        ASSERT_EQ(pipeline1.shaderStageCreateInfos.at(0).module, pipeline1.computeCreateInfo.value().stage.module);
+        ASSERT_EQ(&pipeline1.specializationInfo.value(), pipeline1.computeCreateInfo.value().stage.pSpecializationInfo);
+
+        // case-2: compute keys follow the layout and the specialization
+        exqudens::vulkan::Pipeline::builder(pipeline2).addSpecialization(0, 16u);
+        exqudens::vulkan::PipelineStateKey key1 = exqudens::vulkan::PipelineStateKey::from(pipeline1);
+        exqudens::vulkan::PipelineStateKey key2 = exqudens::vulkan::PipelineStateKey::from(pipeline2);
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "key1.hash: '" << key1.hash() << "'";
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "key2.hash: '" << key2.hash() << "'";
+
+        ASSERT_TRUE(key1 == key2);
+
+        pipeline2.computeCreateInfo.value().setLayout(vk::PipelineLayout(reinterpret_cast<VkPipelineLayout>(uintptr_t(4))));
+        key2 = exqudens::vulkan::PipelineStateKey::from(pipeline2);
+
+        ASSERT_TRUE(key1 != key2);
+
+        // case-3: a compute pipeline needs exactly one stage
+        pipeline2.shaderStageCreateInfos.emplace_back(pipeline2.shaderStageCreateInfos.at(0));
+
+        ASSERT_THROW(exqudens::vulkan::Pipeline::builder(pipeline2).prepare(), std::exception);
+
+        // case-4: graphics and compute create infos are exclusive
+        TestUtils::fillPipeline(pipeline2);
+        pipeline2.computeCreateInfo = vk::ComputePipelineCreateInfo();
+
+        ASSERT_THROW(exqudens::vulkan::Pipeline::builder(pipeline2).prepare(), std::exception);
+
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "end";
+    } catch (const std::exception& e) {
+        std::string errorMessage = TestUtils::toString(e);
+        std::cout << LOGGER_ID << " ERROR: " << errorMessage << std::endl;
+        FAIL() << errorMessage;
+    }
+}
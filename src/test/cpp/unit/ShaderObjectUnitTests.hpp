@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+#include <exqudens/log/api/Logging.hpp>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/vulkan/ShaderObject.hpp"
+
+class ShaderObjectUnitTests : public testing::Test {
+
+    public:
+
+        inline static const char* LOGGER_ID = "ShaderObjectUnitTests";
+
+};
+
+TEST_F(ShaderObjectUnitTests, test1) {
+    try {
+        std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+        std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "bgn";
+
+        // case-1: the default state sets everything a draw without attachments consumes
+        exqudens::vulkan::ShaderObject::State state = {};
+        exqudens::vulkan::ShaderObject::Features features = {};
+        std::vector<vk::DynamicState> expected = {
+            vk::DynamicState::eViewportWithCount,
+            vk::DynamicState::eScissorWithCount,
+            vk::DynamicState::eVertexInputEXT,
+            vk::DynamicState::ePrimitiveTopology,
+            vk::DynamicState::ePrimitiveRestartEnable,
+            vk::DynamicState::eRasterizerDiscardEnable,
+            vk::DynamicState::ePolygonModeEXT,
+            vk::DynamicState::eCullMode,
+            vk::DynamicState::eFrontFace,
+            vk::DynamicState::eDepthBiasEnable,
+            vk::DynamicState::eLineWidth,
+            vk::DynamicState::eRasterizationSamplesEXT,
+            vk::DynamicState::eSampleMaskEXT,
+            vk::DynamicState::eAlphaToCoverageEnableEXT,
+            vk::DynamicState::eDepthTestEnable,
+            vk::DynamicState::eDepthWriteEnable,
+            vk::DynamicState::eDepthCompareOp,
+            vk::DynamicState::eDepthBoundsTestEnable,
+            vk::DynamicState::eStencilTestEnable
+        };
+
+        ASSERT_EQ(expected, exqudens::vulkan::ShaderObject::states(state, features));
+
+        // case-2: rasterizer discard stops after the pre-rasterization state
+        state.rasterizerDiscardEnable = true;
+        std::vector<vk::DynamicState> states = exqudens::vulkan::ShaderObject::states(state, features);
+
+        ASSERT_EQ(6, states.size());
+        ASSERT_EQ(vk::DynamicState::eRasterizerDiscardEnable, states.back());
+
+        // case-3: enabled features add the states the device then requires
+        state.rasterizerDiscardEnable = false;
+        state.patchControlPoints = 3;
+        state.logicOpEnable = true;
+        features.tessellationShader = true;
+        features.depthClamp = true;
+        features.alphaToOne = true;
+        features.logicOp = true;
+        states = exqudens::vulkan::ShaderObject::states(state, features);
+        auto contains = [&states](vk::DynamicState value) {
+            return std::find(states.begin(), states.end(), value) != states.end();
+        };
+
+        ASSERT_TRUE(contains(vk::DynamicState::ePatchControlPointsEXT));
+        ASSERT_TRUE(contains(vk::DynamicState::eTessellationDomainOriginEXT));
+        ASSERT_TRUE(contains(vk::DynamicState::eDepthClampEnableEXT));
+        ASSERT_TRUE(contains(vk::DynamicState::eAlphaToOneEnableEXT));
+        ASSERT_TRUE(contains(vk::DynamicState::eLogicOpEnableEXT));
+        ASSERT_TRUE(contains(vk::DynamicState::eLogicOpEXT));
+        ASSERT_EQ(expected.size() + 6, states.size());
+
+        // case-4: enabled tests add their values, attachments add their blend arrays
+        state = {};
+        features = {};
+        state.depthBiasEnable = true;
+        state.depthBoundsTestEnable = true;
+        state.stencilTestEnable = true;
+        state.colorAttachmentCount = 2;
+        states = exqudens::vulkan::ShaderObject::states(state, features);
+
+        ASSERT_TRUE(contains(vk::DynamicState::eDepthBias));
+        ASSERT_TRUE(contains(vk::DynamicState::eDepthBounds));
+        ASSERT_TRUE(contains(vk::DynamicState::eStencilOp));
+        ASSERT_TRUE(contains(vk::DynamicState::eStencilReference));
+        ASSERT_EQ(vk::DynamicState::eColorWriteMaskEXT, states.back());
+        ASSERT_EQ(expected.size() + 9, states.size());
+
+        // case-5: per attachment vectors of another size are rejected
+        state.colorWriteMasks = {vk::ColorComponentFlagBits::eR};
+
+        ASSERT_THROW(exqudens::vulkan::ShaderObject::states(state, features), std::exception);
+
+        // case-6: unused graphics stages are bound to null, only when their features are enabled
+        exqudens::vulkan::ShaderObject shaderObject = {};
+        std::vector<uint32_t> code = {0x07230203};
+        exqudens::vulkan::ShaderObject::builder(shaderObject)
+        .addStage(vk::ShaderStageFlagBits::eVertex, code)
+        .addStage(vk::ShaderStageFlagBits::eFragment, code);
+
+        ASSERT_EQ(
+            std::vector<vk::ShaderStageFlagBits>({vk::ShaderStageFlagBits::eVertex, vk::ShaderStageFlagBits::eFragment}),
+            shaderObject.bindStages()
+        );
+
+        features.taskShader = true;
+        features.meshShader = true;
+        exqudens::vulkan::ShaderObject::builder(shaderObject).setFeatures(features);
+
+        ASSERT_EQ(
+            std::vector<vk::ShaderStageFlagBits>({
+                vk::ShaderStageFlagBits::eVertex,
+                vk::ShaderStageFlagBits::eFragment,
+                vk::ShaderStageFlagBits::eTaskEXT,
+                vk::ShaderStageFlagBits::eMeshEXT
+            }),
+            shaderObject.bindStages()
+        );
+
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "end";
+    } catch (const std::exception& e) {
+        std::string errorMessage = TestUtils::toString(e);
+        std::cout << LOGGER_ID << " ERROR: " << errorMessage << std::endl;
+        FAIL() << errorMessage;
+    }
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <iostream>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+#include <exqudens/log/api/Logging.hpp>
+
+#include <vulkan/vulkan_raii.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/vulkan/SpirvReflection.hpp"
+
+class SpirvReflectionUnitTests : public testing::Test {
+
+    public:
+
+        inline static const char* LOGGER_ID = "SpirvReflectionUnitTests";
+
+    protected:
+
+        // hand assembled module: ubo at set 0 binding 0, sampler2D[4] at set 1 binding 2,
+        // push constant block { mat4; vec4; }, inputs vec3 at location 0 and vec2 at location 1
+        static std::vector<uint32_t> code(uint32_t executionModel) {
+            return {
+                0x07230203, 0x00010000, 0, 100, 0,
+                (2 << 16) | 17, 1,
+                (3 << 16) | 14, 0, 1,
+                (7 << 16) | 15, executionModel, 1, 0x6e69616d, 0, 10, 11,
+                (4 << 16) | 71, 10, 30, 0,
+                (4 << 16) | 71, 11, 30, 1,
+                (4 << 16) | 71, 20, 34, 0,
+                (4 << 16) | 71, 20, 33, 0,
+                (4 << 16) | 71, 22, 34, 1,
+                (4 << 16) | 71, 22, 33, 2,
+                (3 << 16) | 71, 30, 2,
+                (5 << 16) | 72, 30, 0, 35, 0,
+                (3 << 16) | 71, 31, 2,
+                (5 << 16) | 72, 31, 0, 35, 0,
+                (5 << 16) | 72, 31, 1, 35, 64,
+                (3 << 16) | 22, 40, 32,
+                (4 << 16) | 23, 41, 40, 2,
+                (4 << 16) | 23, 42, 40, 3,
+                (4 << 16) | 23, 43, 40, 4,
+                (4 << 16) | 24, 44, 43, 4,
+                (4 << 16) | 21, 45, 32, 0,
+                (4 << 16) | 43, 45, 46, 4,
+                (9 << 16) | 25, 47, 40, 1, 0, 0, 0, 1, 0,
+                (3 << 16) | 27, 48, 47,
+                (4 << 16) | 28, 49, 48, 46,
+                (3 << 16) | 30, 30, 44,
+                (4 << 16) | 30, 31, 44, 43,
+                (4 << 16) | 32, 50, 2, 30,
+                (4 << 16) | 32, 51, 9, 31,
+                (4 << 16) | 32, 52, 1, 42,
+                (4 << 16) | 32, 53, 1, 41,
+                (4 << 16) | 32, 54, 0, 49,
+                (4 << 16) | 59, 50, 20, 2,
+                (4 << 16) | 59, 51, 21, 9,
+                (4 << 16) | 59, 52, 10, 1,
+                (4 << 16) | 59, 53, 11, 1,
+                (4 << 16) | 59, 54, 22, 0
+            };
+        }
+
+        // hand assembled vertex module: the same ubo at set 0 binding 0 and set 1 binding 0,
+        // inputs dmat2x3 at location 0 and vec4 at location 6
+        static std::vector<uint32_t> doubleCode() {
+            return {
+                0x07230203, 0x00010000, 0, 100, 0,
+                (2 << 16) | 17, 1,
+                (2 << 16) | 17, 10,
+                (3 << 16) | 14, 0, 1,
+                (7 << 16) | 15, 0, 1, 0x6e69616d, 0, 10, 11,
+                (4 << 16) | 71, 10, 30, 0,
+                (4 << 16) | 71, 11, 30, 6,
+                (4 << 16) | 71, 20, 34, 0,
+                (4 << 16) | 71, 20, 33, 0,
+                (4 << 16) | 71, 21, 34, 1,
+                (4 << 16) | 71, 21, 33, 0,
+                (3 << 16) | 71, 30, 2,
+                (5 << 16) | 72, 30, 0, 35, 0,
+                (3 << 16) | 22, 40, 64,
+                (4 << 16) | 23, 41, 40, 3,
+                (4 << 16) | 24, 42, 41, 2,
+                (3 << 16) | 22, 43, 32,
+                (4 << 16) | 23, 44, 43, 4,
+                (3 << 16) | 30, 30, 44,
+                (4 << 16) | 32, 50, 2, 30,
+                (4 << 16) | 32, 51, 1, 42,
+                (4 << 16) | 32, 52, 1, 44,
+                (4 << 16) | 59, 50, 20, 2,
+                (4 << 16) | 59, 50, 21, 2,
+                (4 << 16) | 59, 51, 10, 1,
+                (4 << 16) | 59, 52, 11, 1
+            };
+        }
+
+};
+
+TEST_F(SpirvReflectionUnitTests, test1) {
+    try {
+        std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+        std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "bgn";
+
+        std::vector<uint32_t> vertCode = code(0);
+        std::vector<uint32_t> fragCode = code(4);
+        exqudens::vulkan::SpirvReflection reflection = {};
+        exqudens::vulkan::SpirvReflection::builder(reflection)
+        .addCode(vertCode)
+        .addCode(fragCode)
+        .build();
+
+        // case-1: descriptor bindings are merged across stages
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "setBindings.size: '" << reflection.setBindings.size() << "'";
+
+        ASSERT_EQ(2, reflection.setBindings.size());
+        ASSERT_EQ(1, reflection.setBindings.at(0).size());
+        ASSERT_EQ(0, reflection.setBindings.at(0).at(0).binding);
+        ASSERT_EQ(vk::DescriptorType::eUniformBuffer, reflection.setBindings.at(0).at(0).descriptorType);
+        ASSERT_EQ(1, reflection.setBindings.at(0).at(0).descriptorCount);
+        ASSERT_EQ(vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment, reflection.setBindings.at(0).at(0).stageFlags);
+        ASSERT_EQ(1, reflection.setBindings.at(1).size());
+        ASSERT_EQ(2, reflection.setBindings.at(1).at(0).binding);
+        ASSERT_EQ(vk::DescriptorType::eCombinedImageSampler, reflection.setBindings.at(1).at(0).descriptorType);
+        ASSERT_EQ(4, reflection.setBindings.at(1).at(0).descriptorCount);
+
+        // case-2: identical push constant blocks become one range
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "pushConstantRanges.size: '" << reflection.pushConstantRanges.size() << "'";
+
+        ASSERT_EQ(1, reflection.pushConstantRanges.size());
+        ASSERT_EQ(0, reflection.pushConstantRanges.at(0).offset);
+        ASSERT_EQ(80, reflection.pushConstantRanges.at(0).size);
+        ASSERT_EQ(vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment, reflection.pushConstantRanges.at(0).stageFlags);
+
+        // case-3: vertex inputs come from the vertex stage only, packed in location order
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "vertexAttributes.size: '" << reflection.vertexAttributes.size() << "'";
+
+        ASSERT_EQ(1, reflection.vertexBindings.size());
+        ASSERT_EQ(20, reflection.vertexBindings.at(0).stride);
+        ASSERT_EQ(2, reflection.vertexAttributes.size());
+        ASSERT_EQ(0, reflection.vertexAttributes.at(0).location);
+        ASSERT_EQ(vk::Format::eR32G32B32Sfloat, reflection.vertexAttributes.at(0).format);
+        ASSERT_EQ(0, reflection.vertexAttributes.at(0).offset);
+        ASSERT_EQ(1, reflection.vertexAttributes.at(1).location);
+        ASSERT_EQ(vk::Format::eR32G32Sfloat, reflection.vertexAttributes.at(1).format);
+        ASSERT_EQ(12, reflection.vertexAttributes.at(1).offset);
+
+        // case-4: malformed code is rejected
+        std::vector<uint32_t> badCode = vertCode;
+        badCode.at(0) = 0;
+
+        ASSERT_THROW(
+            exqudens::vulkan::SpirvReflection::builder(reflection).addCode(badCode).build(),
+            std::exception
+        );
+
+        // case-5: sets with identical bindings share one layout
+        reflection.codes.pop_back();
+        exqudens::vulkan::SpirvReflection::builder(reflection).build();
+
+        ASSERT_EQ(std::vector<uint32_t>({0, 1}), reflection.setLayoutIndices);
+
+        std::vector<uint32_t> doubleVertCode = doubleCode();
+        reflection.clear();
+        exqudens::vulkan::SpirvReflection::builder(reflection)
+        .addCode(doubleVertCode)
+        .build();
+
+        ASSERT_EQ(2, reflection.setBindings.size());
+        ASSERT_EQ(std::vector<uint32_t>({0, 0}), reflection.setLayoutIndices);
+
+        // case-6: a column of three 64 bit components takes two locations
+        ASSERT_EQ(3, reflection.vertexAttributes.size());
+        ASSERT_EQ(0, reflection.vertexAttributes.at(0).location);
+        ASSERT_EQ(vk::Format::eR64G64B64Sfloat, reflection.vertexAttributes.at(0).format);
+        ASSERT_EQ(0, reflection.vertexAttributes.at(0).offset);
+        ASSERT_EQ(2, reflection.vertexAttributes.at(1).location);
+        ASSERT_EQ(24, reflection.vertexAttributes.at(1).offset);
+        ASSERT_EQ(6, reflection.vertexAttributes.at(2).location);
+        ASSERT_EQ(vk::Format::eR32G32B32A32Sfloat, reflection.vertexAttributes.at(2).format);
+        ASSERT_EQ(48, reflection.vertexAttributes.at(2).offset);
+        ASSERT_EQ(64, reflection.vertexBindings.at(0).stride);
+
+        EXQUDENS_LOG_INFO(LOGGER_ID) << "end";
+    } catch (const std::exception& e) {
+        std::string errorMessage = TestUtils::toString(e);
+        std::cout << LOGGER_ID << " ERROR: " << errorMessage << std::endl;
+        FAIL() << errorMessage;
+    }
+}